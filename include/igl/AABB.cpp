@@ -17,6 +17,7 @@
 #include "ray_box_intersect.h"
 #include "parallel_for.h"
 #include "ray_mesh_intersect.h"
+#include <functional>
 #include <iostream>
 #include <iomanip>
 #include <limits>
@@ -24,6 +25,11 @@
 #include <queue>
 #include <stack>
 
+extern "C"
+{
+#include "raytri.c"
+}
+
 template <typename DerivedV, int DIM>
 template <typename DerivedEle, typename Derivedbb_mins, typename Derivedbb_maxs, typename Derivedelements>
 IGL_INLINE void igl::AABB<DerivedV,DIM>::init(
@@ -1002,6 +1008,183 @@ igl::AABB<DerivedV,DIM>::intersect_ray(
   return left_ret || right_ret;
 }
 
+template <typename DerivedV, int DIM>
+template <typename DerivedEle>
+IGL_INLINE bool
+igl::AABB<DerivedV,DIM>::intersect_ray(
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedEle> & Ele,
+  const RowVectorDIMS & origin,
+  const RowVectorDIMS & dir,
+  const Scalar max_t,
+  const bool any_hit,
+  igl::Hit & hit) const
+{
+  assert((Ele.size() == 0 || Ele.cols() == 3) && "Elements should be triangles");
+  if(!any_hit)
+  {
+    igl::Hit first_hit;
+    if(intersect_ray(V,Ele,origin,dir,max_t,first_hit) && first_hit.t < max_t)
+    {
+      hit = first_hit;
+      return true;
+    }
+    return false;
+  }
+  double o[3],d[3];
+  for(int c = 0;c<3;c++)
+  {
+    o[c] = origin(c);
+    d[c] = dir(c);
+  }
+  // DFS with an explicit stack, stopping at the first hit
+  std::vector<const AABB *> Q(1,this);
+  while(!Q.empty())
+  {
+    const AABB * tree = Q.back();
+    Q.pop_back();
+    {
+      Scalar _1,_2;
+      if(!ray_box_intersect(origin,dir,tree->m_box,Scalar(0),max_t,_1,_2))
+      {
+        continue;
+      }
+    }
+    if(tree->is_leaf())
+    {
+      const int f = tree->m_primitive;
+      double v0[3],v1[3],v2[3];
+      for(int c = 0;c<3;c++)
+      {
+        v0[c] = V(Ele(f,0),c);
+        v1[c] = V(Ele(f,1),c);
+        v2[c] = V(Ele(f,2),c);
+      }
+      double t,u,v;
+      if(intersect_triangle1(o,d,v0,v1,v2,&t,&u,&v) && t>0 && t<max_t)
+      {
+        hit = {f,-1,(float)u,(float)v,(float)t};
+        return true;
+      }
+      continue;
+    }
+    Q.push_back(tree->m_right);
+    Q.push_back(tree->m_left);
+  }
+  return false;
+}
+
+template <typename DerivedV, int DIM>
+template <typename DerivedEle, typename Deriveddirs>
+IGL_INLINE int
+igl::AABB<DerivedV,DIM>::intersect_rays(
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedEle> & Ele,
+  const RowVectorDIMS & origin,
+  const Eigen::MatrixBase<Deriveddirs> & dirs,
+  const Scalar min_t,
+  const Scalar max_t,
+  const bool any_hit,
+  std::vector<igl::Hit> & hits) const
+{
+  static_assert(DIM == 3,"Ray packets are only supported in 3D");
+  assert((Ele.size() == 0 || Ele.cols() == 3) && "Elements should be triangles");
+  const int R = dirs.rows();
+  hits.resize(R);
+  for(auto & hit : hits)
+  {
+    hit.id = -1;
+    hit.gid = -1;
+    hit.t = std::numeric_limits<float>::infinity();
+  }
+  if(R == 0)
+  {
+    return 0;
+  }
+  // Column-major so that each axis is contiguous
+  const Eigen::Matrix<Scalar,Eigen::Dynamic,DIM> inv_dir = 
+    dirs.template cast<Scalar>().array().inverse().matrix();
+  // Current upper bound on t for each ray. Rays that are done (any_hit) are
+  // set to -∞ so that they fail all further tests.
+  Eigen::Matrix<Scalar,Eigen::Dynamic,1> best_t = 
+    Eigen::Matrix<Scalar,Eigen::Dynamic,1>::Constant(R,max_t);
+  double o[3];
+  for(int d = 0;d<3;d++) { o[d] = origin(d); }
+  // Active ray lists per depth of the traversal
+  std::vector<std::vector<int> > active(1,std::vector<int>(R));
+  for(int r = 0;r<R;r++) { active[0][r] = r; }
+  int num_hits = 0;
+  const std::function<void(const AABB *,const int *,const int,const int)> 
+    traverse = [&](
+      const AABB * tree, const int * in, const int n_in, const int depth)
+  {
+    if(active.size() <= size_t(depth)+1)
+    {
+      active.emplace_back(R);
+    }
+    // Slab test of all active rays against this box
+    int * out = active[depth+1].data();
+    int n_out = 0;
+    const RowVectorDIMS bmin = tree->m_box.min().transpose()-origin;
+    const RowVectorDIMS bmax = tree->m_box.max().transpose()-origin;
+    for(int k = 0;k<n_in;k++)
+    {
+      const int r = in[k];
+      Scalar tn = min_t;
+      Scalar tf = best_t(r);
+      for(int d = 0;d<DIM;d++)
+      {
+        const Scalar ta = bmin(d)*inv_dir(r,d);
+        const Scalar tb = bmax(d)*inv_dir(r,d);
+        // std::min/max return their first argument when comparing against
+        // NaN (0·∞ for rays in the plane of a slab), ignoring that slab
+        tn = std::max(tn,std::min(ta,tb));
+        tf = std::min(tf,std::max(ta,tb));
+      }
+      out[n_out] = r;
+      n_out += (tn <= tf);
+    }
+    if(n_out == 0)
+    {
+      return;
+    }
+    if(tree->is_leaf())
+    {
+      const int f = tree->m_primitive;
+      double v0[3],v1[3],v2[3];
+      for(int d = 0;d<3;d++)
+      {
+        v0[d] = V(Ele(f,0),d);
+        v1[d] = V(Ele(f,1),d);
+        v2[d] = V(Ele(f,2),d);
+      }
+      for(int k = 0;k<n_out;k++)
+      {
+        const int r = out[k];
+        double dir[3];
+        for(int d = 0;d<3;d++) { dir[d] = dirs(r,d); }
+        double t,u,v;
+        if(intersect_triangle1(o,dir,v0,v1,v2,&t,&u,&v) && 
+          t>min_t && t<best_t(r))
+        {
+          if(hits[r].id < 0)
+          {
+            num_hits++;
+          }
+          hits[r] = {f,-1,(float)u,(float)v,(float)t};
+          best_t(r) = 
+            any_hit ? -std::numeric_limits<Scalar>::infinity() : Scalar(t);
+        }
+      }
+      return;
+    }
+    traverse(tree->m_left,active[depth+1].data(),n_out,depth+1);
+    traverse(tree->m_right,active[depth+1].data(),n_out,depth+1);
+  };
+  traverse(this,active[0].data(),R,0);
+  return num_hits;
+}
+
 // This is a bullshit template because AABB annoyingly needs templates for bad
 // combinations of 3D V with DIM=2 AABB
 //
@@ -1029,6 +1212,9 @@ template void igl::AABB<Eigen::Matrix<double, -1, 3, 1, -1, 3>, 3>::squared_dist
 // generated by autoexplicit.sh
 template void igl::AABB<Eigen::Matrix<double, -1, 3, 1, -1, 3>, 3>::init<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 1, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&);
 template bool igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::intersect_ray<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<double, 1, 3, 1, 1, 3> const&, Eigen::Matrix<double, 1, 3, 1, 1, 3> const&, igl::Hit&) const;
+template bool igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::intersect_ray<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<double, 1, 3, 1, 1, 3> const&, Eigen::Matrix<double, 1, 3, 1, 1, 3> const&, double, bool, igl::Hit&) const;
+template int igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::intersect_rays<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 3, 0, -1, 3> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<double, 1, 3, 1, 1, 3> const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> > const&, double, double, bool, std::vector<igl::Hit, std::allocator<igl::Hit> >&) const;
+template int igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::intersect_rays<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<double, 1, 3, 1, 1, 3> const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, double, double, bool, std::vector<igl::Hit, std::allocator<igl::Hit> >&) const;
 template double igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 2>::squared_distance<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<double, 1, 2, 1, 1, 2> const&, int&, Eigen::PlainObjectBase<Eigen::Matrix<double, 1, 2, 1, 1, 2> >&) const;
 template double igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::squared_distance<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<double, 1, 3, 1, 1, 3> const&, double, int&, Eigen::PlainObjectBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> >&) const;
 template double igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::squared_distance<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<double, 1, 3, 1, 1, 3> const&, int&, Eigen::PlainObjectBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> >&) const;
@@ -1063,6 +1249,12 @@ template void igl::AABB<Eigen::Matrix<float, -1, 3, 0, -1, 3>, 3>::init<Eigen::M
 template void igl::AABB<Eigen::Matrix<float, -1, 3, 1, -1, 3>, 3>::init<Eigen::Matrix<int, -1, 3, 1, -1, 3> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, 3, 1, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 1, -1, 3> > const&);
 template double igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::squared_distance<Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::Matrix<double, 1, 3, 1, 1, 3> const&, int&, Eigen::PlainObjectBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> >&) const;
 template double igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 2>::squared_distance<Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::Matrix<double, 1, 2, 1, 1, 2> const&, int&, Eigen::PlainObjectBase<Eigen::Matrix<double, 1, 2, 1, 1, 2> >&) const;
+template void igl::AABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 3>::init<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&);
+template bool igl::AABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 3>::intersect_ray<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<float, 1, 3, 1, 1, 3> const&, Eigen::Matrix<float, 1, 3, 1, 1, 3> const&, igl::Hit&) const;
+template bool igl::AABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 3>::intersect_ray<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<float, 1, 3, 1, 1, 3> const&, Eigen::Matrix<float, 1, 3, 1, 1, 3> const&, std::vector<igl::Hit, std::allocator<igl::Hit> >&) const;
+template void igl::AABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 3>::squared_distance<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<float, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> >&) const;
+template void igl::AABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 2>::init<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&);
+template void igl::AABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 2>::squared_distance<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<float, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> >&) const;
 #ifdef WIN32
 template void igl::AABB<class Eigen::Matrix<double,-1,-1,0,-1,-1>,2>::squared_distance<class Eigen::Matrix<int,-1,-1,0,-1,-1>,class Eigen::Matrix<double,-1,-1,0,-1,-1>,class Eigen::Matrix<double,-1,1,0,-1,1>,class Eigen::Matrix<__int64,-1,1,0,-1,1>,class Eigen::Matrix<double,-1,3,0,-1,3> >(class Eigen::MatrixBase<class Eigen::Matrix<double,-1,-1,0,-1,-1> > const &,class Eigen::MatrixBase<class Eigen::Matrix<int,-1,-1,0,-1,-1> > const &,class Eigen::MatrixBase<class Eigen::Matrix<double,-1,-1,0,-1,-1> > const &,class Eigen::PlainObjectBase<class Eigen::Matrix<double,-1,1,0,-1,1> > &,class Eigen::PlainObjectBase<class Eigen::Matrix<__int64,-1,1,0,-1,1> > &,class Eigen::PlainObjectBase<class Eigen::Matrix<double,-1,3,0,-1,3> > &)const;
 template void igl::AABB<class Eigen::Matrix<double,-1,-1,0,-1,-1>,3>::squared_distance<class Eigen::Matrix<int,-1,-1,0,-1,-1>,class Eigen::Matrix<double,-1,-1,0,-1,-1>,class Eigen::Matrix<double,-1,1,0,-1,1>,class Eigen::Matrix<__int64,-1,1,0,-1,1>,class Eigen::Matrix<double,-1,3,0,-1,3> >(class Eigen::MatrixBase<class Eigen::Matrix<double,-1,-1,0,-1,-1> > const &,class Eigen::MatrixBase<class Eigen::Matrix<int,-1,-1,0,-1,-1> > const &,class Eigen::MatrixBase<class Eigen::Matrix<double,-1,-1,0,-1,-1> > const &,class Eigen::PlainObjectBase<class Eigen::Matrix<double,-1,1,0,-1,1> > &,class Eigen::PlainObjectBase<class Eigen::Matrix<__int64,-1,1,0,-1,1> > &,class Eigen::PlainObjectBase<class Eigen::Matrix<double,-1,3,0,-1,3> > &)const;
@@ -255,6 +255,60 @@ public:
         const RowVectorDIMS & origin,
         const RowVectorDIMS & dir,
         igl::Hit & hit) const;
+      // Hit closer than max_t, either the first such hit or (any_hit=true)
+      // whichever is found first, e.g., for occlusion queries. In any-hit
+      // mode the traversal stops as soon as an element with 0 < t < max_t is
+      // found and boxes beyond max_t are never visited.
+      //
+      // Inputs:
+      //   V  #V by dim list of vertex positions
+      //   Ele  #Ele by 3 list of triangle indices
+      //   origin  1 by dim ray origin
+      //   dir  1 by dim ray direction
+      //   max_t  only hits with t < max_t are considered
+      //   any_hit  whether any hit will do, rather than the first hit
+      // Outputs:
+      //   hit  found hit (if any)
+      // Returns true iff a hit with t < max_t was found
+      template <typename DerivedEle>
+      IGL_INLINE bool intersect_ray(
+        const Eigen::MatrixBase<DerivedV> & V,
+        const Eigen::MatrixBase<DerivedEle> & Ele, 
+        const RowVectorDIMS & origin,
+        const RowVectorDIMS & dir,
+        const Scalar max_t,
+        const bool any_hit,
+        igl::Hit & hit) const;
+      // Packet of rays sharing a common origin (e.g., hemisphere samples for
+      // ambient occlusion). The hierarchy is traversed once for the whole
+      // packet: at each node all still active rays are slab tested against
+      // the box (with precomputed inverse directions stored per axis) and
+      // only those hitting it descend into the subtree. Only supported for
+      // triangles in 3D (DIM = 3); explicitly instantiated for
+      // Eigen::MatrixXd and Eigen::Matrix<double,Eigen::Dynamic,3> dirs.
+      //
+      // Inputs:
+      //   V  #V by 3 list of vertex positions
+      //   Ele  #Ele by 3 list of triangle indices
+      //   origin  1 by 3 common origin of all rays
+      //   dirs  #R by 3 list of ray directions
+      //   min_t  only hits with min_t < t < max_t are considered
+      //   max_t  see min_t
+      //   any_hit  whether to stop tracing a ray as soon as any hit is found
+      //     (occlusion query) rather than searching for its first hit
+      // Outputs:
+      //   hits  #R list of hits, hits[r].id is -1 if the rth ray has no hit
+      // Returns number of rays with a hit
+      template <typename DerivedEle, typename Deriveddirs>
+      IGL_INLINE int intersect_rays(
+        const Eigen::MatrixBase<DerivedV> & V,
+        const Eigen::MatrixBase<DerivedEle> & Ele, 
+        const RowVectorDIMS & origin,
+        const Eigen::MatrixBase<Deriveddirs> & dirs,
+        const Scalar min_t,
+        const Scalar max_t,
+        const bool any_hit,
+        std::vector<igl::Hit> & hits) const;
 //private:
       template <typename DerivedEle>
       IGL_INLINE bool intersect_ray(
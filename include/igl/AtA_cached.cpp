@@ -6,6 +6,7 @@
 // v. 2.0. If a copy of the MPL was not distributed with this file, You can
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "AtA_cached.h"
+#include "parallel_for.h"
 
 #include <iostream>
 #include <vector>
@@ -115,12 +116,14 @@ IGL_INLINE void igl::AtA_cached(
     const igl::AtA_cached_data& data,
     Eigen::SparseMatrix<Scalar>& AtA)
 {
-  for (unsigned i=0; i<data.I_outer.size()-1; ++i)
+  // Each entry of AtA is independent
+  igl::parallel_for(data.I_outer.size()-1, [&](const size_t i)
   {
-    *(AtA.valuePtr() + i) = 0;
+    Scalar v = 0;
     for (unsigned j=data.I_outer[i]; j<data.I_outer[i+1]; ++j)
-      *(AtA.valuePtr() + i) += *(A.valuePtr() + data.I_row[j]) * data.W[data.I_w[j]] * *(A.valuePtr() + data.I_col[j]);
-  }
+      v += *(A.valuePtr() + data.I_row[j]) * data.W[data.I_w[j]] * *(A.valuePtr() + data.I_col[j]);
+    *(AtA.valuePtr() + i) = v;
+  }, 10000);
 }
 
 
@@ -0,0 +1,128 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2023 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "HalfEdgeMesh.h"
+#include "parallel_for.h"
+#include "radix_sort.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+template <typename Index>
+template <typename DerivedF>
+IGL_INLINE void igl::HalfEdgeMesh<Index>::init(
+  const Eigen::MatrixBase<DerivedF> & F)
+{
+  assert((F.rows() == 0 || F.cols() == 3) && "F must be triangles");
+  const Index m = F.rows();
+  const Index nh = 3*m;
+  const Index n = m == 0 ? 0 : Index(F.maxCoeff())+1;
+  origins.resize(nh);
+  // Undirected edge keys listed in oriented_facets order (edge opposite
+  // corner c of face f is at c*m+f) so the stable sort numbers unique edges
+  // and picks their representatives exactly like unique_edge_map
+  std::vector<std::uint64_t> keys(nh);
+  std::vector<Index> H(nh);
+  // Vertex indices do not fit in half a key: sort (min,max) pairs instead
+  const bool wide = std::uint64_t(n) > 0x100000000ull;
+  std::vector<std::pair<Index,Index> > pairs(wide ? nh : 0);
+  parallel_for(m,[&](const Index f)
+  {
+    for(int k = 0;k<3;k++)
+    {
+      const Index h = 3*f+k;
+      const Index a = F(f,k), b = F(f,(k+1)%3);
+      origins(h) = a;
+      const Index e = ((k+2)%3)*m+f;
+      if(wide)
+      {
+        pairs[e] = std::make_pair(std::min(a,b),std::max(a,b));
+      }else
+      {
+        keys[e] = (std::uint64_t(std::min(a,b))<<32) | std::uint64_t(std::max(a,b));
+      }
+      H[e] = h;
+    }
+  },1000ul);
+  if(wide)
+  {
+    std::vector<Index> J(nh);
+    for(Index j = 0;j<nh;j++) { J[j] = j; }
+    std::stable_sort(J.begin(),J.end(),[&](const Index i, const Index j)
+    {
+      return pairs[i] < pairs[j];
+    });
+    std::vector<Index> HJ(nh);
+    for(Index j = 0;j<nh;j++)
+    {
+      HJ[j] = H[J[j]];
+      // Only equality of consecutive keys matters below
+      keys[j] = j == 0 ? 0 : keys[j-1] + (pairs[J[j]] != pairs[J[j-1]]);
+    }
+    H.swap(HJ);
+  }else
+  {
+    radix_sort(keys,H);
+  }
+  // Index of unique edge of each sorted half-edge
+  std::vector<Index> U(nh);
+  for(Index j = 0;j<nh;j++)
+  {
+    U[j] = j == 0 ? 0 : U[j-1] + (keys[j] != keys[j-1]);
+  }
+  edges.resize(nh);
+  edge_halfedges.resize(nh == 0 ? 0 : U[nh-1]+1);
+  twins.setConstant(nh,-1);
+  parallel_for(nh,[&](const Index j)
+  {
+    const Index h = H[j];
+    edges(h) = U[j];
+    if(j > 0 && U[j] == U[j-1])
+    {
+      return;
+    }
+    edge_halfedges(U[j]) = h;
+    // Exactly two oppositely oriented half-edges
+    const bool pair = j+1 < nh && U[j+1] == U[j] && (j+2 == nh || U[j+2] != U[j]);
+    if(pair)
+    {
+      const Index t = H[j+1];
+      if(origins(h) == origins(next(t)) && origins(t) == origins(next(h)) &&
+        origins(h) != origins(t))
+      {
+        twins(h) = t;
+        twins(t) = h;
+      }
+    }
+  },1000ul);
+  // Outgoing half-edges: lowest indexed one, or lowest indexed one following
+  // a boundary half-edge into the vertex
+  vertex_halfedges.setConstant(n,-1);
+  for(Index h = nh-1;h>=0;h--)
+  {
+    vertex_halfedges(origins(h)) = h;
+  }
+  for(Index h = nh-1;h>=0;h--)
+  {
+    if(twins(prev(h)) < 0)
+    {
+      vertex_halfedges(origins(h)) = h;
+    }
+  }
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template class igl::HalfEdgeMesh<int>;
+template class igl::HalfEdgeMesh<std::int64_t>;
+template void igl::HalfEdgeMesh<int>::init<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&);
+template void igl::HalfEdgeMesh<int>::init<Eigen::Matrix<int, -1, 3, 0, -1, 3> >(Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 0, -1, 3> > const&);
+template void igl::HalfEdgeMesh<std::int64_t>::init<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> > const&);
+template void igl::HalfEdgeMesh<std::int64_t>::init<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&);
+#endif
@@ -0,0 +1,139 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2023 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_HALF_EDGE_MESH_H
+#define IGL_HALF_EDGE_MESH_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+
+namespace igl
+{
+  // Compact half-edge connectivity of a triangle mesh, stored as flat arrays
+  // (structure of arrays) and built in parallel from F.
+  //
+  // Half-edge h = 3*f+k of face f goes from F(f,k) to F(f,(k+1)%3), so next,
+  // prev and face are implicit and only twins, origins and unique edges are
+  // stored. This is the edge order of triangle_triangle_adjacency:
+  // twin(3*f+k) == 3*TT(f,k)+TTi(f,k).
+  //
+  // Build once and pass it to routines instead of F to avoid rebuilding
+  // adjacency in each step of a pipeline. triangle_triangle_adjacency,
+  // vertex_triangle_adjacency and edge_flaps accept it directly.
+  // HalfEdgeIterator, circulation and collapse_edge are not adapted: they
+  // work on edge_flaps output (uE,EMAP,EF,EI), which collapse_edge edits in
+  // place as the mesh changes, so build those with edge_flaps(H,...).
+  //
+  // Templates:
+  //   Index  integer type of vertex, face and half-edge indices (e.g., int
+  //     or std::int64_t for meshes with more than 2³¹ half-edges)
+  //
+  // Example:
+  //   igl::HalfEdgeMesh<int> H(F);
+  //   // one-ring of vertex v, in order
+  //   std::vector<int> N;
+  //   H.circulate_vertices(v,[&](const int u){ N.push_back(u); });
+  template <typename Index>
+  class HalfEdgeMesh
+  {
+  public:
+    typedef Eigen::Matrix<Index,Eigen::Dynamic,1> VectorXI;
+    // #F*3 list of opposite half-edges, -1 if the edge is on the boundary or
+    // is non-manifold (shared by more than two faces or by two faces with
+    // the same orientation)
+    VectorXI twins;
+    // #F*3 list of origin vertices
+    VectorXI origins;
+    // #F*3 list of indices of undirected edges, numbered as in
+    // unique_edge_map
+    VectorXI edges;
+    // #uE list of half-edges of each undirected edge (the first occurrence in
+    // oriented_facets order, so that uE.row(e) is [origin,tip] of it)
+    VectorXI edge_halfedges;
+    // #V list of outgoing half-edges of each vertex, -1 for unreferenced
+    // vertices. If some outgoing h has a boundary half-edge prev(h) coming
+    // into the vertex, the lowest indexed such h (the first half-edge of a
+    // manifold boundary fan, from which rotate reaches every face), otherwise
+    // the lowest indexed outgoing half-edge. The outgoing half-edge itself
+    // need not be on the boundary.
+    VectorXI vertex_halfedges;
+
+    HalfEdgeMesh(){}
+    // Inputs:
+    //   F  #F by 3 list of triangle indices
+    template <typename DerivedF>
+    explicit HalfEdgeMesh(const Eigen::MatrixBase<DerivedF> & F){ init(F); }
+    template <typename DerivedF>
+    IGL_INLINE void init(const Eigen::MatrixBase<DerivedF> & F);
+
+    Index num_faces() const { return Index(origins.size()/3); }
+    Index num_halfedges() const { return Index(origins.size()); }
+    Index num_edges() const { return Index(edge_halfedges.size()); }
+    Index num_vertices() const { return Index(vertex_halfedges.size()); }
+
+    static Index next(const Index h) { return h%3 == 2 ? h-2 : h+1; }
+    static Index prev(const Index h) { return h%3 == 0 ? h+2 : h-1; }
+    static Index face(const Index h) { return h/3; }
+    // Corner of face(h) opposite h
+    static Index corner(const Index h) { return next(next(h))%3; }
+    Index twin(const Index h) const { return twins(h); }
+    Index origin(const Index h) const { return origins(h); }
+    Index tip(const Index h) const { return origins(next(h)); }
+    Index edge(const Index h) const { return edges(h); }
+    Index outgoing(const Index v) const { return vertex_halfedges(v); }
+    bool is_boundary(const Index h) const { return twins(h) < 0; }
+    // Next outgoing half-edge around origin(h), -1 when crossing the boundary
+    Index rotate(const Index h) const
+    {
+      const Index t = twins(h);
+      return t < 0 ? -1 : next(t);
+    }
+    // Visit the outgoing half-edges of a vertex in order. Starts from the
+    // boundary so all faces of a manifold boundary vertex are visited.
+    //
+    // Inputs:
+    //   v  index of vertex
+    //   func  function called with each outgoing half-edge
+    template <typename Func>
+    void circulate(const Index v, const Func & func) const
+    {
+      const Index h0 = vertex_halfedges(v);
+      Index h = h0;
+      while(h >= 0)
+      {
+        func(h);
+        h = rotate(h);
+        if(h == h0)
+        {
+          break;
+        }
+      }
+    }
+    // Visit the neighbors of a vertex in order. Unlike the tips of
+    // circulate, this includes the first neighbor of a boundary vertex,
+    // which is only reached by the incoming boundary half-edge.
+    //
+    // Inputs:
+    //   v  index of vertex
+    //   func  function called with each neighboring vertex
+    template <typename Func>
+    void circulate_vertices(const Index v, const Func & func) const
+    {
+      const Index h0 = vertex_halfedges(v);
+      if(h0 >= 0 && twins(prev(h0)) < 0)
+      {
+        func(origins(prev(h0)));
+      }
+      circulate(v,[&](const Index h){ func(tip(h)); });
+    }
+  };
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "HalfEdgeMesh.cpp"
+#endif
+
+#endif
@@ -0,0 +1,115 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2023 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_PHILOX_H
+#define IGL_PHILOX_H
+#include <array>
+#include <cstdint>
+
+namespace igl
+{
+  // Philox4x32-10 counter-based random number generator "Parallel Random
+  // Numbers: As Easy as 1, 2, 3" [Salmon et al. 2011].
+  //
+  // Each output block is a pure function of a 64-bit seed (the key) and a
+  // 128-bit counter, here split into a 64-bit stream id and a 64-bit
+  // position within the stream. Different streams are statistically
+  // independent, so parallel code can give every sample (rather than every
+  // thread) its own stream and produce bitwise identical results regardless
+  // of the number of threads or the order in which samples are processed.
+  //
+  // Satisfies UniformRandomBitGenerator, so it can be passed to
+  // std::shuffle, igl::randperm, std::uniform_real_distribution, etc.
+  //
+  // Example:
+  //   // n uniform numbers, one stream per sample
+  //   igl::parallel_for(n,[&](const int i)
+  //   {
+  //     igl::Philox rng(seed,i);
+  //     X(i) = rng.uniform();
+  //   });
+  class Philox
+  {
+  public:
+    typedef std::uint32_t result_type;
+    // Inputs:
+    //   seed  key shared by all streams
+    //   stream  index of stream
+    Philox(const std::uint64_t seed = 0, const std::uint64_t stream = 0):
+      m_seed(seed),
+      m_stream(stream),
+      m_position(0),
+      m_block(),
+      m_used(4)
+    {}
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return 0xFFFFFFFFu; }
+    // Next 32 random bits of this stream
+    result_type operator()()
+    {
+      if(m_used == 4)
+      {
+        m_block = block(m_seed,m_stream,m_position++);
+        m_used = 0;
+      }
+      return m_block[m_used++];
+    }
+    // Next uniform random number in [0,1) using 53 random bits
+    double uniform()
+    {
+      const std::uint64_t a = (*this)() >> 5;
+      const std::uint64_t b = (*this)() >> 6;
+      return (double(a)*67108864.0+double(b))*(1.0/9007199254740992.0);
+    }
+    // Skip to a given position (in blocks of 4 outputs) of this stream
+    void seek(const std::uint64_t position)
+    {
+      m_position = position;
+      m_used = 4;
+    }
+    // Stateless evaluation of the Philox4x32-10 bijection.
+    //
+    // Inputs:
+    //   seed  64-bit key
+    //   stream  high 64 bits of the counter
+    //   position  low 64 bits of the counter
+    // Returns 4 random 32-bit words
+    static std::array<std::uint32_t,4> block(
+      const std::uint64_t seed,
+      const std::uint64_t stream,
+      const std::uint64_t position)
+    {
+      std::array<std::uint32_t,4> c = {{
+        std::uint32_t(position), std::uint32_t(position>>32),
+        std::uint32_t(stream),   std::uint32_t(stream>>32)}};
+      std::uint32_t k0 = std::uint32_t(seed);
+      std::uint32_t k1 = std::uint32_t(seed>>32);
+      for(int r = 0;r<10;r++)
+      {
+        if(r > 0)
+        {
+          k0 += 0x9E3779B9u;
+          k1 += 0xBB67AE85u;
+        }
+        const std::uint64_t p0 = std::uint64_t(0xD2511F53u)*c[0];
+        const std::uint64_t p1 = std::uint64_t(0xCD9E8D57u)*c[2];
+        c = {{
+          std::uint32_t(p1>>32)^c[1]^k0, std::uint32_t(p1),
+          std::uint32_t(p0>>32)^c[3]^k1, std::uint32_t(p0)}};
+      }
+      return c;
+    }
+  private:
+    std::uint64_t m_seed;
+    std::uint64_t m_stream;
+    std::uint64_t m_position;
+    std::array<std::uint32_t,4> m_block;
+    int m_used;
+  };
+}
+
+#endif
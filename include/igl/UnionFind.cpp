@@ -0,0 +1,119 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2023 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "UnionFind.h"
+#include "parallel_for.h"
+#include <cassert>
+#include <cstdint>
+#include <utility>
+
+template <typename Index>
+IGL_INLINE void igl::UnionFind<Index>::init(const Index n)
+{
+  assert(n >= 0);
+  parent = std::vector<std::atomic<Index> >(n);
+  igl::parallel_for(n,[&](const Index i)
+  {
+    parent[i].store(i,std::memory_order_relaxed);
+  },1000ul);
+}
+
+template <typename Index>
+IGL_INLINE Index igl::UnionFind<Index>::find(Index i)
+{
+  while(true)
+  {
+    Index p = parent[i].load(std::memory_order_relaxed);
+    if(p == i)
+    {
+      return i;
+    }
+    const Index g = parent[p].load(std::memory_order_relaxed);
+    if(g != p)
+    {
+      // Path halving: g is still an ancestor of i even if another thread
+      // changed parent[i] meanwhile, and the CAS only ever lowers it
+      parent[i].compare_exchange_weak(p,g,std::memory_order_relaxed);
+    }
+    i = g;
+  }
+}
+
+template <typename Index>
+IGL_INLINE bool igl::UnionFind<Index>::unite(Index a, Index b)
+{
+  while(true)
+  {
+    a = find(a);
+    b = find(b);
+    if(a == b)
+    {
+      return false;
+    }
+    // Link the larger root below the smaller one
+    if(a < b)
+    {
+      std::swap(a,b);
+    }
+    Index expected = a;
+    if(parent[a].compare_exchange_strong(
+      expected,b,std::memory_order_relaxed))
+    {
+      return true;
+    }
+    // a stopped being a root: retry from its new root
+  }
+}
+
+template <typename Index>
+template <typename DerivedC, typename DerivedK>
+IGL_INLINE Index igl::UnionFind<Index>::components(
+  Eigen::PlainObjectBase<DerivedC> & C,
+  Eigen::PlainObjectBase<DerivedK> & K)
+{
+  const Index n = size();
+  std::vector<Index> R(n);
+  igl::parallel_for(n,[&](const Index i)
+  {
+    R[i] = find(i);
+  },1000ul);
+  // Roots are the smallest elements of their sets, so they are numbered
+  // before any other member is visited
+  std::vector<Index> L(n);
+  std::vector<typename DerivedK::Scalar> vK;
+  for(Index i = 0;i<n;i++)
+  {
+    if(R[i] == i)
+    {
+      L[i] = Index(vK.size());
+      vK.push_back(0);
+    }
+    vK[L[R[i]]]++;
+  }
+  C.resize(n,1);
+  igl::parallel_for(n,[&](const Index i)
+  {
+    C(i) = L[R[i]];
+  },1000ul);
+  K.resize(vK.size(),1);
+  for(size_t k = 0;k<vK.size();k++)
+  {
+    K(k) = vK[k];
+  }
+  return Index(vK.size());
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template class igl::UnionFind<int>;
+template class igl::UnionFind<std::int64_t>;
+template int igl::UnionFind<int>::components<Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
+template int igl::UnionFind<int>::components<Eigen::Array<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::PlainObjectBase<Eigen::Array<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
+template int igl::UnionFind<int>::components<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
+template int igl::UnionFind<int>::components<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
+template std::int64_t igl::UnionFind<std::int64_t>::components<Eigen::Matrix<std::int64_t, -1, 1, 0, -1, 1>, Eigen::Matrix<std::int64_t, -1, 1, 0, -1, 1> >(Eigen::PlainObjectBase<Eigen::Matrix<std::int64_t, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<std::int64_t, -1, 1, 0, -1, 1> >&);
+#endif
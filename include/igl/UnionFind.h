@@ -0,0 +1,75 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2023 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_UNION_FIND_H
+#define IGL_UNION_FIND_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+#include <atomic>
+#include <vector>
+
+namespace igl
+{
+  // Lock-free disjoint-set forest over the elements 0,...,n-1. find and unite
+  // may be called concurrently (e.g., from inside igl::parallel_for).
+  //
+  // Roots are always linked below smaller roots, so the root of each set is
+  // its smallest element and parents only ever decrease: unite is a single
+  // compare-and-swap on the larger root and find compresses paths by halving
+  // with benign races.
+  //
+  // Example:
+  //   igl::UnionFind<int> U(V.rows());
+  //   igl::parallel_for(F.rows(),[&](const int f)
+  //   {
+  //     U.unite(F(f,0),F(f,1));
+  //     U.unite(F(f,0),F(f,2));
+  //   },1000ul);
+  //   Eigen::VectorXi C,K;
+  //   const int k = U.components(C,K);
+  //
+  // See also: connected_components, vertex_components, facet_components
+  template <typename Index>
+  class UnionFind
+  {
+  public:
+    UnionFind(){}
+    // Inputs:
+    //   n  number of elements, each in its own set
+    explicit UnionFind(const Index n){ init(n); }
+    IGL_INLINE void init(const Index n);
+    Index size() const { return Index(parent.size()); }
+    // Inputs:
+    //   i  element
+    // Returns smallest element in the set of i
+    IGL_INLINE Index find(Index i);
+    // Merge the sets of a and b
+    //
+    // Returns true iff a and b were in different sets
+    IGL_INLINE bool unite(Index a, Index b);
+    // Label the sets, numbered in order of their smallest elements (so labels
+    // match a breadth-first search started from each unvisited element in
+    // increasing order). Must not be called concurrently with unite.
+    //
+    // Outputs:
+    //   C  #n list of set ids into [0,#K-1]
+    //   K  #K list of sizes of each set
+    // Returns number of sets
+    template <typename DerivedC, typename DerivedK>
+    IGL_INLINE Index components(
+      Eigen::PlainObjectBase<DerivedC> & C,
+      Eigen::PlainObjectBase<DerivedK> & K);
+  private:
+    std::vector<std::atomic<Index> > parent;
+  };
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "UnionFind.cpp"
+#endif
+
+#endif
@@ -9,6 +9,7 @@
 
 #include "verbose.h"
 #include <algorithm>
+#include <cstdint>
 
 template <typename Index, typename IndexVector>
 IGL_INLINE void igl::adjacency_list(
@@ -177,4 +178,5 @@ template void igl::adjacency_list<Eigen::Matrix<int, -1, -1, 0, -1, -1>, int>(Ei
 template void igl::adjacency_list<Eigen::Matrix<int, -1, 3, 0, -1, 3>, int>(Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 0, -1, 3> > const&, std::vector<std::vector<int, std::allocator<int> >, std::allocator<std::vector<int, std::allocator<int> > > >&, bool);
 template void igl::adjacency_list<class Eigen::Matrix<int, -1, -1, 0, -1, -1>, unsigned int>(class Eigen::MatrixBase<class Eigen::Matrix<int, -1, -1, 0, -1, -1> > const &, class std::vector<class std::vector<unsigned int, class std::allocator<unsigned int> >, class std::allocator<class std::vector<unsigned int, class std::allocator<unsigned int> > > > &, bool);
 template void igl::adjacency_list<int>(std::vector<std::vector<int, std::allocator<int> >, std::allocator<std::vector<int, std::allocator<int> > > > const&, std::vector<std::vector<int, std::allocator<int> >, std::allocator<std::vector<int, std::allocator<int> > > >&);
+template void igl::adjacency_list<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1>, std::int64_t>(Eigen::MatrixBase<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> > const&, std::vector<std::vector<std::int64_t, std::allocator<std::int64_t> >, std::allocator<std::vector<std::int64_t, std::allocator<std::int64_t> > > >&, bool);
 #endif
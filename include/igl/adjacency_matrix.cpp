@@ -10,6 +10,7 @@
 #include "verbose.h"
 
 #include <vector>
+#include <cstdint>
 
 template <typename DerivedF, typename T>
 IGL_INLINE void igl::adjacency_matrix(
@@ -122,4 +123,5 @@ template void igl::adjacency_matrix<Eigen::Matrix<int, -1, -1, 0, -1, -1>, bool>
 template void igl::adjacency_matrix<Eigen::Matrix<int, -1, -1, 0, -1, -1>, double>(Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::SparseMatrix<double, 0, int>&);
 template void igl::adjacency_matrix<Eigen::Matrix<int, -1, -1, 0, -1, -1>, int>(Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::SparseMatrix<int, 0, int>&);
 template void igl::adjacency_matrix<Eigen::Matrix<int, -1, 3, 0, -1, 3>, int>(Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 0, -1, 3> > const&, Eigen::SparseMatrix<int, 0, int>&);
+template void igl::adjacency_matrix<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1>, std::int64_t>(Eigen::MatrixBase<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> > const&, Eigen::SparseMatrix<std::int64_t, 0, int>&);
 #endif
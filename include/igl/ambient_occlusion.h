@@ -40,6 +40,26 @@ namespace igl
     Eigen::PlainObjectBase<DerivedS> & S);
   // Inputs:
   //   AABB  axis-aligned bounding box hierarchy around (V,F)
+  //   max_distance  only hits closer than this to P occlude (e.g., a
+  //     fraction of the bounding box diagonal for local occlusion); rays
+  //     stop traversing the hierarchy beyond it
+  template <
+    typename DerivedV,
+    int DIM,
+    typename DerivedF,
+    typename DerivedP,
+    typename DerivedN,
+    typename DerivedS >
+  IGL_INLINE void ambient_occlusion(
+    const igl::AABB<DerivedV,DIM> & aabb,
+    const Eigen::MatrixBase<DerivedV> & V,
+    const Eigen::MatrixBase<DerivedF> & F,
+    const Eigen::MatrixBase<DerivedP> & P,
+    const Eigen::MatrixBase<DerivedN> & N,
+    const int num_samples,
+    const typename DerivedV::Scalar max_distance,
+    Eigen::PlainObjectBase<DerivedS> & S);
+  // Unbounded max_distance
   template <
     typename DerivedV,
     int DIM,
@@ -58,6 +78,20 @@ namespace igl
   // Inputs:
   //    V  #V by 3 list of mesh vertex positions
   //    F  #F by 3 list of mesh face indices into V
+  template <
+    typename DerivedV,
+    typename DerivedF,
+    typename DerivedP,
+    typename DerivedN,
+    typename DerivedS >
+  IGL_INLINE void ambient_occlusion(
+    const Eigen::MatrixBase<DerivedV> & V,
+    const Eigen::MatrixBase<DerivedF> & F,
+    const Eigen::MatrixBase<DerivedP> & P,
+    const Eigen::MatrixBase<DerivedN> & N,
+    const int num_samples,
+    const typename DerivedV::Scalar max_distance,
+    Eigen::PlainObjectBase<DerivedS> & S);
   template <
     typename DerivedV,
     typename DerivedF,
@@ -18,6 +18,7 @@
 #include "arap_rhs.h"
 #include "repdiag.h"
 #include "columnize.h"
+#include "Timer.h"
 #include "fit_rotations.h"
 #include <cassert>
 #include <iostream>
@@ -195,8 +196,11 @@ IGL_INLINE bool igl::arap_solve(
   {
     U0 = U_prev;
   }
+  data.timings.clear();
+  igl::Timer timer;
   while(iter < data.max_iter)
   {
+    timer.start();
     U_prev = U;
     // enforce boundary conditions exactly
     for(int bi = 0;bi<bc.rows();bi++)
@@ -231,6 +235,8 @@ IGL_INLINE bool igl::arap_solve(
     //  R.block(0,dim*k,dim,dim) = MatrixXd::Identity(dim,dim);
     //}
 
+    data.timings.local.push_back(timer.getElapsedTimeInSec());
+    timer.start();
 
     // Number of rotations: #vertices or #elements
     int num_rots = data.K.cols()/Rdim/Rdim;
@@ -270,6 +276,8 @@ IGL_INLINE bool igl::arap_solve(
     columnize(eff_R,num_rots,2,Rcol);
     VectorXd Bcol = -data.K * Rcol;
     assert(Bcol.size() == data.n*data.dim);
+    data.timings.rhs.push_back(timer.getElapsedTimeInSec());
+    timer.start();
     for(int c = 0;c<data.dim;c++)
     {
       VectorXd Uc,Bc,bcc,Beq;
@@ -288,6 +296,7 @@ IGL_INLINE bool igl::arap_solve(
         Uc);
       U.col(c) = Uc;
     }
+    data.timings.global.push_back(timer.getElapsedTimeInSec());
 
     iter++;
   }
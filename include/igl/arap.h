@@ -12,6 +12,7 @@
 #include "ARAPEnergyType.h"
 #include <Eigen/Core>
 #include <Eigen/Sparse>
+#include <vector>
 
 namespace igl
 {
@@ -33,6 +34,9 @@ namespace igl
     // solver_data  quadratic solver data
     // b  list of boundary indices into V
     // dim  dimension being used for solving
+    // timings  per-iteration timing breakdown (seconds) of the most recent
+    //   call to arap_solve: local step (covariances and rotation fitting),
+    //   right-hand side assembly, and global step (linear solves)
     int n;
     Eigen::VectorXi G;
     ARAPEnergyType energy;
@@ -46,6 +50,11 @@ namespace igl
     min_quad_with_fixed_data<double> solver_data;
     Eigen::VectorXi b;
     int dim;
+    struct Timings
+    {
+      std::vector<double> local, rhs, global;
+      void clear() { local.clear(); rhs.clear(); global.clear(); }
+    } timings;
       ARAPData():
         n(0),
         G(),
@@ -11,6 +11,7 @@
 #include "parallel_for.h"
 #include <Eigen/Sparse>
 #include <iostream>
+#include <memory>
 #include <mutex>
 #include <cstdio>
 
@@ -18,6 +19,7 @@ igl::BBWData::BBWData():
   partition_unity(false),
   W0(),
   active_set_params(),
+  low_rank_max(100),
   verbosity(0)
 {
   // We know that the Bilaplacian is positive semi-definite
@@ -83,6 +85,258 @@ IGL_INLINE bool igl::bbw(
   // decrement
   eff_params.max_iter--;
   bool error = false;
+  // Box constrained active set built on low-rank updates of a factorization.
+  // The initial factorization is the one in mqwf (only b known), shared by
+  // all handles. Bounds that become active on free variables (set A) or
+  // inactive on variables fixed in the factorization (set R) modify its
+  // system by a bordered Schur complement. With K = Q_FF⁻¹ of the
+  // factorization and G = [Q_FR E_A]:
+  //
+  //   S z = [r_R; v_A] - Gᵀ K r_F,  S = [Q_RR 0;0 0] - Gᵀ K G,
+  //   x_F = K (r_F - G z),  z = [x_R; μ]
+  //
+  // Entries of Gᵀ K G are cached, costing one solve per newly modified bound.
+  // Once more than data.low_rank_max bounds are modified, the handle
+  // refactors with its current active set (which is what igl::active_set
+  // does every iteration). Otherwise this mirrors the iteration of
+  // igl::active_set. Returns SOLVER_STATUS_ERROR if a factorization fails,
+  // so that the caller can fall back to igl::active_set.
+  typedef Eigen::SparseMatrix<typename DerivedV::Scalar> SparseMatrixS;
+  typedef min_quad_with_fixed_data<typename DerivedW::Scalar> MQWFData;
+  Eigen::Matrix<bool,Eigen::Dynamic,1> is_known =
+    Eigen::Matrix<bool,Eigen::Dynamic,1>::Constant(n,false);
+  for(int k = 0;k<b.size();k++)
+  {
+    is_known(b(k)) = true;
+  }
+  // Minimize ½ ZᵀQZ + ZᵀB with Z(known) = Y(known)
+  const auto fixed_solve = [&](
+    const MQWFData & mqwf_data,
+    const VectorXi & known,
+    const VectorXd & B,
+    const VectorXd & Y,
+    VectorXd & Z)
+  {
+    VectorXd Yk(known.size());
+    for(int k = 0;k<known.size();k++)
+    {
+      Yk(k) = Y(known(k));
+    }
+    min_quad_with_fixed_solve(mqwf_data,B,Yk,Beq,Z);
+  };
+  const auto & active_set_low_rank = [&](
+    const VectorXd & bci, VectorXd & Z)->SolverStatus
+  {
+    if(data.low_rank_max <= 0)
+    {
+      return SOLVER_STATUS_ERROR;
+    }
+    // Current factorization and its fixed variables (b and active bounds)
+    std::unique_ptr<MQWFData> local;
+    const MQWFData * base = &mqwf;
+    VectorXi base_known = b;
+    Eigen::Matrix<bool,Eigen::Dynamic,1> is_base_known = is_known;
+    VectorXd bc_full = VectorXd::Zero(n);
+    for(int k = 0;k<b.size();k++)
+    {
+      bc_full(b(k)) = bci(k);
+    }
+    // Cached Gᵀ K G over every bound modified relative to the factorization
+    std::vector<int> mods;
+    std::vector<int> mod_index(n,-1);
+    MatrixXd GKG;
+    // +1 at lower bound, -1 at upper bound, 0 inactive
+    VectorXi as = VectorXi::Zero(n);
+    const auto bound = [&](const int z){ return as(z) > 0 ? lx(z) : ux(z); };
+    // gᵀ x for the column of G belonging to a modified bound z
+    const auto g_dot = [&](const int z, const VectorXd & x)
+    {
+      if(!is_base_known(z))
+      {
+        return x(z);
+      }
+      double d = 0;
+      for(typename SparseMatrixS::InnerIterator it(Q,z);it;++it)
+      {
+        if(!is_base_known(it.row()))
+        {
+          d += it.value()*x(it.row());
+        }
+      }
+      return d;
+    };
+    // x += α g
+    const auto g_add = [&](const int z, const double alpha, VectorXd & x)
+    {
+      if(!is_base_known(z))
+      {
+        x(z) += alpha;
+        return;
+      }
+      for(typename SparseMatrixS::InnerIterator it(Q,z);it;++it)
+      {
+        if(!is_base_known(it.row()))
+        {
+          x(it.row()) += alpha*it.value();
+        }
+      }
+    };
+    const VectorXd zero = VectorXd::Zero(n);
+    VectorXd old_Z = VectorXd::Constant(n,std::numeric_limits<double>::max());
+    int iter = 0;
+    while(true)
+    {
+      // Find breaches of constraints
+      for(int z = 0;z<n;z++)
+      {
+        if(!is_known(z) && (Z(z) < lx(z) || Z(z) > ux(z)))
+        {
+          as(z) = Z(z) < lx(z) ? 1 : -1;
+        }
+      }
+      if((Z-old_Z).squaredNorm() < eff_params.solution_diff_threshold)
+      {
+        return SOLVER_STATUS_CONVERGED;
+      }
+      old_Z = Z;
+      // Bounds modified relative to the factorization
+      std::vector<int> cur,added;
+      for(int z = 0;z<n;z++)
+      {
+        if(!is_known(z) && (is_base_known(z) == (as(z) == 0)))
+        {
+          cur.push_back(z);
+          if(mod_index[z] < 0)
+          {
+            added.push_back(z);
+          }
+        }
+      }
+      if(int(mods.size() + added.size()) > data.low_rank_max)
+      {
+        // Refactor with the current active set
+        std::vector<int> known_i(b.data(),b.data()+b.size());
+        for(int z = 0;z<n;z++)
+        {
+          is_base_known(z) = is_known(z) || as(z) != 0;
+          if(!is_known(z) && as(z) != 0)
+          {
+            known_i.push_back(z);
+          }
+        }
+        if(int(known_i.size()) == n)
+        {
+          return SOLVER_STATUS_ERROR;
+        }
+        base_known = Eigen::Map<VectorXi>(known_i.data(),known_i.size());
+        local.reset(new MQWFData());
+        if(!min_quad_with_fixed_precompute(
+          Q,base_known,Aeq,eff_params.Auu_pd,*local))
+        {
+          return SOLVER_STATUS_ERROR;
+        }
+        base = local.get();
+        for(const int z : mods)
+        {
+          mod_index[z] = -1;
+        }
+        mods.clear();
+        GKG.resize(0,0);
+        cur.clear();
+        added.clear();
+      }else if(!added.empty())
+      {
+        // Low-rank update: extend Gᵀ K G by the newly modified bounds
+        const int na = added.size();
+        const int ne = mods.size();
+        for(int k = 0;k<na;k++)
+        {
+          mod_index[added[k]] = ne+k;
+          mods.push_back(added[k]);
+        }
+        GKG.conservativeResize(ne+na,ne+na);
+        for(int k = 0;k<na;k++)
+        {
+          VectorXd g = VectorXd::Zero(n), Kg;
+          g_add(added[k],-1.0,g);
+          fixed_solve(*base,base_known,g,zero,Kg);
+          for(int e = 0;e<ne+na;e++)
+          {
+            GKG(e,ne+k) = GKG(ne+k,e) = g_dot(mods[e],Kg);
+          }
+        }
+      }
+      // Values of the fixed variables (released ones are zeroed)
+      VectorXd Y = bc_full;
+      for(int z = 0;z<n;z++)
+      {
+        if(!is_known(z) && is_base_known(z) && as(z) != 0)
+        {
+          Y(z) = bound(z);
+        }
+      }
+      VectorXd y;
+      fixed_solve(*base,base_known,zero,Y,y);
+      // Bordered Schur complement system
+      const int m_cur = cur.size();
+      VectorXd zc(m_cur);
+      if(m_cur > 0)
+      {
+        const VectorXd t = Q*Y;
+        MatrixXd Sc(m_cur,m_cur);
+        VectorXd rhs(m_cur);
+        for(int i = 0;i<m_cur;i++)
+        {
+          const int zi = cur[i];
+          const bool released_i = is_base_known(zi);
+          rhs(i) = released_i ? -t(zi) - g_dot(zi,y) : bound(zi) - y(zi);
+          for(int j = 0;j<m_cur;j++)
+          {
+            const int zj = cur[j];
+            Sc(i,j) =
+              (released_i && is_base_known(zj) ? Q.coeff(zi,zj) : 0) -
+              GKG(mod_index[zi],mod_index[zj]);
+          }
+        }
+        zc = Sc.partialPivLu().solve(rhs);
+        if(!zc.allFinite())
+        {
+          return SOLVER_STATUS_ERROR;
+        }
+      }
+      {
+        VectorXd Bi = VectorXd::Zero(n);
+        for(int i = 0;i<m_cur;i++)
+        {
+          g_add(cur[i],zc(i),Bi);
+        }
+        fixed_solve(*base,base_known,Bi,Y,Z);
+        for(int i = 0;i<m_cur;i++)
+        {
+          // released variables are free again, others snap to their bound
+          Z(cur[i]) = is_base_known(cur[i]) ? zc(i) : bound(cur[i]);
+        }
+      }
+      // Remove from active set (same multipliers as igl::active_set)
+      const VectorXd grad = Q*Z;
+      for(int z = 0;z<n;z++)
+      {
+        if(as(z) != 0)
+        {
+          const double lambda = (as(z) > 0 ? 0.5 : -0.5)*grad(z);
+          if(lambda < eff_params.inactive_threshold)
+          {
+            as(z) = 0;
+          }
+        }
+      }
+      iter++;
+      if(eff_params.max_iter>0 && iter>=eff_params.max_iter)
+      {
+        return SOLVER_STATUS_MAX_ITER;
+      }
+    }
+  };
   // Loop over handles
   std::mutex critical;
   const auto & optimize_weight = [&](const int i)
@@ -102,8 +356,16 @@ IGL_INLINE bool igl::bbw(
     VectorXd Wi;
     // use initial guess
     Wi = W.col(i);
-    SolverStatus ret = active_set(
-        Q,c,b,bci,Aeq,Beq,Aieq,Bieq,lx,ux,eff_params,Wi);
+    SolverStatus ret = active_set_low_rank(bci,Wi);
+    if(ret == SOLVER_STATUS_ERROR)
+    {
+      if(data.verbosity >= 1)
+      {
+        std::lock_guard<std::mutex> lock(critical);
+        cout<<"BBW: Falling back to active_set for handle "<<i+1<<"."<<endl;
+      }
+      ret = active_set(Q,c,b,bci,Aeq,Beq,Aieq,Bieq,lx,ux,eff_params,Wi);
+    }
     switch(ret)
     {
       case SOLVER_STATUS_CONVERGED:
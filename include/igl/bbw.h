@@ -24,6 +24,12 @@ namespace igl
       // Initial guess
       Eigen::MatrixXd W0;
       igl::active_set_params active_set_params;
+      // Maximum number of bound constraints whose activation/release is
+      // applied as a low-rank (Schur complement) update of the current
+      // factorization (initially the unconstrained bi-Laplacian's, shared by
+      // all handles) before refactoring with the current active set. Set to
+      // 0 to use igl::active_set (which refactors every iteration) {100}
+      int low_rank_max;
       // Verbosity level
       // 0: quiet
       // 1: loud
@@ -8,14 +8,14 @@
 #include "blue_noise.h"
 #include "doublearea.h"
 #include "random_points_on_mesh.h"
-#include "slice.h"
-#include "sortrows.h"
 #include "PI.h"
 #include "get_seconds.h"
+#include "Philox.h"
+#include "parallel_for.h"
 #include <unordered_map>
+#include <array>
 #include <algorithm>
 #include <vector>
-#include <random>
 
 namespace igl
 {
@@ -46,195 +46,47 @@ namespace igl
   {
     return x+w*(y+w*z);
   }
-  // Determine if a query candidate at position X.row(i) is too close to already
-  // selected sites (stored in S).
+  // Gather already selected sites (stored in S) in cells near a given cell.
   //
   // Inputs:
-  //   X  #X by 3 list of raw candidate positions
-  //   Xs  #Xs by 3 list of corresponding integer cell subscripts
-  //   i  index of candidate in question
-  //   S   map from cell index to index into X of selected candidate (or -1 if
-  //     cell is currently empty)
-  //   rr  Poisson disk radius squared
+  //   Xs  #Xs by 3 list of integer cell subscripts of candidates
+  //   i  index of any candidate in the cell in question
+  //   C  map from cell key to cell index
+  //   S  #cells list of indices into X of selected candidate (or -1 if cell is
+  //     currently empty)
   //   w  side length of w×w×w integer cube lattice (into which Xs subscripts)
-  template <
-    typename DerivedX,
-    typename DerivedXs>
-  inline bool blue_noise_far_enough(
-    const Eigen::MatrixBase<DerivedX> & X,
+  // Outputs:
+  //   N  indices into X of selected sites within 2 cells (ceil(r/s)) of cell
+  //   n  number of entries in N
+  template <typename DerivedXs>
+  inline void blue_noise_neighbors(
     const Eigen::MatrixBase<DerivedXs> & Xs,
-    const std::unordered_map<BlueNoiseKeyType,int> & S,
-    const double & rr,
+    const int i,
+    const std::unordered_map<BlueNoiseKeyType,int> & C,
+    const std::vector<int> & S,
     const int & w,
-    const int i)
+    std::array<int,124> & N,
+    int & n)
   {
     const int xi = Xs(i,0);
     const int yi = Xs(i,1);
     const int zi = Xs(i,2);
-    BlueNoiseKeyType k = blue_noise_key(w,xi,yi,zi);
     int g = 2; // ceil(r/s)
+    n = 0;
     for(int x = std::max(xi-g,0);x<=std::min(xi+g,w-1);x++)
     for(int y = std::max(yi-g,0);y<=std::min(yi+g,w-1);y++)
     for(int z = std::max(zi-g,0);z<=std::min(zi+g,w-1);z++)
     {
       if(x!=xi || y!=yi || z!=zi)
       {
-        const BlueNoiseKeyType nk = blue_noise_key(w,x,y,z);
+        const auto Citer = C.find(blue_noise_key(w,x,y,z));
         // have already selected from this cell
-        const auto Siter = S.find(nk);
-        if(Siter !=S.end() && Siter->second >= 0)
+        if(Citer != C.end() && S[Citer->second] >= 0)
         {
-          const int ni = Siter->second;
-          // too close
-          if( (X.row(i)-X.row(ni)).squaredNorm() < rr)
-          {
-            return false;
-          }
-        }
-      }
-    }
-    return true;
-  }
-  // Try to activate a candidate in a given cell
-  //
-  // Inputs:
-  //   X  #X by 3 list of raw candidate positions
-  //   Xs  #Xs by 3 list of corresponding integer cell subscripts
-  //   rr  Poisson disk radius squared
-  //   w  side length of w×w×w integer cube lattice (into which Xs subscripts)
-  //   nk  index of cell in which we'd like to activate a candidate
-  //   M   map from cell index to list of candidates
-  //   S   map from cell index to index into X of selected candidate (or -1 if
-  //     cell is currently empty)
-  //   active   list of indices into X of active candidates
-  // Outputs:
-  //   M  visited candidates deemed too close to already selected points are
-  //      removed
-  //   S  updated to reflect activated point (if successful)
-  //   active   updated to reflect activated point (if successful)
-  // Returns true iff activation was successful
-  template <
-    typename DerivedX,
-    typename DerivedXs>
-  inline bool activate(
-    const Eigen::MatrixBase<DerivedX> & X,
-    const Eigen::MatrixBase<DerivedXs> & Xs,
-    const double & rr,
-    const int & i,
-    const int & w,
-    const BlueNoiseKeyType & nk,
-    std::unordered_map<BlueNoiseKeyType,std::vector<int> > & M,
-    std::unordered_map<BlueNoiseKeyType,int> & S,
-    std::vector<int> & active)
-  {
-    assert(M.count(nk));
-    auto & Mvec = M.find(nk)->second;
-    auto miter = Mvec.begin();
-    while(miter != Mvec.end())
-    {
-      const int mi = *miter;
-      // mi is our candidate sample. Is it far enough from all existing
-      // samples?
-      if(i>=0 && (X.row(i)-X.row(mi)).squaredNorm() > 4.*rr)
-      {
-        // too far skip (reject)
-       miter++;
-      } else if(blue_noise_far_enough(X,Xs,S,rr,w,mi))
-      {
-        active.push_back(mi);
-        S.find(nk)->second = mi;
-        //printf("  found %d\n",mi);
-        return true;
-      }else
-      {
-        // remove forever (instead of incrementing we swap and eat from the
-        // back)
-        //std::swap(*miter,Mvec.back());
-        *miter = Mvec.back();
-        bool was_last = (std::next(miter) == Mvec.end());
-        Mvec.pop_back();
-        if (was_last) {
-          // popping from the vector can invalidate the iterator, if it was
-          // pointing to the last element that was popped. Alternatively,
-          // one could use indices directly...
-          miter = Mvec.end();
+          N[n++] = S[Citer->second];
         }
       }
     }
-    return false;
-  }
-
-  template <
-    typename DerivedX,
-    typename DerivedXs>
-  inline bool step(
-    const Eigen::MatrixBase<DerivedX> & X,
-    const Eigen::MatrixBase<DerivedXs> & Xs,
-    const double & rr,
-    const int & w,
-    std::unordered_map<BlueNoiseKeyType,std::vector<int> > & M,
-    std::unordered_map<BlueNoiseKeyType,int> & S,
-    std::vector<int> & active,
-    std::vector<int> & collected
-    )
-  {
-    //considered.clear();
-    if(active.size() == 0) return false;
-    // random entry
-    const int e = rand() % active.size();
-    const int i = active[e];
-    //printf("%d\n",i);
-    const int xi = Xs(i,0);
-    const int yi = Xs(i,1);
-    const int zi = Xs(i,2);
-    //printf("%d %d %d - %g %g %g\n",xi,yi,zi,X(i,0),X(i,1),X(i,2));
-    // cell indices of neighbors
-    int g = 4;
-    std::vector<BlueNoiseKeyType> N;N.reserve((1+g*1)^3-1);
-    for(int x = std::max(xi-g,0);x<=std::min(xi+g,w-1);x++)
-    for(int y = std::max(yi-g,0);y<=std::min(yi+g,w-1);y++)
-    for(int z = std::max(zi-g,0);z<=std::min(zi+g,w-1);z++)
-    {
-      if(x!=xi || y!=yi || z!=zi)
-      {
-        //printf("  %d %d %d\n",x,y,z);
-        const BlueNoiseKeyType nk = blue_noise_key(w,x,y,z);
-        // haven't yet selected from this cell?
-        const auto Siter = S.find(nk);
-        if(Siter !=S.end() && Siter->second < 0)
-        {
-          assert(M.find(nk) != M.end());
-          N.emplace_back(nk);
-        }
-      }
-    }
-        //printf("  --------\n");
-    // randomize order: this might be a little paranoid...
-    std::mt19937 twister;
-    std::shuffle(std::begin(N), std::end(N), twister);
-    bool found = false;
-    for(const BlueNoiseKeyType & nk : N)
-    {
-      assert(M.find(nk) != M.end());
-      if(activate(X,Xs,rr,i,w,nk,M,S,active))
-      {
-        found = true;
-        break;
-      }
-    }
-    if(!found)
-    {
-      // remove i from active list
-      // https://stackoverflow.com/a/60765833/148668
-      collected.push_back(i);
-      //printf("  before: "); for(const int j : active) { printf("%d ",j); } printf("\n");
-      std::swap(active[e], active.back());
-      //printf("  after : "); for(const int j : active) { printf("%d ",j); } printf("\n");
-      active.pop_back();
-      //printf("  removed %d\n",i);
-    }
-    //printf("  active: "); for(const int j : active) { printf("%d ",j); } printf("\n");
-    return true;
   }
 }
 
@@ -251,6 +103,24 @@ IGL_INLINE void igl::blue_noise(
     Eigen::PlainObjectBase<DerivedB> & B,
     Eigen::PlainObjectBase<DerivedFI> & FI,
     Eigen::PlainObjectBase<DerivedP> & P)
+{
+  return blue_noise(V,F,r,B,FI,P,std::uint64_t(rand()));
+}
+
+template <
+  typename DerivedV,
+  typename DerivedF,
+  typename DerivedB,
+  typename DerivedFI,
+  typename DerivedP>
+IGL_INLINE void igl::blue_noise(
+    const Eigen::MatrixBase<DerivedV> & V,
+    const Eigen::MatrixBase<DerivedF> & F,
+    const typename DerivedV::Scalar r,
+    Eigen::PlainObjectBase<DerivedB> & B,
+    Eigen::PlainObjectBase<DerivedFI> & FI,
+    Eigen::PlainObjectBase<DerivedP> & P,
+    const std::uint64_t seed)
 {
   typedef typename DerivedV::Scalar Scalar;
   typedef Eigen::Matrix<Scalar,Eigen::Dynamic,1> VectorXS;
@@ -279,78 +149,118 @@ IGL_INLINE void igl::blue_noise(
   const int nx = 30.0*expected_number_of_points;
   MatrixX3S X,XB;
   Eigen::VectorXi XFI;
-  igl::random_points_on_mesh(nx,V,F,XB,XFI,X);
+  igl::random_points_on_mesh(nx,V,F,XB,XFI,X,seed);
 
   // Rescale so that s = 1
   Eigen::Matrix<int,Eigen::Dynamic,3,Eigen::RowMajor> Xs =
     ((X.rowwise()-X.colwise().minCoeff())/s).template cast<int>();
   const int w = Xs.maxCoeff()+1;
   {
-    Eigen::VectorXi I;
-    igl::sortrows(decltype(Xs)(Xs),true,Xs,I);
-    igl::slice(decltype(X)(X),I,1,X);
-    // These two could be spun off in their own thread.
-    igl::slice(decltype(XB)(XB),I,1,XB);
-    igl::slice(decltype(XFI)(XFI),I,1,XFI);
+    // Sort candidates by cell key (ties by index so that candidates within a
+    // cell keep their random order)
+    std::vector<std::pair<BlueNoiseKeyType,int> > KI(Xs.rows());
+    igl::parallel_for(Xs.rows(),[&](const int i)
+    {
+      KI[i] = {blue_noise_key(w,Xs(i,0),Xs(i,1),Xs(i,2)),i};
+    },10000);
+    std::sort(KI.begin(),KI.end());
+    const decltype(Xs) Xs0 = Xs;
+    const decltype(X) X0 = X;
+    const decltype(XB) XB0 = XB;
+    const decltype(XFI) XFI0 = XFI;
+    igl::parallel_for(Xs.rows(),[&](const int i)
+    {
+      const int j = KI[i].second;
+      Xs.row(i) = Xs0.row(j);
+      X.row(i) = X0.row(j);
+      XB.row(i) = XB0.row(j);
+      XFI(i) = XFI0(j);
+    },10000);
   }
-  // Initialization
-  std::unordered_map<BlueNoiseKeyType,std::vector<int> > M;
-  std::unordered_map<BlueNoiseKeyType, int > S;
-  // attempted to seed
-  std::unordered_map<BlueNoiseKeyType, int > A;
-  // Q: Too many?
-  // A: Seems to help though.
-  M.reserve(Xs.rows());
-  S.reserve(Xs.rows());
+  // Group candidates by cell: candidates of cell c are CI[c],…,CI[c+1]-1
+  // (contiguous since Xs is sorted)
+  std::vector<int> CI;
+  std::unordered_map<BlueNoiseKeyType,int> C;
+  C.reserve(Xs.rows());
+  std::vector<int> phase_of;
   for(int i = 0;i<Xs.rows();i++)
   {
-    BlueNoiseKeyType k = blue_noise_key(w,Xs(i,0),Xs(i,1),Xs(i,2));
-    const auto Miter = M.find(k);
-    if(Miter  == M.end())
-    {
-      M.insert({k,{i}});
-    }else
+    if(i == 0 || (Xs.row(i) != Xs.row(i-1)))
     {
-      Miter->second.push_back(i);
+      C.emplace(blue_noise_key(w,Xs(i,0),Xs(i,1),Xs(i,2)),CI.size());
+      CI.push_back(i);
+      phase_of.push_back(Xs(i,0)%3 + 3*(Xs(i,1)%3) + 9*(Xs(i,2)%3));
     }
-    S.emplace(k,-1);
-    A.emplace(k,false);
   }
+  const int nc = CI.size();
+  CI.push_back(Xs.rows());
+  // S[c] index into X of selected candidate in cell c (or -1 if empty)
+  std::vector<int> S(nc,-1);
+  // next[c] index into X of next candidate to try in cell c
+  std::vector<int> next(CI.begin(),CI.end()-1);
+  // Cells whose subscripts agree modulo 3 (same "phase") are at least 3 cells
+  // (2s > r) apart along some axis, so they never conflict and can be
+  // processed concurrently [Wei 2008]. Cells of other phases are only read.
+  std::vector<std::vector<int> > phases(27);
+  for(int c = 0;c<nc;c++)
+  {
+    phases[phase_of[c]].push_back(c);
+  }
+  const auto done = [&](const int c)->bool
+  {
+    return S[c] >= 0 || next[c] == CI[c+1];
+  };
 
-  std::vector<int> active;
   // precompute r²
   // Q: is this necessary?
   const double rr = r*r;
-  std::vector<int> collected;
-  collected.reserve(2.0*expected_number_of_points);
-
-  auto Mouter = M.begin();
-  // Just take the first point as the initial seed
-  const auto initialize = [&]()->bool
+  // Use a separate stream from the one used for the candidates
+  igl::Philox rng(seed,std::uint64_t(-1));
+  // Number of candidates tried per empty cell and phase
+  const int trials = 8;
+  std::vector<int> order(27);
+  bool any_pending = nc > 0;
+  while(any_pending)
   {
-    while(true)
+    any_pending = false;
+    // Random phase order each pass (avoids directional bias) and only a few
+    // trials per empty cell and visit. Result only depends on the seed, not
+    // on the number of threads.
+    for(int p = 0;p<27;p++) { order[p] = p; }
+    std::shuffle(order.begin(),order.end(),rng);
+    for(const int p : order)
     {
-      if(Mouter == M.end())
+      std::vector<int> & cells = phases[p];
+      igl::parallel_for(cells.size(),[&](const int j)
       {
-        return false;
-      }
-      const BlueNoiseKeyType k = Mouter->first;
-      // Haven't placed in this cell yet
-      if(S[k]<0)
-      {
-        if(activate(X,Xs,rr,-1,w,k,M,S,active)) return true;
-      }
-      Mouter++;
+        const int c = cells[j];
+        std::array<int,124> N;
+        int n;
+        blue_noise_neighbors(Xs,CI[c],C,S,w,N,n);
+        // Selected sites only ever get added, so rejected candidates stay
+        // rejected
+        for(int t = 0;t<trials && next[c]<CI[c+1];t++)
+        {
+          const int i = next[c]++;
+          if(std::all_of(N.begin(),N.begin()+n,[&](const int ni)
+            { return (X.row(i)-X.row(ni)).squaredNorm() >= rr; }))
+          {
+            S[c] = i;
+            break;
+          }
+        }
+      },1000);
+      cells.erase(std::remove_if(cells.begin(),cells.end(),done),cells.end());
+      any_pending = any_pending || !cells.empty();
     }
-    assert(false && "should not be reachable.");
-  };
-
-  // important if mesh contains many connected components
-  while(initialize())
+  }
+  std::vector<int> collected;
+  collected.reserve(2.0*expected_number_of_points);
+  for(int c = 0;c<nc;c++)
   {
-    while(active.size()>0)
+    if(S[c] >= 0)
     {
-      step(X,Xs,rr,w,M,S,active,collected);
+      collected.push_back(S[c]);
     }
   }
   {
@@ -371,4 +281,6 @@ IGL_INLINE void igl::blue_noise(
 #ifdef IGL_STATIC_LIBRARY
 template void igl::blue_noise<Eigen::Matrix<float, -1, 3, 1, -1, 3>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, 3, 1, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<float, -1, 3, 1, -1, 3>::Scalar, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
 template void igl::blue_noise<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<double, -1, -1, 0, -1, -1>::Scalar, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
+template void igl::blue_noise<Eigen::Matrix<float, -1, 3, 1, -1, 3>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, 3, 1, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<float, -1, 3, 1, -1, 3>::Scalar, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, std::uint64_t);
+template void igl::blue_noise<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<double, -1, -1, 0, -1, -1>::Scalar, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, std::uint64_t);
 #endif
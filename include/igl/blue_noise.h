@@ -9,13 +9,14 @@
 #define IGL_BLUE_NOISE_H
 #include "igl_inline.h"
 #include <Eigen/Core>
+#include <cstdint>
 namespace igl
 {
-  // "Fast Poisson Disk Sampling in Arbitrary Dimensions" [Bridson 2007]
-  //
-  // For very dense samplings this is faster than (up to 2x) cyCodeBase's
-  // implementation of "Sample Elimination for Generating Poisson Disk Sample
-  // Sets" [Yuksel 2015]. YMMV
+  // Poisson disk sampling of a triangle mesh by dart throwing on a background
+  // grid "Parallel Poisson Disk Sampling" [Wei 2008]. Grid cells are split
+  // into 27 phase groups whose cells cannot conflict and are filled in
+  // parallel, so the output only depends on the seed (not on the number of
+  // threads).
   //
   // Inputs:
   //   V  #V by dim list of mesh vertex positions
@@ -40,6 +41,23 @@ namespace igl
       Eigen::PlainObjectBase<DerivedB> & B,
       Eigen::PlainObjectBase<DerivedFI> & FI,
       Eigen::PlainObjectBase<DerivedP> & P);
+  // Inputs:
+  //   seed  seed of the random number generator (see igl::Philox), the same
+  //     seed always produces the same samples
+  template <
+    typename DerivedV,
+    typename DerivedF,
+    typename DerivedB,
+    typename DerivedFI,
+    typename DerivedP>
+  IGL_INLINE void blue_noise(
+      const Eigen::MatrixBase<DerivedV> & V,
+      const Eigen::MatrixBase<DerivedF> & F,
+      const typename DerivedV::Scalar r,
+      Eigen::PlainObjectBase<DerivedB> & B,
+      Eigen::PlainObjectBase<DerivedFI> & FI,
+      Eigen::PlainObjectBase<DerivedP> & P,
+      const std::uint64_t seed);
 }
 
 #ifndef IGL_STATIC_LIBRARY
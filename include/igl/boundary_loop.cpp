@@ -11,6 +11,7 @@
 #include "vertex_triangle_adjacency.h"
 #include "is_border_vertex.h"
 #include <set>
+#include <cstdint>
 
 template <typename DerivedF, typename Index>
 IGL_INLINE void igl::boundary_loop(
@@ -151,4 +152,5 @@ IGL_INLINE void igl::boundary_loop(
 // Explicit template instantiation
 template void igl::boundary_loop<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
 template void igl::boundary_loop<Eigen::Matrix<int, -1, -1, 0, -1, -1>, int>(Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, std::vector<std::vector<int, std::allocator<int> >, std::allocator<std::vector<int, std::allocator<int> > > >&);
+template void igl::boundary_loop<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1>, std::int64_t>(Eigen::MatrixBase<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> > const&, std::vector<std::vector<std::int64_t, std::allocator<std::int64_t> >, std::allocator<std::vector<std::int64_t, std::allocator<std::int64_t> > > >&);
 #endif
@@ -7,7 +7,9 @@
 // obtain one at http://mozilla.org/MPL/2.0/.
 
 #include "connected_components.h"
-#include <queue>
+#include "UnionFind.h"
+#include "parallel_for.h"
+#include <cassert>
 
 template < typename Atype, typename DerivedC, typename DerivedK>
 IGL_INLINE int igl::connected_components(
@@ -15,47 +17,48 @@ IGL_INLINE int igl::connected_components(
   Eigen::PlainObjectBase<DerivedC> & C,
   Eigen::PlainObjectBase<DerivedK> & K)
 {
-  typedef typename Eigen::SparseMatrix<Atype>::Index Index;
-  const auto m = A.rows();
+  typedef typename Eigen::SparseMatrix<Atype>::StorageIndex Index;
   assert(A.cols() == A.rows() && "A should be square");
-  // 1.1 sec
-  // m  means not yet visited
-  C.setConstant(m,1,m);
-  // Could use amortized dynamic array but didn't see real win.
-  K.setZero(m,1);
-  typename DerivedC::Scalar c = 0;
-  for(Eigen::Index f = 0;f<m;f++)
+  igl::UnionFind<Index> U(Index(A.rows()));
+  igl::parallel_for(A.outerSize(),[&](const Eigen::Index g)
   {
-    // already seen
-    if(C(f)<m) continue;
-    // start bfs
-    std::queue<Index> Q;
-    Q.push(f);
-    while(!Q.empty())
+    for(typename Eigen::SparseMatrix<Atype>::InnerIterator it (A,g); it; ++it)
     {
-      const Index g = Q.front();
-      Q.pop();
-      // already seen
-      if(C(g)<m) continue;
-      // see it
-      C(g) = c;
-      K(c)++;
-      for(typename Eigen::SparseMatrix<Atype>::InnerIterator it (A,g); it; ++it)
-      {
-        const Index n = it.index();
-        // already seen
-        if(C(n)<m) continue;
-        Q.push(n);
-      }
+      U.unite(Index(g),Index(it.index()));
     }
-    c++;
-  }
-  K.conservativeResize(c,1);
-  return c;
+  },1000ul);
+  return U.components(C,K);
+}
+
+template <
+  typename DerivedNI,
+  typename DerivedN,
+  typename DerivedC,
+  typename DerivedK>
+IGL_INLINE int igl::connected_components(
+  const Eigen::MatrixBase<DerivedNI> & NI,
+  const Eigen::MatrixBase<DerivedN> & N,
+  Eigen::PlainObjectBase<DerivedC> & C,
+  Eigen::PlainObjectBase<DerivedK> & K)
+{
+  typedef typename DerivedN::Scalar Index;
+  assert(NI.size() > 0 && "NI should have #n+1 entries");
+  const Index n = Index(NI.size()-1);
+  igl::UnionFind<Index> U(n);
+  igl::parallel_for(n,[&](const Index i)
+  {
+    for(Index j = NI(i);j<NI(i+1);j++)
+    {
+      U.unite(i,N(j));
+    }
+  },1000ul);
+  return U.components(C,K);
 }
 
 #ifdef IGL_STATIC_LIBRARY
 // Explicit template instantiation
 // generated by autoexplicit.sh
 template int igl::connected_components<int, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::SparseMatrix<int, 0, int> const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
+template int igl::connected_components<Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
+template int igl::connected_components<Eigen::Matrix<std::int64_t, -1, 1, 0, -1, 1>, Eigen::Matrix<std::int64_t, -1, 1, 0, -1, 1>, Eigen::Matrix<std::int64_t, -1, 1, 0, -1, 1>, Eigen::Matrix<std::int64_t, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<std::int64_t, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<std::int64_t, -1, 1, 0, -1, 1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<std::int64_t, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<std::int64_t, -1, 1, 0, -1, 1> >&);
 #endif
@@ -13,7 +13,9 @@
 namespace igl
 {
   // Determine the connected components of a graph described by the input
-  // adjacency matrix (similar to MATLAB's graphconncomp).
+  // adjacency matrix (similar to MATLAB's graphconncomp). Edges are merged in
+  // parallel with a lock-free union-find, components are numbered in order of
+  // their smallest node.
   //
   // Inputs:
   //    A  #A by #A adjacency matrix (treated as describing an undirected graph)
@@ -26,6 +28,26 @@ namespace igl
     const Eigen::SparseMatrix<Atype> & A,
     Eigen::PlainObjectBase<DerivedC> & C,
     Eigen::PlainObjectBase<DerivedK> & K);
+  // Inputs:
+  //    NI  #n+1 list of offsets into N (compressed sparse rows)
+  //    N  #NI(#n) list of neighbors, so that the neighbors of node i are
+  //      N(NI(i)),...,N(NI(i+1)-1) (treated as undirected)
+  // Outputs:
+  //    C  #n list of component indices into [0,#K-1]
+  //    K  #K list of sizes of each component
+  // Returns number of connected components
+  //
+  // See also: vertex_triangle_adjacency, UnionFind
+  template <
+    typename DerivedNI,
+    typename DerivedN,
+    typename DerivedC,
+    typename DerivedK>
+  IGL_INLINE int connected_components(
+    const Eigen::MatrixBase<DerivedNI> & NI,
+    const Eigen::MatrixBase<DerivedN> & N,
+    Eigen::PlainObjectBase<DerivedC> & C,
+    Eigen::PlainObjectBase<DerivedK> & K);
 }
 
 #ifndef IGL_STATIC_LIBRARY
@@ -6,6 +6,9 @@
 // v. 2.0. If a copy of the MPL was not distributed with this file, You can 
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "dijkstra.h"
+#include "parallel_for.h"
+#include <algorithm>
+#include <limits>
 
 template <typename IndexType, typename DerivedD, typename DerivedP>
 IGL_INLINE int igl::dijkstra(
@@ -129,10 +132,274 @@ IGL_INLINE int igl::dijkstra(
   return -1;
 }
 
+template <typename DerivedV, typename DerivedE, typename Scalar>
+IGL_INLINE void igl::dijkstra_graph(
+  const Eigen::MatrixBase<DerivedV> &V,
+  const Eigen::MatrixBase<DerivedE> &E,
+  DijkstraGraph<Scalar> &G)
+{
+  const int numV = V.rows();
+  G.C.setZero(numV+1);
+  for(int e = 0;e<E.rows();e++)
+  {
+    G.C(E(e,0)+1)++;
+    G.C(E(e,1)+1)++;
+  }
+  for(int i = 0;i<numV;i++)
+  {
+    G.C(i+1) += G.C(i);
+  }
+  G.N.resize(G.C(numV));
+  G.W.resize(G.C(numV));
+  Eigen::VectorXi next = G.C.head(numV);
+  for(int e = 0;e<E.rows();e++)
+  {
+    const int i = E(e,0);
+    const int j = E(e,1);
+    const Scalar l = (V.row(i)-V.row(j)).norm();
+    G.N(next(i)) = j;
+    G.W(next(i)++) = l;
+    G.N(next(j)) = i;
+    G.W(next(j)++) = l;
+  }
+}
+
+template <typename IndexType, typename Scalar>
+IGL_INLINE void igl::dijkstra_graph(
+  const std::vector<std::vector<IndexType> >& VV,
+  DijkstraGraph<Scalar> &G)
+{
+  const int numV = VV.size();
+  G.C.resize(numV+1);
+  G.C(0) = 0;
+  for(int i = 0;i<numV;i++)
+  {
+    G.C(i+1) = G.C(i) + VV[i].size();
+  }
+  G.N.resize(G.C(numV));
+  G.W.setOnes(G.C(numV));
+  for(int i = 0;i<numV;i++)
+  {
+    for(size_t k = 0;k<VV[i].size();k++)
+    {
+      G.N(G.C(i)+k) = VV[i][k];
+    }
+  }
+}
+
+template <typename Scalar, typename DerivedS, typename DerivedT>
+IGL_INLINE int igl::dijkstra(
+  const DijkstraGraph<Scalar> &G,
+  const Eigen::MatrixBase<DerivedS> &S,
+  const Eigen::MatrixBase<DerivedT> &T,
+  const Scalar max_distance,
+  DijkstraData<Scalar> &data)
+{
+  const Scalar inf = std::numeric_limits<Scalar>::infinity();
+  const int numV = G.C.size()-1;
+  auto & min_distance = data.min_distance;
+  auto & previous = data.previous;
+  auto & pos = data.pos;
+  auto & heap = data.heap;
+  if(min_distance.size() != numV)
+  {
+    min_distance.setConstant(numV,inf);
+    previous.setConstant(numV,-1);
+    pos.setConstant(numV,-1);
+    data.is_target.assign(numV,false);
+  }else
+  {
+    // Undo only what the previous query touched: settled vertices and
+    // whatever was left on its heap
+    for(const int v : data.visited)
+    {
+      min_distance(v) = inf;
+      previous(v) = -1;
+      pos(v) = -1;
+    }
+    for(const int v : heap)
+    {
+      min_distance(v) = inf;
+      previous(v) = -1;
+      pos(v) = -1;
+    }
+  }
+  data.visited.clear();
+  heap.clear();
+  for(Eigen::Index t = 0;t<T.size();t++)
+  {
+    data.is_target[T(t)] = true;
+  }
+  // Indexed 4-ary min heap keyed on min_distance: heap holds vertex indices,
+  // pos(v) is the position of v in heap. Compared to a std::set frontier
+  // this is two flat arrays and supports decrease-key without node
+  // allocation.
+  const int d = 4;
+  const auto sift_up = [&](int h)
+  {
+    const int v = heap[h];
+    while(h > 0)
+    {
+      const int p = (h-1)/d;
+      if(!(min_distance(v) < min_distance(heap[p])))
+      {
+        break;
+      }
+      heap[h] = heap[p];
+      pos(heap[h]) = h;
+      h = p;
+    }
+    heap[h] = v;
+    pos(v) = h;
+  };
+  const auto sift_down = [&](int h)
+  {
+    const int v = heap[h];
+    const int size = heap.size();
+    while(true)
+    {
+      const int first = d*h+1;
+      if(first >= size)
+      {
+        break;
+      }
+      int c = first;
+      const int last = std::min(first+d,size);
+      for(int k = first+1;k<last;k++)
+      {
+        if(min_distance(heap[k]) < min_distance(heap[c]))
+        {
+          c = k;
+        }
+      }
+      if(!(min_distance(heap[c]) < min_distance(v)))
+      {
+        break;
+      }
+      heap[h] = heap[c];
+      pos(heap[h]) = h;
+      h = c;
+    }
+    heap[h] = v;
+    pos(v) = h;
+  };
+
+  for(Eigen::Index s = 0;s<S.size();s++)
+  {
+    const int v = S(s);
+    if(pos(v) == -1)
+    {
+      min_distance(v) = 0;
+      heap.push_back(v);
+      sift_up(heap.size()-1);
+    }
+  }
+  int ret = -1;
+  while(!heap.empty())
+  {
+    // pop min
+    const int u = heap[0];
+    pos(u) = -2;
+    data.visited.push_back(u);
+    heap[0] = heap.back();
+    heap.pop_back();
+    if(!heap.empty())
+    {
+      sift_down(0);
+    }
+    if(data.is_target[u])
+    {
+      ret = u;
+      break;
+    }
+    const Scalar du = min_distance(u);
+    for(int k = G.C(u);k<G.C(u+1);k++)
+    {
+      const int v = G.N(k);
+      // already settled
+      if(pos(v) == -2)
+      {
+        continue;
+      }
+      const Scalar dv = du + G.W(k);
+      if(dv < min_distance(v) && dv <= max_distance)
+      {
+        min_distance(v) = dv;
+        previous(v) = u;
+        if(pos(v) == -1)
+        {
+          heap.push_back(v);
+          sift_up(heap.size()-1);
+        }else
+        {
+          sift_up(pos(v));
+        }
+      }
+    }
+  }
+  for(Eigen::Index t = 0;t<T.size();t++)
+  {
+    data.is_target[T(t)] = false;
+  }
+  return ret;
+}
+
+template <typename Scalar, typename DerivedS, typename DerivedT,
+typename DerivedD, typename DerivedP>
+IGL_INLINE int igl::dijkstra(
+  const DijkstraGraph<Scalar> &G,
+  const Eigen::MatrixBase<DerivedS> &S,
+  const Eigen::MatrixBase<DerivedT> &T,
+  const Scalar max_distance,
+  Eigen::PlainObjectBase<DerivedD> &min_distance,
+  Eigen::PlainObjectBase<DerivedP> &previous)
+{
+  DijkstraData<Scalar> data;
+  const int ret = dijkstra(G,S,T,max_distance,data);
+  min_distance = data.min_distance.template cast<typename DerivedD::Scalar>();
+  previous = data.previous.template cast<typename DerivedP::Scalar>();
+  return ret;
+}
+
+template <typename Scalar, typename DerivedS>
+IGL_INLINE void igl::dijkstra(
+  const DijkstraGraph<Scalar> &G,
+  const std::vector<DerivedS> &S,
+  const Scalar max_distance,
+  std::vector<Eigen::VectorXi> &I,
+  std::vector<Eigen::Matrix<Scalar,Eigen::Dynamic,1> > &D)
+{
+  I.resize(S.size());
+  D.resize(S.size());
+  // One workspace per thread, reset incrementally between its queries
+  std::vector<DijkstraData<Scalar> > data;
+  igl::parallel_for(
+    S.size(),
+    [&](const size_t nt){ data.resize(nt); },
+    [&](const int q, const size_t t)
+    {
+      dijkstra(G,S[q],Eigen::VectorXi(),max_distance,data[t]);
+      const std::vector<int> & visited = data[t].visited;
+      I[q] = Eigen::Map<const Eigen::VectorXi>(visited.data(),visited.size());
+      D[q].resize(visited.size());
+      for(size_t k = 0;k<visited.size();k++)
+      {
+        D[q](k) = data[t].min_distance(visited[k]);
+      }
+    },
+    [](const size_t){},
+    1);
+}
+
 #ifdef IGL_STATIC_LIBRARY
 // Explicit template instantiation
 template int igl::dijkstra<int, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(int const&, std::set<int, std::less<int>, std::allocator<int> > const&, std::vector<std::vector<int, std::allocator<int> >, std::allocator<std::vector<int, std::allocator<int> > > > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
 template int igl::dijkstra<int, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(int const&, std::set<int, std::less<int>, std::allocator<int> > const&, std::vector<std::vector<int, std::allocator<int> >, std::allocator<std::vector<int, std::allocator<int> > > > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
 template void igl::dijkstra<int, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(int const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, std::vector<int, std::allocator<int> >&);
 template int igl::dijkstra<int, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, std::vector<std::vector<int, std::allocator<int> >, std::allocator<std::vector<int, std::allocator<int> > > > const&, int const&, std::set<int, std::less<int>, std::allocator<int> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
+template void igl::dijkstra_graph<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, igl::DijkstraGraph<double>&);
+template void igl::dijkstra_graph<int, double>(std::vector<std::vector<int, std::allocator<int> >, std::allocator<std::vector<int, std::allocator<int> > > > const&, igl::DijkstraGraph<double>&);
+template int igl::dijkstra<double, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(igl::DijkstraGraph<double> const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, double, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
+template int igl::dijkstra<double, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(igl::DijkstraGraph<double> const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, double, igl::DijkstraData<double>&);
+template void igl::dijkstra<double, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(igl::DijkstraGraph<double> const&, std::vector<Eigen::Matrix<int, -1, 1, 0, -1, 1>, std::allocator<Eigen::Matrix<int, -1, 1, 0, -1, 1> > > const&, double, std::vector<Eigen::Matrix<int, -1, 1, 0, -1, 1>, std::allocator<Eigen::Matrix<int, -1, 1, 0, -1, 1> > >&, std::vector<Eigen::Matrix<double, -1, 1, 0, -1, 1>, std::allocator<Eigen::Matrix<double, -1, 1, 0, -1, 1> > >&);
 #endif
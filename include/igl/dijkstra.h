@@ -99,6 +99,148 @@ namespace igl {
     Eigen::PlainObjectBase<DerivedD> &min_distance,
     Eigen::PlainObjectBase<DerivedP> &previous);
 
+  // Compact CSR (compressed sparse row) representation of a weighted,
+  // directed graph.
+  template <typename Scalar>
+  struct DijkstraGraph
+  {
+    // #V+1 list of cumulative out-degrees so that the neighbors of vertex i
+    // are N(C(i)) through N(C(i+1)-1)
+    Eigen::VectorXi C;
+    // #C(#V) list of neighbor vertex indices
+    Eigen::VectorXi N;
+    // #C(#V) list of non-negative edge weights corresponding to N
+    Eigen::Matrix<Scalar,Eigen::Dynamic,1> W;
+  };
+
+  // Reusable state of the CSR Dijkstra below. Only the vertices touched by a
+  // query are reset by the next one, so a query bounded by max_distance
+  // costs time proportional to the part of the graph it visits rather than
+  // to #V.
+  template <typename Scalar>
+  struct DijkstraData
+  {
+    // #V list of minimum distances to the sources, only exact for settled
+    // vertices, infinity if not visited
+    Eigen::Matrix<Scalar,Eigen::Dynamic,1> min_distance;
+    // #V list of the previous visited vertices (for each vertex) - used for
+    // backtracking, -1 for sources and unvisited vertices
+    Eigen::VectorXi previous;
+    // list of vertices settled by the last query, in order of increasing
+    // distance
+    std::vector<int> visited;
+    // INTERNAL
+    // #V list of heap positions (-1 not reached, -2 settled)
+    Eigen::VectorXi pos;
+    // reached but unsettled vertices as an indexed 4-ary min heap
+    std::vector<int> heap;
+    std::vector<bool> is_target;
+  };
+
+  // Build a CSR graph from an undirected edge list, weighted by edge length.
+  //
+  // Inputs:
+  //   V                #V by dim list of vertex positions
+  //   E                #E by 2 list of undirected edge indices into V, e.g.
+  //                    as returned by igl::edges
+  //
+  // Output:
+  //   G                graph with 2*#E directed edges
+  //
+  template <typename DerivedV, typename DerivedE, typename Scalar>
+  IGL_INLINE void dijkstra_graph(
+    const Eigen::MatrixBase<DerivedV> &V,
+    const Eigen::MatrixBase<DerivedE> &E,
+    DijkstraGraph<Scalar> &G);
+
+  // Build a CSR graph with unit edge weights from an adjacency list.
+  //
+  // Inputs:
+  //   VV               #V list of lists of incident vertices (adjacency list), e.g.
+  //                    as returned by igl::adjacency_list
+  //
+  // Output:
+  //   G                graph with an edge i→j for each j in VV[i]
+  //
+  template <typename IndexType, typename Scalar>
+  IGL_INLINE void dijkstra_graph(
+    const std::vector<std::vector<IndexType> >& VV,
+    DijkstraGraph<Scalar> &G);
+
+  // Multi-source Dijkstra's algorithm on a CSR graph using an indexed 4-ary
+  // heap. The search stops as soon as any target is reached or all vertices
+  // within max_distance of the sources have been settled.
+  //
+  // Inputs:
+  //   G                graph (see dijkstra_graph)
+  //   S                #S list of source vertex indices (all at distance 0)
+  //   T                #T list of target vertex indices (may be empty)
+  //   max_distance     vertices farther than this from all sources are not
+  //                    visited (use std::numeric_limits<Scalar>::infinity()
+  //                    for no bound)
+  //
+  // Output:
+  //   min_distance     #V by 1 list of minimum distances to the sources, only
+  //                    exact for settled vertices, infinity if not visited
+  //   previous         #V by 1 list of the previous visited vertices (for each
+  //                    vertex) - used for backtracking, -1 for sources and
+  //                    unvisited vertices
+  //
+  // Returns the first target reached, or -1 if no target was reached.
+  //
+  template <typename Scalar, typename DerivedS, typename DerivedT,
+  typename DerivedD, typename DerivedP>
+  IGL_INLINE int dijkstra(
+    const DijkstraGraph<Scalar> &G,
+    const Eigen::MatrixBase<DerivedS> &S,
+    const Eigen::MatrixBase<DerivedT> &T,
+    const Scalar max_distance,
+    Eigen::PlainObjectBase<DerivedD> &min_distance,
+    Eigen::PlainObjectBase<DerivedP> &previous);
+
+  // Inputs:
+  //   G                graph (see dijkstra_graph)
+  //   S                #S list of source vertex indices (all at distance 0)
+  //   T                #T list of target vertex indices (may be empty)
+  //   max_distance     vertices farther than this from all sources are not
+  //                    visited
+  //   data             state of a previous query on G (or empty)
+  // Output:
+  //   data             min_distance, previous and visited of this query
+  //
+  // Returns the first target reached, or -1 if no target was reached.
+  //
+  template <typename Scalar, typename DerivedS, typename DerivedT>
+  IGL_INLINE int dijkstra(
+    const DijkstraGraph<Scalar> &G,
+    const Eigen::MatrixBase<DerivedS> &S,
+    const Eigen::MatrixBase<DerivedT> &T,
+    const Scalar max_distance,
+    DijkstraData<Scalar> &data);
+
+  // Batch of independent (bounded, multi-source) Dijkstra queries run in
+  // parallel. Results are returned per query and only list the visited
+  // vertices.
+  //
+  // Inputs:
+  //   G                graph (see dijkstra_graph)
+  //   S                #Q list of lists of source vertex indices
+  //   max_distance     vertices farther than this are not visited
+  //
+  // Output:
+  //   I                #Q list of lists of vertices within max_distance of
+  //                    S[q], in order of increasing distance
+  //   D                #Q list of lists of distances so that D[q](k) is the
+  //                    distance from I[q](k) to S[q]
+  //
+  template <typename Scalar, typename DerivedS>
+  IGL_INLINE void dijkstra(
+    const DijkstraGraph<Scalar> &G,
+    const std::vector<DerivedS> &S,
+    const Scalar max_distance,
+    std::vector<Eigen::VectorXi> &I,
+    std::vector<Eigen::Matrix<Scalar,Eigen::Dynamic,1> > &D);
+
 }
 
 #ifndef IGL_STATIC_LIBRARY
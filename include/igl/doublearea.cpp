@@ -7,11 +7,13 @@
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "doublearea.h"
 #include "edge_lengths.h"
+#include "face_geometry.h"
 #include "parallel_for.h"
 #include "sort.h"
 #include <cassert>
 #include <iostream>
 #include <limits>
+#include <cstdint>
 
 template <typename DerivedV, typename DerivedF, typename DeriveddblA>
 IGL_INLINE void igl::doublearea(
@@ -25,45 +27,15 @@ IGL_INLINE void igl::doublearea(
   const int dim = V.cols();
   // Only support triangles
   assert(F.cols() == 3);
-  const size_t m = F.rows();
   // Compute edge lengths
   Eigen::Matrix<typename DerivedV::Scalar, Eigen::Dynamic, 3> l;
-
-  // Projected area helper
-  const auto & proj_doublearea =
-    [&V,&F](const int x, const int y, const int f)
-    ->typename DerivedV::Scalar
-  {
-    auto rx = V(F(f,0),x)-V(F(f,2),x);
-    auto sx = V(F(f,1),x)-V(F(f,2),x);
-    auto ry = V(F(f,0),y)-V(F(f,2),y);
-    auto sy = V(F(f,1),y)-V(F(f,2),y);
-    return rx*sy - ry*sx;
-  };
-
   switch(dim)
   {
     case 3:
-    {
-      dblA = DeriveddblA::Zero(m,1);
-      for(size_t f = 0;f<m;f++)
-      {
-        for(int d = 0;d<3;d++)
-        {
-          const auto dblAd = proj_doublearea(d,(d+1)%3,f);
-          dblA(f) += dblAd*dblAd;
-        }
-      }
-      dblA = dblA.array().sqrt().eval();
-      break;
-    }
     case 2:
     {
-      dblA.resize(m,1);
-      for(size_t f = 0;f<m;f++)
-      {
-        dblA(f) = proj_doublearea(0,1,f);
-      }
+      // Signed if 2D
+      face_geometry(V,F,FACE_GEOMETRY_DOUBLEAREA,dblA,l,l,l,l);
       break;
     }
     default:
@@ -261,4 +233,5 @@ template void igl::doublearea<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::M
 template void igl::doublearea<Eigen::Matrix<double, -1, 3, 1, -1, 3>, Eigen::Matrix<int, -1, 3, 1, -1, 3>, Eigen::Matrix<double, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 1, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 1, -1, 3> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&);
 template Eigen::Matrix<double, -1, -1, 0, -1, -1>::Scalar igl::doublearea_single<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&);
 template Eigen::Matrix<double, 2, 1, 0, 2, 1>::Scalar igl::doublearea_single<Eigen::Matrix<double, 2, 1, 0, 2, 1>, Eigen::Matrix<double, 2, 1, 0, 2, 1>, Eigen::Matrix<double, 2, 1, 0, 2, 1> >(Eigen::MatrixBase<Eigen::Matrix<double, 2, 1, 0, 2, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, 2, 1, 0, 2, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, 2, 1, 0, 2, 1> > const&);
+template void igl::doublearea<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&);
 #endif
@@ -7,27 +7,37 @@
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "edge_flaps.h"
 #include "unique_edge_map.h"
+#include "parallel_for.h"
 #include <vector>
 #include <cassert>
+#include <cstdint>
 
+template <
+  typename DerivedF,
+  typename DeriveduE,
+  typename DerivedEMAP,
+  typename DerivedEF,
+  typename DerivedEI>
 IGL_INLINE void igl::edge_flaps(
-  const Eigen::MatrixXi & F,
-  const Eigen::MatrixXi & uE,
-  const Eigen::VectorXi & EMAP,
-  Eigen::MatrixXi & EF,
-  Eigen::MatrixXi & EI)
+  const Eigen::MatrixBase<DerivedF> & F,
+  const Eigen::MatrixBase<DeriveduE> & uE,
+  const Eigen::MatrixBase<DerivedEMAP> & EMAP,
+  Eigen::PlainObjectBase<DerivedEF> & EF,
+  Eigen::PlainObjectBase<DerivedEI> & EI)
 {
+  typedef Eigen::Index Index;
   // Initialize to boundary value
   EF.setConstant(uE.rows(),2,-1);
   EI.setConstant(uE.rows(),2,-1);
+  const Index m = F.rows();
   // loop over all faces
-  for(int f = 0;f<F.rows();f++)
+  for(Index f = 0;f<m;f++)
   {
     // loop over edges across from corners
     for(int v = 0;v<3;v++)
     {
       // get edge id
-      const int e = EMAP(v*F.rows()+f);
+      const Index e = EMAP(v*m+f);
       // See if this is left or right flap w.r.t. edge orientation
       if( F(f,(v+1)%3) == uE(e,0) && F(f,(v+2)%3) == uE(e,1))
       {
@@ -43,17 +53,66 @@ IGL_INLINE void igl::edge_flaps(
   }
 }
 
+template <
+  typename DerivedF,
+  typename DeriveduE,
+  typename DerivedEMAP,
+  typename DerivedEF,
+  typename DerivedEI>
 IGL_INLINE void igl::edge_flaps(
-  const Eigen::MatrixXi & F,
-  Eigen::MatrixXi & uE,
-  Eigen::VectorXi & EMAP,
-  Eigen::MatrixXi & EF,
-  Eigen::MatrixXi & EI)
+  const Eigen::MatrixBase<DerivedF> & F,
+  Eigen::PlainObjectBase<DeriveduE> & uE,
+  Eigen::PlainObjectBase<DerivedEMAP> & EMAP,
+  Eigen::PlainObjectBase<DerivedEF> & EF,
+  Eigen::PlainObjectBase<DerivedEI> & EI)
 {
-  Eigen::MatrixXi allE;
+  Eigen::Matrix<typename DeriveduE::Scalar,Eigen::Dynamic,Eigen::Dynamic> allE;
   igl::unique_edge_map(F,allE,uE,EMAP);
   // Const-ify to call overload
   const auto & cuE = uE;
   const auto & cEMAP = EMAP;
   return edge_flaps(F,cuE,cEMAP,EF,EI);
 }
+
+template <
+  typename Index,
+  typename DeriveduE,
+  typename DerivedEMAP,
+  typename DerivedEF,
+  typename DerivedEI>
+IGL_INLINE void igl::edge_flaps(
+  const HalfEdgeMesh<Index> & H,
+  Eigen::PlainObjectBase<DeriveduE> & uE,
+  Eigen::PlainObjectBase<DerivedEMAP> & EMAP,
+  Eigen::PlainObjectBase<DerivedEF> & EF,
+  Eigen::PlainObjectBase<DerivedEI> & EI)
+{
+  const Index m = H.num_faces();
+  uE.resize(H.num_edges(),2);
+  EF.resize(H.num_edges(),2);
+  EI.resize(H.num_edges(),2);
+  EMAP.resize(H.num_halfedges());
+  igl::parallel_for(H.num_halfedges(),[&](const Index h)
+  {
+    // Edge opposite corner v of face f
+    EMAP(H.corner(h)*m+H.face(h)) = H.edge(h);
+  },1000ul);
+  igl::parallel_for(H.num_edges(),[&](const Index e)
+  {
+    // Left flap is the representative half-edge
+    const Index h = H.edge_halfedges(e);
+    const Index t = H.twin(h);
+    uE.row(e) << H.origin(h), H.tip(h);
+    EF.row(e) << H.face(h), t < 0 ? -1 : H.face(t);
+    EI.row(e) << H.corner(h), t < 0 ? -1 : H.corner(t);
+  },1000ul);
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template void igl::edge_flaps<int, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(igl::HalfEdgeMesh<int> const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
+template void igl::edge_flaps<std::int64_t, Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1>, Eigen::Matrix<std::int64_t, -1, 1, 0, -1, 1>, Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1>, Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> >(igl::HalfEdgeMesh<std::int64_t> const&, Eigen::PlainObjectBase<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<std::int64_t, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> >&);
+template void igl::edge_flaps<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
+template void igl::edge_flaps<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1>, Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1>, Eigen::Matrix<std::int64_t, -1, 1, 0, -1, 1>, Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1>, Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<std::int64_t, -1, 1, 0, -1, 1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> >&);
+template void igl::edge_flaps<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1>, Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1>, Eigen::Matrix<std::int64_t, -1, 1, 0, -1, 1>, Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1>, Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<std::int64_t, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> >&);
+#endif
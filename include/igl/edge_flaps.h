@@ -9,6 +9,7 @@
 #ifndef IGL_EDGE_FLAPS_H
 #define IGL_EDGE_FLAPS_H
 #include "igl_inline.h"
+#include "HalfEdgeMesh.h"
 #include <Eigen/Core>
 namespace igl
 {
@@ -35,19 +36,48 @@ namespace igl
   // all( efE(sub2ind(size(efE),repmat(1:size(efE,1),2,1)',I)) == etEV )
   // all( efEF(sub2ind(size(efE),repmat(1:size(efE,1),2,1)',I)) == etEF )
   // all(efEMAP(sub2ind(size(F),repmat(1:size(F,1),3,1)',repmat([1 2 3],size(F,1),1))) == etFE(:,[2 3 1]))
+  template <
+    typename DerivedF,
+    typename DeriveduE,
+    typename DerivedEMAP,
+    typename DerivedEF,
+    typename DerivedEI>
   IGL_INLINE void edge_flaps(
-    const Eigen::MatrixXi & F,
-    const Eigen::MatrixXi & uE,
-    const Eigen::VectorXi & EMAP,
-    Eigen::MatrixXi & EF,
-    Eigen::MatrixXi & EI);
+    const Eigen::MatrixBase<DerivedF> & F,
+    const Eigen::MatrixBase<DeriveduE> & uE,
+    const Eigen::MatrixBase<DerivedEMAP> & EMAP,
+    Eigen::PlainObjectBase<DerivedEF> & EF,
+    Eigen::PlainObjectBase<DerivedEI> & EI);
   // Only faces as input
+  template <
+    typename DerivedF,
+    typename DeriveduE,
+    typename DerivedEMAP,
+    typename DerivedEF,
+    typename DerivedEI>
   IGL_INLINE void edge_flaps(
-    const Eigen::MatrixXi & F,
-    Eigen::MatrixXi & uE,
-    Eigen::VectorXi & EMAP,
-    Eigen::MatrixXi & EF,
-    Eigen::MatrixXi & EI);
+    const Eigen::MatrixBase<DerivedF> & F,
+    Eigen::PlainObjectBase<DeriveduE> & uE,
+    Eigen::PlainObjectBase<DerivedEMAP> & EMAP,
+    Eigen::PlainObjectBase<DerivedEF> & EF,
+    Eigen::PlainObjectBase<DerivedEI> & EI);
+  // Inputs:
+  //   H  half-edge connectivity of F
+  //
+  // Same uE, EMAP, EF and EI for edge-manifold meshes, non-manifold edges
+  // only get their first flap.
+  template <
+    typename Index,
+    typename DeriveduE,
+    typename DerivedEMAP,
+    typename DerivedEF,
+    typename DerivedEI>
+  IGL_INLINE void edge_flaps(
+    const HalfEdgeMesh<Index> & H,
+    Eigen::PlainObjectBase<DeriveduE> & uE,
+    Eigen::PlainObjectBase<DerivedEMAP> & EMAP,
+    Eigen::PlainObjectBase<DerivedEF> & EF,
+    Eigen::PlainObjectBase<DerivedEI> & EI);
 }
 #ifndef IGL_STATIC_LIBRARY
 #  include "edge_flaps.cpp"
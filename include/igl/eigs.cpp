@@ -7,10 +7,13 @@
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "eigs.h"
 
-#include "cotmatrix.h"
 #include "sort.h"
 #include "slice.h"
-#include "massmatrix.h"
+#include "parallel_for.h"
+#include "Timer.h"
+#include <Eigen/Eigenvalues>
+#include <Eigen/SparseCholesky>
+#include <algorithm>
 #include <iostream>
 
 template <
@@ -25,149 +28,331 @@ IGL_INLINE bool igl::eigs(
   const EigsType type,
   Eigen::PlainObjectBase<DerivedU> & sU,
   Eigen::PlainObjectBase<DerivedS> & sS)
+{
+  EigsData data;
+  return igl::eigs(A,iB,k,type,data,sU,sS);
+}
+
+template <
+  typename Atype,
+  typename Btype,
+  typename DerivedU,
+  typename DerivedS>
+IGL_INLINE bool igl::eigs(
+  const Eigen::SparseMatrix<Atype> & A,
+  const Eigen::SparseMatrix<Btype> & iB,
+  const size_t k,
+  const EigsType type,
+  EigsData & data,
+  Eigen::PlainObjectBase<DerivedU> & sU,
+  Eigen::PlainObjectBase<DerivedS> & sS)
 {
   using namespace Eigen;
   using namespace std;
-  const size_t n = A.rows();
+  typedef Atype Scalar;
+  typedef Eigen::Matrix<Scalar,Eigen::Dynamic,Eigen::Dynamic> MatrixXS;
+  typedef Eigen::Matrix<Scalar,Eigen::Dynamic,1> VectorXS;
+  typedef std::vector<const MatrixXS *> Blocks;
+  const Eigen::Index n = A.rows();
   assert(A.cols() == n && "A should be square.");
   assert(iB.rows() == n && "B should be match A's dims.");
   assert(iB.cols() == n && "B should be square.");
   assert(type == EIGS_TYPE_SM && "Only low frequencies are supported");
-  DerivedU U(n,k);
-  DerivedS S(k,1);
-  typedef Atype Scalar;
-  typedef Eigen::Matrix<typename DerivedU::Scalar,DerivedU::RowsAtCompileTime,1> VectorXS;
+  data.iterations = 0;
+  data.converged.clear();
+  data.factorization_time = 0;
+  data.solve_time = 0;
+  if(type != EIGS_TYPE_SM || k == 0 || Eigen::Index(k) > n)
+  {
+    return false;
+  }
+  // Block size: wanted pairs plus guard vectors
+  const Eigen::Index m = std::min<Eigen::Index>(n,
+    k + (data.guard<0 ? std::max<Eigen::Index>(k/4,4) : data.guard));
   // Rescale B for better numerics
   const Scalar rescale = std::abs(iB.diagonal().maxCoeff());
-  const Eigen::SparseMatrix<Btype> B = iB/rescale;
-
-  Scalar tol = 1e-4;
-  Scalar conv = 1e-14;
-  int max_iter = 100;
-  int i = 0;
-  //std::cout<<"start"<<std::endl;
-  while(true)
+  const SparseMatrix<Scalar> B = iB.template cast<Scalar>()/rescale;
+  const auto norm1 = [](const SparseMatrix<Scalar> & M)->Scalar
   {
-    //std::cout<<i<<std::endl;
-    // Random initial guess
-    VectorXS y = VectorXS::Random(n,1);
-    Scalar eff_sigma = 0;
-    if(i>0)
+    Scalar ret = 0;
+    for(int j = 0;j<M.outerSize();j++)
     {
-      eff_sigma = 1e-8+std::abs(S(i-1));
-    }
-    // whether to use rayleigh quotient method
-    bool ray = false;
-    Scalar err = std::numeric_limits<Scalar>::infinity();
-    int iter;
-    Scalar sigma = std::numeric_limits<Scalar>::infinity();
-    VectorXS x;
-    for(iter = 0;iter<max_iter;iter++)
-    {
-      if(i>0 && !ray)
-      {
-        // project-out existing modes
-        for(int j = 0;j<i;j++)
-        {
-          const VectorXS u = U.col(j);
-          y = (y - u*u.dot(B*y)/u.dot(B * u)).eval();
-        }
-      }
-      // normalize
-      x = y/sqrt(y.dot(B*y));
-
-      // current guess at eigen value
-      sigma = x.dot(A*x)/x.dot(B*x);
-      //x *= sigma>0?1.:-1.;
-
-      Scalar err_prev = err;
-      err = (A*x-sigma*B*x).array().abs().maxCoeff();
-      if(err<conv)
-      {
-        break;
-      }
-      if(ray || err<tol)
+      Scalar c = 0;
+      for(typename SparseMatrix<Scalar>::InnerIterator it(M,j);it;++it)
       {
-        eff_sigma = sigma;
-        ray = true;
+        c += std::abs(it.value());
       }
+      ret = std::max(ret,c);
+    }
+    return ret;
+  };
+  const Scalar normA = norm1(A);
+  const Scalar normB = norm1(B);
 
-      Scalar tikhonov = std::abs(eff_sigma)<1e-12?1e-10:0;
-      switch(type)
+  // Parallel block operations. Dense products are split into contiguous row
+  // chunks, sparse products and solves are split by columns.
+  const Eigen::Index chunk = 2048;
+  const Eigen::Index num_chunks = (n+chunk-1)/chunk;
+  // Y = M * X
+  const auto spmm = [](const SparseMatrix<Scalar> & M, const MatrixXS & X)
+  {
+    MatrixXS Y(M.rows(),X.cols());
+    igl::parallel_for(X.cols(),[&](const int j)
+    {
+      Y.col(j) = M*X.col(j);
+    },2);
+    return Y;
+  };
+  // G = [L₀ L₁ …]ᵀ [R₀ R₁ …]
+  const auto gram = [&](const Blocks & L, const Blocks & R)
+  {
+    Eigen::Index rows = 0, cols = 0;
+    for(const auto & Li : L){ rows += Li->cols(); }
+    for(const auto & Rj : R){ cols += Rj->cols(); }
+    std::vector<MatrixXS> Gt;
+    MatrixXS G = MatrixXS::Zero(rows,cols);
+    igl::parallel_for(
+      num_chunks,
+      [&](const size_t nt){ Gt.assign(nt,MatrixXS::Zero(rows,cols)); },
+      [&](const int c, const size_t t)
       {
-        default:
-          assert(false && "Not supported");
-          break;
-        case EIGS_TYPE_SM:
+        const Eigen::Index s = c*chunk;
+        const Eigen::Index len = std::min(chunk,n-s);
+        Eigen::Index ri = 0;
+        for(const auto & Li : L)
         {
-          SimplicialLDLT<SparseMatrix<Scalar> > solver;
-          const SparseMatrix<Scalar> C = A-eff_sigma*B+tikhonov*B;
-          //mw.save(C,"C");
-          //mw.save(eff_sigma,"eff_sigma");
-          //mw.save(tikhonov,"tikhonov");
-          solver.compute(C);
-          switch(solver.info())
+          Eigen::Index cj = 0;
+          for(const auto & Rj : R)
           {
-            case Eigen::Success:
-              break;
-            case Eigen::NumericalIssue:
-              cerr<<"Error: Numerical issue."<<endl;
-              return false;
-            default:
-              cerr<<"Error: Other."<<endl;
-              return false;
+            Gt[t].block(ri,cj,Li->cols(),Rj->cols()).noalias() +=
+              Li->middleRows(s,len).transpose() * Rj->middleRows(s,len);
+            cj += Rj->cols();
           }
-          const VectorXS rhs = B*x;
-          y = solver.solve(rhs);
-          //mw.save(rhs,"rhs");
-          //mw.save(y,"y");
-          //mw.save(x,"x");
-          //mw.write("eigs.mat");
-          //if(i == 1)
-          //return false;
-          break;
+          ri += Li->cols();
         }
+      },
+      [&](const size_t t){ G += Gt[t]; },
+      2);
+    return G;
+  };
+  // X = [L₀ L₁ …] Z
+  const auto combine = [&](const Blocks & L, const MatrixXS & Z)
+  {
+    MatrixXS X(n,Z.cols());
+    igl::parallel_for(num_chunks,[&](const int c)
+    {
+      const Eigen::Index s = c*chunk;
+      const Eigen::Index len = std::min(chunk,n-s);
+      X.middleRows(s,len).setZero();
+      Eigen::Index ri = 0;
+      for(const auto & Li : L)
+      {
+        X.middleRows(s,len).noalias() +=
+          Li->middleRows(s,len) * Z.middleRows(ri,Li->cols());
+        ri += Li->cols();
       }
+    },2);
+    return X;
+  };
+
+  igl::Timer timer;
+  timer.start();
+  // Factor the shifted matrix once, used as preconditioner for all iterations
+  SimplicialLDLT<SparseMatrix<Scalar> > solver;
+  {
+    const Scalar tikhonov = std::abs(data.sigma)<1e-12?1e-10:0;
+    const SparseMatrix<Scalar> C = A-(Scalar(data.sigma)-tikhonov)*B;
+    solver.compute(C);
+    switch(solver.info())
+    {
+      case Eigen::Success:
+        break;
+      case Eigen::NumericalIssue:
+        cerr<<"Error: Numerical issue."<<endl;
+        return false;
+      default:
+        cerr<<"Error: Other."<<endl;
+        return false;
+    }
+  }
+  data.factorization_time = timer.getElapsedTimeInSec();
+  timer.start();
+  // W = (A - σ B)⁻¹ R
+  const auto precondition = [&](const MatrixXS & R)
+  {
+    MatrixXS W(n,R.cols());
+    igl::parallel_for(R.cols(),[&](const int j)
+    {
+      const VectorXS rj = R.col(j);
+      W.col(j) = solver.solve(rj);
+    },2);
+    return W;
+  };
+  // Rayleigh-Ritz on span(S) given A S and B S. Columns of S are rescaled and
+  // (nearly) linearly dependent directions dropped before solving the
+  // projected problem. Outputs the m lowest Ritz values and coefficients Z so
+  // that S Z are the Ritz vectors. Returns false if span(S) is too small.
+  const auto rayleigh_ritz = [&](
+    const Blocks & S, const Blocks & AS, const Blocks & BS,
+    VectorXS & lambda, MatrixXS & Z)->bool
+  {
+    MatrixXS G = gram(S,BS);
+    MatrixXS H = gram(S,AS);
+    G = (0.5*(G+G.transpose())).eval();
+    H = (0.5*(H+H.transpose())).eval();
+    const VectorXS d = G.diagonal().cwiseMax(0).cwiseSqrt();
+    const VectorXS dinv = (d.array()>0).select(d.cwiseInverse(),0);
+    const MatrixXS Gs = dinv.asDiagonal()*G*dinv.asDiagonal();
+    SelfAdjointEigenSolver<MatrixXS> geig(Gs);
+    const VectorXS & ge = geig.eigenvalues();
+    const Eigen::Index kept = (ge.array() > 1e-10*ge.maxCoeff()).count();
+    if(kept < m)
+    {
+      return false;
     }
-    if(iter == max_iter)
+    const MatrixXS T =
+      dinv.asDiagonal() * geig.eigenvectors().rightCols(kept) *
+      ge.tail(kept).cwiseSqrt().cwiseInverse().asDiagonal();
+    const MatrixXS Hr = T.transpose()*H*T;
+    MatrixXS Gr = T.transpose()*G*T;
+    Gr = (0.5*(Gr+Gr.transpose())).eval();
+    GeneralizedSelfAdjointEigenSolver<MatrixXS> heig(
+      (0.5*(Hr+Hr.transpose())).eval(),Gr);
+    if(heig.info() != Eigen::Success)
     {
-      cerr<<"Failed to converge."<<endl;
       return false;
     }
-    if(
-      i==0 ||
-      (S.head(i).array()-sigma).abs().maxCoeff()>1e-14 ||
-      ((U.leftCols(i).transpose()*B*x).array().abs()<=1e-7).all()
-      )
-    {
-      //cout<<"Found "<<i<<"th mode"<<endl;
-      U.col(i) = x;
-      S(i) = sigma;
-      i++;
-      if(i == k)
+    lambda = heig.eigenvalues().head(m);
+    Z = T*heig.eigenvectors().leftCols(m);
+    return true;
+  };
+
+  // Random initial block (a shift-invert step here would collapse onto the
+  // eigen vectors nearest σ when A - σ B is nearly singular)
+  MatrixXS X = MatrixXS::Random(n,m);
+  MatrixXS AX = spmm(A,X);
+  MatrixXS BX = spmm(B,X);
+  VectorXS lambda;
+  MatrixXS Z;
+  if(!rayleigh_ritz({&X},{&AX},{&BX},lambda,Z))
+  {
+    cerr<<"Error: Rank deficient initial guess."<<endl;
+    return false;
+  }
+  X = combine({&X},Z);
+  AX = spmm(A,X);
+  BX = spmm(B,X);
+  // Search directions (one per Ritz vector) and their products
+  MatrixXS P,AP,BP;
+  VectorXS res(m);
+  bool done = false;
+  while(true)
+  {
+    const MatrixXS R = AX - BX*lambda.asDiagonal();
+    for(Eigen::Index j = 0;j<m;j++)
+    {
+      res(j) = R.col(j).norm()/
+        ((normA+std::abs(lambda(j))*normB)*X.col(j).norm());
+    }
+    const int num_converged = (res.head(k).array()<data.tolerance).count();
+    data.converged.push_back(num_converged);
+    if(num_converged == int(k))
+    {
+      done = true;
+      break;
+    }
+    if(data.iterations == data.max_iter)
+    {
+      break;
+    }
+    data.iterations++;
+    // Only iterate on pairs that haven't converged (soft locking)
+    std::vector<Eigen::Index> active;
+    for(Eigen::Index j = 0;j<m;j++)
+    {
+      if(res(j) >= data.tolerance)
+      {
+        active.push_back(j);
+      }
+    }
+    const Eigen::Index na = active.size();
+    const auto gather = [&](const MatrixXS & M)
+    {
+      MatrixXS Ma(n,na);
+      igl::parallel_for(na,[&](const int a){ Ma.col(a) = M.col(active[a]); },2);
+      return Ma;
+    };
+    MatrixXS W = precondition(gather(R));
+    // B-orthogonalize against X (twice is enough). Otherwise a nearly singular
+    // A - σ B swamps W with the eigen vectors nearest σ.
+    for(int pass = 0;pass<2;pass++)
+    {
+      W -= combine({&X},gram({&BX},{&W}));
+    }
+    const MatrixXS AW = spmm(A,W);
+    const MatrixXS BW = spmm(B,W);
+    MatrixXS Pa,APa,BPa;
+    if(P.size() > 0)
+    {
+      Pa = gather(P);
+      APa = gather(AP);
+      BPa = gather(BP);
+    }
+    Blocks S = {&X,&W}, AS = {&AX,&AW}, BS = {&BX,&BW};
+    Blocks Sd = {&W}, ASd = {&AW}, BSd = {&BW};
+    if(Pa.size() > 0)
+    {
+      S.push_back(&Pa); AS.push_back(&APa); BS.push_back(&BPa);
+      Sd.push_back(&Pa); ASd.push_back(&APa); BSd.push_back(&BPa);
+    }
+    if(!rayleigh_ritz(S,AS,BS,lambda,Z))
+    {
+      // Search directions became dependent: restart without them
+      S.resize(2); AS.resize(2); BS.resize(2);
+      Sd.resize(1); ASd.resize(1); BSd.resize(1);
+      if(!rayleigh_ritz(S,AS,BS,lambda,Z))
       {
         break;
       }
-    }else
-    {
-      //std::cout<<"i: "<<i<<std::endl;
-      //std::cout<<"  "<<S.head(i).transpose()<<" << "<<sigma<<std::endl;
-      //std::cout<<"  "<<(S.head(i).array()-sigma).abs().maxCoeff()<<std::endl;
-      //std::cout<<"  "<<(U.leftCols(i).transpose()*B*x).array().abs().transpose()<<std::endl;
-      // restart with new random guess.
-      cout<<"igl::eigs RESTART"<<endl;
     }
+    // New search directions: update of X outside of span(X)
+    const MatrixXS Zd = Z.bottomRows(Z.rows()-m);
+    P = combine(Sd,Zd);
+    AP = combine(ASd,Zd);
+    BP = combine(BSd,Zd);
+    X = combine(S,Z);
+    AX = spmm(A,X);
+    BX = spmm(B,X);
+  }
+  data.solve_time = timer.getElapsedTimeInSec();
+
+  DerivedU U = X.leftCols(k);
+  DerivedS S = lambda.head(k);
+  // unit B-norm
+  for(Eigen::Index j = 0;j<Eigen::Index(k);j++)
+  {
+    U.col(j) /= std::sqrt(X.col(j).dot(BX.col(j)));
   }
   // finally sort
   VectorXi I;
   igl::sort(S,1,false,sS,I);
   igl::slice(U,I,2,sU);
+  data.residual.resize(k);
+  for(Eigen::Index j = 0;j<Eigen::Index(k);j++)
+  {
+    data.residual(j) = res(I(j));
+  }
   sS /= rescale;
   sU /= sqrt(rescale);
-  return true;
+  if(!done)
+  {
+    cerr<<"Failed to converge."<<endl;
+  }
+  return done;
 }
 
 #ifdef IGL_STATIC_LIBRARY
 // Explicit template instantiation
 template bool igl::eigs<double, double, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1> >(Eigen::SparseMatrix<double, 0, int> const&, Eigen::SparseMatrix<double, 0, int> const&, const size_t, igl::EigsType, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&);
+template bool igl::eigs<double, double, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1> >(Eigen::SparseMatrix<double, 0, int> const&, Eigen::SparseMatrix<double, 0, int> const&, const size_t, igl::EigsType, igl::EigsData&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&);
 #endif
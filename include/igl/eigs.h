@@ -10,6 +10,7 @@
 #include "igl_inline.h"
 #include <Eigen/Core>
 #include <Eigen/Sparse>
+#include <vector>
 
 namespace igl
 {
@@ -20,8 +21,9 @@ namespace igl
   //
   // Solutions are approximate and sorted. 
   //
-  // Ideally one should use ARPACK and the Eigen unsupported ARPACK module.
-  // This implementation does simple, naive power iterations.
+  // This implementation runs a block LOBPCG iteration preconditioned with a
+  // single sparse factorization of the shifted matrix A - σ B (i.e., a
+  // shift-invert preconditioner), see the overload taking EigsData below.
   //
   // Inputs:
   //   A  #A by #A symmetric matrix
@@ -41,6 +43,51 @@ namespace igl
     EIGS_TYPE_LM = 1,
     NUM_EIGS_TYPES = 2
   };
+  // Options and convergence/timing report of the block eigen solver
+  struct EigsData
+  {
+    // Shift σ of the preconditioner A - σ B. Should lie below the wanted part
+    // of the spectrum (relative to B rescaled to have unit max diagonal). If
+    // |σ| is (nearly) zero a tiny multiple of B is added to regularize a
+    // singular A (e.g., a cotangent Laplacian).
+    double sigma = 0;
+    // Stop once every wanted pair satisfies
+    //   ‖A u - s B u‖ / ((‖A‖₁ + |s| ‖B‖₁) ‖u‖) < tolerance
+    double tolerance = 1e-10;
+    // Maximum number of block iterations
+    int max_iter = 500;
+    // Number of additional "guard" vectors iterated along with the k wanted
+    // ones (speeds up convergence of the last wanted pairs), -1 picks
+    // max(k/4,4)
+    int guard = -1;
+    // Outputs:
+    // Number of block iterations performed
+    int iterations = 0;
+    // k list of final relative residuals (same order as sS)
+    Eigen::VectorXd residual;
+    // Number of converged wanted pairs after each iteration
+    std::vector<int> converged;
+    // Seconds spent factorizing A - σ B, and in the iterations
+    double factorization_time = 0;
+    double solve_time = 0;
+  };
+  template <
+    typename Atype,
+    typename Btype,
+    typename DerivedU,
+    typename DerivedS>
+  IGL_INLINE bool eigs(
+    const Eigen::SparseMatrix<Atype> & A,
+    const Eigen::SparseMatrix<Btype> & B,
+    const size_t k,
+    const EigsType type,
+    Eigen::PlainObjectBase<DerivedU> & sU,
+    Eigen::PlainObjectBase<DerivedS> & sS);
+  // Inputs:
+  //   data  solver options (see EigsData)
+  // Outputs:
+  //   data  convergence and timing report
+  // Returns true iff all k wanted pairs converged
   template <
     typename Atype,
     typename Btype,
@@ -51,6 +98,7 @@ namespace igl
     const Eigen::SparseMatrix<Btype> & B,
     const size_t k,
     const EigsType type,
+    EigsData & data,
     Eigen::PlainObjectBase<DerivedU> & sU,
     Eigen::PlainObjectBase<DerivedS> & sS);
 }
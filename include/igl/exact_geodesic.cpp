@@ -7,6 +7,7 @@
 // obtain one at http://mozilla.org/MPL/2.0/.
 
 #include "exact_geodesic.h"
+#include "parallel_for.h"
 
 //Copyright (C) 2008 Danil Kirsanov, MIT License
 //Code from https://code.google.com/archive/p/geodesic/
@@ -20,6 +21,7 @@
 #include <ctime>
 #include <fstream>
 #include <iostream>
+#include <limits>
 #include <set>
 #include <vector>
 #include <memory>
@@ -3170,9 +3172,20 @@ IGL_INLINE void igl::exact_geodesic(
   const Eigen::MatrixBase<DerivedVT> &VT,
   const Eigen::MatrixBase<DerivedFT> &FT,
   Eigen::PlainObjectBase<DerivedD> &D)
+{
+  ExactGeodesicData data;
+  exact_geodesic_precompute(V,F,data);
+  exact_geodesic_solve(
+    data,VS,FS,VT,FT,std::numeric_limits<double>::infinity(),D);
+}
+
+template <typename DerivedV, typename DerivedF>
+IGL_INLINE void igl::exact_geodesic_precompute(
+  const Eigen::MatrixBase<DerivedV> &V,
+  const Eigen::MatrixBase<DerivedF> &F,
+  ExactGeodesicData & data)
 {
   assert(V.cols() == 3 && F.cols() == 3 && "Only support 3D triangle mesh");
-  assert(VS.cols() <=1 && FS.cols() <= 1 && VT.cols() <= 1 && FT.cols() <=1 && "Only support one dimensional inputs");
   std::vector<typename DerivedV::Scalar> points(V.rows() * V.cols());
   std::vector<typename DerivedF::Scalar> faces(F.rows() * F.cols());
   for (int i = 0; i < points.size(); i++)
@@ -3183,42 +3196,137 @@ IGL_INLINE void igl::exact_geodesic(
   {
     faces[i] = F(i / 3, i % 3);
   }
+  data.mesh = std::make_shared<igl::geodesic::Mesh>();
+  data.mesh->initialize_mesh_data(points, faces);
+}
 
-  igl::geodesic::Mesh mesh;
-  mesh.initialize_mesh_data(points, faces);
+namespace igl
+{
+  namespace geodesic
+  {
+    // Propagate from sources and read off distances at targets, distances
+    // beyond max_distance are set to infinity
+    template <typename DerivedD>
+    inline void exact_geodesic_distances(
+      GeodesicAlgorithmExact & algorithm,
+      std::vector<SurfacePoint> & source,
+      std::vector<SurfacePoint> & target,
+      const double max_distance,
+      Eigen::PlainObjectBase<DerivedD> & D,
+      const int col)
+    {
+      algorithm.propagate(
+        source,std::isinf(max_distance) ? GEODESIC_INF : max_distance);
+      for (int i = 0; i < target.size(); i++)
+      {
+        double d;
+        algorithm.best_source(target[i], d);
+        D(i,col) = d > max_distance || d >= GEODESIC_INF ?
+          std::numeric_limits<typename DerivedD::Scalar>::infinity() : d;
+      }
+    }
+    template <typename DerivedVT, typename DerivedFT>
+    inline std::vector<SurfacePoint> exact_geodesic_targets(
+      Mesh & mesh,
+      const Eigen::MatrixBase<DerivedVT> &VT,
+      const Eigen::MatrixBase<DerivedFT> &FT)
+    {
+      std::vector<SurfacePoint> target(VT.rows() + FT.rows());
+      for (int i = 0; i < VT.rows(); i++)
+      {
+        target[i] = SurfacePoint(&mesh.vertices()[VT(i, 0)]);
+      }
+      for (int i = 0; i < FT.rows(); i++)
+      {
+        target[VT.rows() + i] = SurfacePoint(&mesh.faces()[FT(i, 0)]);
+      }
+      return target;
+    }
+  }
+}
+
+template <
+  typename DerivedVS,
+  typename DerivedFS,
+  typename DerivedVT,
+  typename DerivedFT,
+  typename DerivedD>
+IGL_INLINE void igl::exact_geodesic_solve(
+  const ExactGeodesicData & data,
+  const Eigen::MatrixBase<DerivedVS> &VS,
+  const Eigen::MatrixBase<DerivedFS> &FS,
+  const Eigen::MatrixBase<DerivedVT> &VT,
+  const Eigen::MatrixBase<DerivedFT> &FT,
+  const double max_distance,
+  Eigen::PlainObjectBase<DerivedD> &D)
+{
+  assert(data.mesh && "Call exact_geodesic_precompute first");
+  assert(VS.cols() <=1 && FS.cols() <= 1 && VT.cols() <= 1 && FT.cols() <=1 && "Only support one dimensional inputs");
+  igl::geodesic::Mesh & mesh = *data.mesh;
   igl::geodesic::GeodesicAlgorithmExact exact_algorithm(&mesh);
 
   std::vector<igl::geodesic::SurfacePoint> source(VS.rows() + FS.rows());
-  std::vector<igl::geodesic::SurfacePoint> target(VT.rows() + FT.rows());
   for (int i = 0; i < VS.rows(); i++)
   {
     source[i] = (igl::geodesic::SurfacePoint(&mesh.vertices()[VS(i, 0)]));
   }
   for (int i = 0; i < FS.rows(); i++)
   {
-    source[i] = (igl::geodesic::SurfacePoint(&mesh.faces()[FS(i, 0)]));
-  }
-
-  for (int i = 0; i < VT.rows(); i++)
-  {
-    target[i] = (igl::geodesic::SurfacePoint(&mesh.vertices()[VT(i, 0)]));
-  }
-  for (int i = 0; i < FT.rows(); i++)
-  {
-    target[i] = (igl::geodesic::SurfacePoint(&mesh.faces()[FT(i, 0)]));
+    source[VS.rows() + i] =
+      (igl::geodesic::SurfacePoint(&mesh.faces()[FS(i, 0)]));
   }
-
-  exact_algorithm.propagate(source);
-  std::vector<igl::geodesic::SurfacePoint> path;
+  std::vector<igl::geodesic::SurfacePoint> target =
+    igl::geodesic::exact_geodesic_targets(mesh,VT,FT);
   D.resize(target.size(), 1);
-  for (int i = 0; i < target.size(); i++)
-  {
-    exact_algorithm.trace_back(target[i], path);
-    D(i) = igl::geodesic::length(path);
-  }
+  igl::geodesic::exact_geodesic_distances(
+    exact_algorithm,source,target,max_distance,D,0);
+}
+
+template <
+  typename DerivedS,
+  typename DerivedVT,
+  typename DerivedFT,
+  typename DerivedD>
+IGL_INLINE void igl::exact_geodesic_solve(
+  const ExactGeodesicData & data,
+  const Eigen::MatrixBase<DerivedS> &S,
+  const Eigen::MatrixBase<DerivedVT> &VT,
+  const Eigen::MatrixBase<DerivedFT> &FT,
+  const double max_distance,
+  Eigen::PlainObjectBase<DerivedD> &D)
+{
+  assert(data.mesh && "Call exact_geodesic_precompute first");
+  assert(VT.cols() <= 1 && FT.cols() <=1 && "Only support one dimensional inputs");
+  igl::geodesic::Mesh & mesh = *data.mesh;
+  const std::vector<igl::geodesic::SurfacePoint> target =
+    igl::geodesic::exact_geodesic_targets(mesh,VT,FT);
+  D.resize(target.size(), S.size());
+  // Propagation state (interval lists and pools) is O(#E): keep one per
+  // thread and reuse it across that thread's queries
+  std::vector<std::unique_ptr<igl::geodesic::GeodesicAlgorithmExact> > algorithms;
+  igl::parallel_for(
+    S.size(),
+    [&](const size_t nt){ algorithms.resize(nt); },
+    [&](const int s, const size_t t)
+    {
+      if(!algorithms[t])
+      {
+        algorithms[t].reset(new igl::geodesic::GeodesicAlgorithmExact(&mesh));
+      }
+      std::vector<igl::geodesic::SurfacePoint> source(
+        1,igl::geodesic::SurfacePoint(&mesh.vertices()[S(s)]));
+      std::vector<igl::geodesic::SurfacePoint> target_s = target;
+      igl::geodesic::exact_geodesic_distances(
+        *algorithms[t],source,target_s,max_distance,D,s);
+    },
+    [](const size_t){},
+    2);
 }
 
 #ifdef IGL_STATIC_LIBRARY
+template void igl::exact_geodesic_precompute<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, igl::ExactGeodesicData&);
+template void igl::exact_geodesic_solve<Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1> >(igl::ExactGeodesicData const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, double, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&);
+template void igl::exact_geodesic_solve<Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(igl::ExactGeodesicData const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, double, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
 template void igl::exact_geodesic<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>>(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1>> const &, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1>> const &, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1>> const &, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1>> const &, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1>> const &, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1>> const &, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1>> &);
 template void igl::exact_geodesic<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
 #endif
@@ -11,9 +11,20 @@
 
 #include "igl_inline.h"
 #include <Eigen/Core>
+#include <memory>
 
 namespace igl 
 {
+  namespace geodesic
+  {
+    class Mesh;
+  }
+  // Mesh data structure shared by repeated exact geodesic queries (see
+  // exact_geodesic_precompute, exact_geodesic_solve)
+  struct ExactGeodesicData
+  {
+    std::shared_ptr<geodesic::Mesh> mesh;
+  };
   // Exact geodesic algorithm for triangular mesh with the implementation from https://code.google.com/archive/p/geodesic/, 
   // and the algorithm first described by Mitchell, Mount and Papadimitriou in 1987
   //
@@ -46,6 +57,71 @@ namespace igl
       const Eigen::MatrixBase<DerivedVT> &VT,
       const Eigen::MatrixBase<DerivedFT> &FT,
       Eigen::PlainObjectBase<DerivedD> &D);
+  // Build the mesh data structure once for repeated calls to
+  // exact_geodesic_solve.
+  //
+  // Inputs:
+  //   V  #V by 3 list of 3D vertex positions
+  //   F  #F by 3 list of mesh faces
+  // Outputs:
+  //   data  precomputed mesh
+  template <typename DerivedV, typename DerivedF>
+  IGL_INLINE void exact_geodesic_precompute(
+    const Eigen::MatrixBase<DerivedV> &V,
+    const Eigen::MatrixBase<DerivedF> &F,
+    ExactGeodesicData & data);
+  // Exact geodesic distances from one set of sources (see exact_geodesic).
+  // Propagation stops once all windows are farther than max_distance from
+  // the sources. Targets beyond max_distance are assigned infinity.
+  //
+  // Inputs:
+  //   data  precomputed mesh (see exact_geodesic_precompute)
+  //   VS #VS by 1 vector specifying indices of source vertices
+  //   FS #FS by 1 vector specifying indices of source faces
+  //   VT #VT by 1 vector specifying indices of target vertices
+  //   FT #FT by 1 vector specifying indices of target faces
+  //   max_distance  propagation cutoff (use infinity for none)
+  // Output:
+  //   D  #VT+#FT by 1 vector of geodesic distances of each target w.r.t. the
+  //     nearest one in the source set
+  template <
+    typename DerivedVS,
+    typename DerivedFS,
+    typename DerivedVT,
+    typename DerivedFT,
+    typename DerivedD>
+  IGL_INLINE void exact_geodesic_solve(
+    const ExactGeodesicData & data,
+    const Eigen::MatrixBase<DerivedVS> &VS,
+    const Eigen::MatrixBase<DerivedFS> &FS,
+    const Eigen::MatrixBase<DerivedVT> &VT,
+    const Eigen::MatrixBase<DerivedFT> &FT,
+    const double max_distance,
+    Eigen::PlainObjectBase<DerivedD> &D);
+  // Independent exact geodesic distances from each of many source vertices,
+  // computed in parallel (one propagation state per thread).
+  //
+  // Inputs:
+  //   data  precomputed mesh (see exact_geodesic_precompute)
+  //   S  #S list of source vertex indices, each its own query
+  //   VT #VT by 1 vector specifying indices of target vertices
+  //   FT #FT by 1 vector specifying indices of target faces
+  //   max_distance  propagation cutoff (use infinity for none)
+  // Output:
+  //   D  #VT+#FT by #S matrix, D(t,s) is the geodesic distance from S(s) to
+  //     target t (infinity if beyond max_distance)
+  template <
+    typename DerivedS,
+    typename DerivedVT,
+    typename DerivedFT,
+    typename DerivedD>
+  IGL_INLINE void exact_geodesic_solve(
+    const ExactGeodesicData & data,
+    const Eigen::MatrixBase<DerivedS> &S,
+    const Eigen::MatrixBase<DerivedVT> &VT,
+    const Eigen::MatrixBase<DerivedFT> &FT,
+    const double max_distance,
+    Eigen::PlainObjectBase<DerivedD> &D);
 }
 
 #ifndef IGL_STATIC_LIBRARY
@@ -0,0 +1,72 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2023 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_FACE_GEOMETRY_H
+#define IGL_FACE_GEOMETRY_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+
+namespace igl
+{
+  // Bit flags selecting which quantities face_geometry computes
+  enum FaceGeometryType
+  {
+    FACE_GEOMETRY_DOUBLEAREA = 1,
+    FACE_GEOMETRY_SQUARED_EDGE_LENGTHS = 2,
+    FACE_GEOMETRY_EDGE_LENGTHS = 4,
+    FACE_GEOMETRY_INTERNAL_ANGLES = 8,
+    FACE_GEOMETRY_NORMALS = 16,
+    FACE_GEOMETRY_ALL = 31
+  };
+  // Compute any subset of per-triangle quantities in a single pass over F.
+  // Faces are processed in small blocks whose corner positions are gathered
+  // once into fixed-size structure-of-arrays buffers, so that the arithmetic
+  // is specialized on the dimension and vectorizes. Dimensions other than 2
+  // and 3 fall back to a per-face loop over edge lengths.
+  //
+  // Inputs:
+  //   V  #V by dim list of vertex positions
+  //   F  #F by 3 list of triangle indices into V
+  //   types  bitwise-or of FaceGeometryType flags
+  // Outputs (only those requested in types are touched):
+  //   dblA  #F list of double areas (signed if dim = 2), see doublearea
+  //   L_sq  #F by 3 list of squared edge lengths, see squared_edge_lengths
+  //   L  #F by 3 list of edge lengths, see edge_lengths
+  //   K  #F by 3 list of internal angles, see internal_angles
+  //   N  #F by 3 list of unit face normals (zero for degenerate faces and
+  //     (0,0,±1) if dim = 2), see per_face_normals. Only defined if dim = 2
+  //     or 3 (asserted, nan otherwise).
+  //
+  // Example:
+  //   // Areas and angles without computing edge lengths twice
+  //   face_geometry(V,F,
+  //     FACE_GEOMETRY_DOUBLEAREA | FACE_GEOMETRY_INTERNAL_ANGLES,
+  //     dblA,L_sq,L,K,N);
+  template <
+    typename DerivedV,
+    typename DerivedF,
+    typename DeriveddblA,
+    typename DerivedL_sq,
+    typename DerivedL,
+    typename DerivedK,
+    typename DerivedN>
+  IGL_INLINE void face_geometry(
+    const Eigen::MatrixBase<DerivedV> & V,
+    const Eigen::MatrixBase<DerivedF> & F,
+    const int types,
+    Eigen::PlainObjectBase<DeriveddblA> & dblA,
+    Eigen::PlainObjectBase<DerivedL_sq> & L_sq,
+    Eigen::PlainObjectBase<DerivedL> & L,
+    Eigen::PlainObjectBase<DerivedK> & K,
+    Eigen::PlainObjectBase<DerivedN> & N);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "face_geometry.cpp"
+#endif
+
+#endif
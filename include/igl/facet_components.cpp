@@ -7,11 +7,11 @@
 // v. 2.0. If a copy of the MPL was not distributed with this file, You can
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "facet_components.h"
-#include "triangle_triangle_adjacency.h"
-#include "facet_adjacency_matrix.h"
-#include "connected_components.h"
+#include "unique_edge_map.h"
+#include "UnionFind.h"
+#include "parallel_for.h"
+#include <atomic>
 #include <vector>
-#include <queue>
 
 template <typename DerivedF, typename DerivedC>
 IGL_INLINE int igl::facet_components(
@@ -19,11 +19,30 @@ IGL_INLINE int igl::facet_components(
   Eigen::PlainObjectBase<DerivedC> & C)
 {
   typedef typename DerivedF::Scalar Index;
-  Eigen::SparseMatrix<Index> A;
-  igl::facet_adjacency_matrix(F,A);
+  const Index m = F.rows();
+  Eigen::Matrix<Index,Eigen::Dynamic,2> E,uE;
+  Eigen::Matrix<Index,Eigen::Dynamic,1> EMAP;
+  igl::unique_edge_map(F,E,uE,EMAP);
+  // The first face to claim each unique edge is merged with every other face
+  // incident on it, rather than building facet_adjacency_matrix(F)
+  std::vector<std::atomic<Index> > first(uE.rows());
+  igl::parallel_for(uE.rows(),[&](const Eigen::Index u)
+  {
+    first[u].store(-1,std::memory_order_relaxed);
+  },1000ul);
+  igl::UnionFind<Index> U(m);
+  igl::parallel_for(EMAP.rows(),[&](const Eigen::Index e)
+  {
+    const Index f = Index(e%m);
+    Index g = -1;
+    if(!first[EMAP(e)].compare_exchange_strong(
+      g,f,std::memory_order_relaxed))
+    {
+      U.unite(f,g);
+    }
+  },1000ul);
   Eigen::Matrix<Index,Eigen::Dynamic,1> counts;
-  C = DerivedC::Zero(1,1);
-  return connected_components(A,C,counts);
+  return int(U.components(C,counts));
 }
 
 template <
@@ -35,56 +54,22 @@ IGL_INLINE void igl::facet_components(
   Eigen::PlainObjectBase<DerivedC> & C,
   Eigen::PlainObjectBase<Derivedcounts> & counts)
 {
-  using namespace std;
   typedef TTIndex Index;
   const Index m = TT.size();
-  C.resize(m,1);
-  vector<bool> seen(m,false);
-  Index id = 0;
-  vector<Index> vcounts;
-  for(Index g = 0;g<m;g++)
+  igl::UnionFind<Index> U(m);
+  igl::parallel_for(m,[&](const Index f)
   {
-    if(seen[g])
+    // Face f's neighbor lists opposite each corner
+    for(const auto & c : TT[f])
     {
-      continue;
-    }
-    vcounts.push_back(0);
-    queue<Index> Q;
-    Q.push(g);
-    while(!Q.empty())
-    {
-      const Index f = Q.front();
-      Q.pop();
-      if(seen[f])
-      {
-        continue;
-      }
-      seen[f] = true;
-      vcounts[id]++;
-      C(f,0) = id;
-      // Face f's neighbor lists opposite opposite each corner
-      for(const auto & c : TT[f])
+      // Each neighbor
+      for(const auto & n : c)
       {
-        // Each neighbor
-        for(const auto & n : c)
-        {
-          if(!seen[n])
-          {
-            Q.push(n);
-          }
-        }
+        U.unite(f,Index(n));
       }
     }
-    id++;
-  }
-  assert((size_t) id == vcounts.size());
-  const size_t ncc = vcounts.size();
-  assert((size_t)C.maxCoeff()+1 == ncc);
-  counts.resize(ncc,1);
-  for(size_t i = 0;i<ncc;i++)
-  {
-    counts(i) = vcounts[i];
-  }
+  },1000ul);
+  U.components(C,counts);
 }
 
 #ifdef IGL_STATIC_LIBRARY
@@ -92,6 +77,7 @@ IGL_INLINE void igl::facet_components(
 template void igl::facet_components<long, Eigen::Matrix<long, -1, 1, 0, -1, 1>, Eigen::Matrix<long, -1, 1, 0, -1, 1> >(std::vector<std::vector<std::vector<long, std::allocator<long> >, std::allocator<std::vector<long, std::allocator<long> > > >, std::allocator<std::vector<std::vector<long, std::allocator<long> >, std::allocator<std::vector<long, std::allocator<long> > > > > > const&, Eigen::PlainObjectBase<Eigen::Matrix<long, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<long, -1, 1, 0, -1, 1> >&);
 template void igl::facet_components<int, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(std::vector<std::vector<std::vector<int, std::allocator<int> >, std::allocator<std::vector<int, std::allocator<int> > > >, std::allocator<std::vector<std::vector<int, std::allocator<int> >, std::allocator<std::vector<int, std::allocator<int> > > > > > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
 template int igl::facet_components<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
+template int igl::facet_components<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1>, Eigen::Matrix<std::int64_t, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<std::int64_t, -1, 1, 0, -1, 1> >&);
 #ifdef WIN32
 template void igl::facet_components<__int64,class Eigen::Matrix<__int64,-1,1,0,-1,1>,class Eigen::Matrix<__int64,-1,1,0,-1,1> >(class std::vector<class std::vector<class std::vector<__int64,class std::allocator<__int64> >,class std::allocator<class std::vector<__int64,class std::allocator<__int64> > > >,class std::allocator<class std::vector<class std::vector<__int64,class std::allocator<__int64> >,class std::allocator<class std::vector<__int64,class std::allocator<__int64> > > > > > const &,class Eigen::PlainObjectBase<class Eigen::Matrix<__int64,-1,1,0,-1,1> > &,class Eigen::PlainObjectBase<class Eigen::Matrix<__int64,-1,1,0,-1,1> > &);
 #endif
@@ -13,6 +13,8 @@
 namespace igl
 {
   // Compute connected components of facets based on edge-edge adjacency.
+  // Faces are merged in parallel with a lock-free union-find (see
+  // UnionFind.h), components are numbered in order of their smallest face.
   //
   // For connected components on vertices see igl::vertex_components
   //
@@ -20,6 +22,7 @@ namespace igl
   //   F  #F by 3 list of triangle indices
   // Outputs:
   //   C  #F list of connected component ids
+  // Returns number of connected components
   template <typename DerivedF, typename DerivedC>
   IGL_INLINE int facet_components(
     const Eigen::MatrixBase<DerivedF> & F,
@@ -12,6 +12,8 @@
 #include "polar_dec.h"
 #include "polar_svd.h"
 #include "C_STR.h"
+#include "parallel_for.h"
+#include <algorithm>
 #include <iostream>
 
 template <typename DerivedS, typename DerivedD>
@@ -29,12 +31,28 @@ IGL_INLINE void igl::fit_rotations(
   // resize output
   R.resize(dim,dim*nr); // hopefully no op (should be already allocated)
 
+#if defined(__AVX__) || defined(__SSE__)
+  if(single_precision)
+  {
+    // Batched SIMD kernels (always single precision)
+    const Eigen::MatrixXf Sf = S.template cast<float>();
+    Eigen::MatrixXf Rf;
+#  ifdef __AVX__
+    fit_rotations_AVX(Sf,Rf);
+#  else
+    fit_rotations_SSE(Sf,Rf);
+#  endif
+    R = Rf.template cast<typename DerivedD::Scalar>();
+    return;
+  }
+#endif
+
   //std::cout<<"S=["<<std::endl<<S<<std::endl<<"];"<<std::endl;
-  //MatrixXd si(dim,dim);
-  Eigen::Matrix<typename DerivedS::Scalar,3,3> si;// = Eigen::Matrix3d::Identity();
   // loop over number of rotations we're computing
-  for(int r = 0;r<nr;r++)
+  parallel_for(nr,[&](const int r)
   {
+    //MatrixXd si(dim,dim);
+    Eigen::Matrix<typename DerivedS::Scalar,3,3> si;// = Eigen::Matrix3d::Identity();
     // build this covariance matrix
     for(int i = 0;i<dim;i++)
     {
@@ -59,7 +77,7 @@ IGL_INLINE void igl::fit_rotations(
     R.block(0,r*dim,dim,dim) = ri.block(0,0,dim,dim).transpose();
     //cout<<matlab_format(si,C_STR("si_"<<r))<<endl;
     //cout<<matlab_format(ri.transpose().eval(),C_STR("ri_"<<r))<<endl;
-  }
+  },1000);
 }
 
 template <typename DerivedS, typename DerivedD>
@@ -76,10 +94,10 @@ IGL_INLINE void igl::fit_rotations_planar(
   // resize output
   R.resize(dim,dim*nr); // hopefully no op (should be already allocated)
 
-  Eigen::Matrix<typename DerivedS::Scalar,2,2> si;
   // loop over number of rotations we're computing
-  for(int r = 0;r<nr;r++)
+  parallel_for(nr,[&](const int r)
   {
+    Eigen::Matrix<typename DerivedS::Scalar,2,2> si;
     // build this covariance matrix
     for(int i = 0;i<2;i++)
     {
@@ -106,7 +124,7 @@ IGL_INLINE void igl::fit_rotations_planar(
     // Not sure why polar_dec computes transpose...
     R.block(0,r*dim,dim,dim).setIdentity();
     R.block(0,r*dim,2,2) = ri.transpose();
-  }
+  },1000);
 }
 
 
@@ -125,14 +143,18 @@ IGL_INLINE void igl::fit_rotations_SSE(
   // resize output
   R.resize(dim,dim*nr); // hopefully no op (should be already allocated)
 
-  Eigen::Matrix<float, 3*cStep, 3> siBig;
-  // using SSE decompose cStep matrices at a time:
-  int r = 0;
-  for( ; r<nr; r+=cStep)
+  // using SIMD decompose cStep matrices at a time, batches in parallel
+  const int num_batches = (nr + cStep - 1)/cStep;
+  parallel_for(num_batches,[&](const int batch)
   {
-    int numMats = cStep;
-    if (r + cStep >= nr) numMats = nr - r;
-    // build siBig:
+    const int r = batch*cStep;
+    const int numMats = std::min(cStep, nr - r);
+    // build siBig (padding with identity if this batch is not full):
+    Eigen::Matrix<float, 3*cStep, 3> siBig;
+    for (int k=0; k<cStep; k++)
+    {
+      siBig.block(3*k, 0, 3, 3).setIdentity();
+    }
     for (int k=0; k<numMats; k++)
     {
       for(int i = 0;i<dim;i++)
@@ -146,7 +168,7 @@ IGL_INLINE void igl::fit_rotations_SSE(
     Eigen::Matrix<float, 3*cStep, 3> ri;
     polar_svd3x3_sse(siBig, ri);    
 
-    for (int k=0; k<cStep; k++)
+    for (int k=0; k<numMats; k++)
       assert(ri.block(3*k, 0, 3, 3).determinant() >= 0);
 
     // Not sure why polar_dec computes transpose...
@@ -154,7 +176,7 @@ IGL_INLINE void igl::fit_rotations_SSE(
     {
       R.block(0, (r + k)*dim, dim, dim) = ri.block(3*k, 0, dim, dim).transpose();
     }    
-  }
+  },std::max(1000/cStep,1));
 }
 
 IGL_INLINE void igl::fit_rotations_SSE(
@@ -183,14 +205,18 @@ IGL_INLINE void igl::fit_rotations_AVX(
   // resize output
   R.resize(dim,dim*nr); // hopefully no op (should be already allocated)
 
-  Eigen::Matrix<float, 3*cStep, 3> siBig;
-  // using SSE decompose cStep matrices at a time:
-  int r = 0;
-  for( ; r<nr; r+=cStep)
+  // using SIMD decompose cStep matrices at a time, batches in parallel
+  const int num_batches = (nr + cStep - 1)/cStep;
+  parallel_for(num_batches,[&](const int batch)
   {
-    int numMats = cStep;
-    if (r + cStep >= nr) numMats = nr - r;
-    // build siBig:
+    const int r = batch*cStep;
+    const int numMats = std::min(cStep, nr - r);
+    // build siBig (padding with identity if this batch is not full):
+    Eigen::Matrix<float, 3*cStep, 3> siBig;
+    for (int k=0; k<cStep; k++)
+    {
+      siBig.block(3*k, 0, 3, 3).setIdentity();
+    }
     for (int k=0; k<numMats; k++)
     {
       for(int i = 0;i<dim;i++)
@@ -204,7 +230,7 @@ IGL_INLINE void igl::fit_rotations_AVX(
     Eigen::Matrix<float, 3*cStep, 3> ri;
     polar_svd3x3_avx(siBig, ri);    
 
-    for (int k=0; k<cStep; k++)
+    for (int k=0; k<numMats; k++)
       assert(ri.block(3*k, 0, 3, 3).determinant() >= 0);
 
     // Not sure why polar_dec computes transpose...
@@ -212,7 +238,7 @@ IGL_INLINE void igl::fit_rotations_AVX(
     {
       R.block(0, (r + k)*dim, dim, dim) = ri.block(3*k, 0, dim, dim).transpose();
     }    
-  }
+  },std::max(1000/cStep,1));
 }
 #endif
 
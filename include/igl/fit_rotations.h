@@ -20,7 +20,8 @@ namespace igl
   // 
   // Inputs:
   //   S  nr*dim by dim stack of covariance matrices
-  //   single_precision  whether to use single precision (faster)
+  //   single_precision  whether to use single precision (faster). When
+  //     compiled with SSE/AVX this processes 4/8 matrices at a time.
   // Outputs:
   //   R  dim by dim * nr list of rotations
   //
@@ -7,6 +7,235 @@
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "hausdorff.h"
 #include "point_mesh_squared_distance.h"
+#include "AABB.h"
+#include "parallel_for.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <vector>
+
+namespace igl
+{
+  namespace hausdorff_helpers
+  {
+    template <typename Scalar>
+    inline void atomic_max(std::atomic<Scalar> & a, const Scalar b)
+    {
+      Scalar prev = a.load(std::memory_order_relaxed);
+      while(prev < b && !a.compare_exchange_weak(prev,b)) {}
+    }
+
+    // Lower and upper bounds on the maximum distance from a triangle to B
+    // given distances d from its corners to B (see igl::hausdorff)
+    template <typename DerivedV, typename Derivedd, typename Scalar>
+    inline void triangle_bounds(
+      const Eigen::MatrixBase<DerivedV>& V,
+      const Eigen::MatrixBase<Derivedd>& d,
+      Scalar & l,
+      Scalar & u)
+    {
+      // e  3-long vector of opposite edge lengths
+      Eigen::Matrix<Scalar,1,3> e;
+      // Maximum edge length
+      Scalar e_max = 0;
+      for(int i=0;i<3;i++)
+      {
+        e(i) = (V.row((i+1)%3)-V.row((i+2)%3)).norm();
+        e_max = std::max(e_max,e(i));
+      }
+      // Semiperimeter
+      const Scalar s = (e(0)+e(1)+e(2))*0.5;
+      // Area
+      const Scalar A = sqrt(std::max(s*(s-e(0))*(s-e(1))*(s-e(2)),Scalar(0)));
+      // Circumradius
+      const Scalar R = e(0)*e(1)*e(2)/(4.*A);
+      // inradius
+      const Scalar r = A/s;
+      // Initialize lower bound to 0 (distances are non-negative)
+      l = 0;
+      Scalar u1 = std::numeric_limits<Scalar>::infinity();
+      Scalar u2 = 0;
+      for(int i=0;i<3;i++)
+      {
+        // Lower bound is simply the max over vertex distances
+        l = std::max(d(i),l);
+        // u1 is the minimum of corner distances + maximum adjacent edge
+        u1 = std::min(u1,d(i) + std::max(e((i+1)%3),e((i+2)%3)));
+        // u2 first takes the maximum over corner distances
+        u2 = std::max(u2,d(i));
+      }
+      // u2 is the distance from the circumcenter/midpoint of obtuse edge plus
+      // the largest corner distance
+      u2 += (s-r>2.*R ? R : 0.5*e_max);
+      u = std::min(u1,u2);
+    }
+
+    // Bound the one-sided distance max_{a∈A} min_{b∈B} ‖a-b‖.
+    //
+    // Subtrees of A whose box is certainly closer than L+tol to B are
+    // pruned; remaining triangles are subdivided until their upper bound
+    // drops below L+tol. Triangles are processed in parallel.
+    //
+    // Refinement of a piece stops early (and its upper bound is accepted as
+    // is) after max_depth subdivisions of one triangle, or once the
+    // subdivisions of all triangles exceed max_splits.
+    //
+    // Inputs:
+    //   VA,FA,treeA  mesh A and its AABB tree
+    //   VB,FB,treeB  mesh B and its AABB tree
+    //   tol  tolerance
+    //   L  current lower bound on the distance
+    //   U  current upper bound on the distance of pruned parts
+    //   max_splits  remaining budget of subdivisions shared by all triangles
+    // Outputs:
+    //   L  updated lower bound
+    //   U  updated upper bound
+    template <
+      typename DerivedVA,
+      typename DerivedFA,
+      typename DerivedVB,
+      typename DerivedFB,
+      typename Scalar>
+    inline void one_sided(
+      const Eigen::MatrixBase<DerivedVA> & VA,
+      const Eigen::MatrixBase<DerivedFA> & FA,
+      const igl::AABB<DerivedVA,3> & treeA,
+      const Eigen::MatrixBase<DerivedVB> & VB,
+      const Eigen::MatrixBase<DerivedFB> & FB,
+      const igl::AABB<DerivedVB,3> & treeB,
+      const Scalar tol,
+      std::atomic<Scalar> & L,
+      std::atomic<Scalar> & U,
+      std::atomic<std::int64_t> & max_splits)
+    {
+      typedef Eigen::Matrix<typename DerivedVB::Scalar,1,3> RowVector3S;
+      typedef Eigen::Matrix<Scalar,3,3> Matrix3S;
+      // Pieces below 2⁻²⁴ of the input edge lengths are not split further
+      const int max_depth = 24;
+      const auto dist_to_B = [&](const RowVector3S & p, const Scalar up)->Scalar
+      {
+        int i;
+        RowVector3S c;
+        return sqrt(treeB.squared_distance(VB,FB,p,up*up,i,c));
+      };
+      // Distances of all (referenced) vertices of A bootstrap the lower bound
+      Eigen::Matrix<Scalar,Eigen::Dynamic,1> D =
+        Eigen::Matrix<Scalar,Eigen::Dynamic,1>::Constant(
+          VA.rows(),-1);
+      for(int f = 0;f<FA.rows();f++)
+      {
+        for(int c = 0;c<3;c++) { D(FA(f,c)) = 0; }
+      }
+      igl::parallel_for(VA.rows(),[&](const int v)
+      {
+        if(D(v) < 0) { return; }
+        D(v) = dist_to_B(VA.row(v),std::numeric_limits<Scalar>::infinity());
+        atomic_max(L,D(v));
+      },1000);
+
+      // Refine triangle f of A by recursive 1:4 subdivision
+      const auto refine = [&](const int f)
+      {
+        struct Piece
+        {
+          Matrix3S V;
+          Eigen::Matrix<Scalar,1,3> d;
+          int depth;
+        };
+        std::vector<Piece> stack(1);
+        for(int c = 0;c<3;c++)
+        {
+          stack[0].V.row(c) = VA.row(FA(f,c)).template cast<Scalar>();
+          stack[0].d(c) = D(FA(f,c));
+        }
+        stack[0].depth = 0;
+        while(!stack.empty())
+        {
+          const Piece piece = stack.back();
+          stack.pop_back();
+          Scalar pl,pu;
+          triangle_bounds(piece.V,piece.d,pl,pu);
+          atomic_max(L,pl);
+          if(pu <= L+tol || piece.depth == max_depth ||
+            max_splits.fetch_sub(1,std::memory_order_relaxed) <= 0)
+          {
+            atomic_max(U,pu);
+            continue;
+          }
+          // Midpoints opposite each corner
+          Matrix3S M;
+          Eigen::Matrix<Scalar,1,3> Md;
+          for(int c = 0;c<3;c++)
+          {
+            M.row(c) = 0.5*(piece.V.row((c+1)%3)+piece.V.row((c+2)%3));
+            Md(c) = dist_to_B(M.row(c).template cast<typename DerivedVB::Scalar>(),
+              std::numeric_limits<Scalar>::infinity());
+          }
+          for(int c = 0;c<3;c++)
+          {
+            Piece child;
+            child.depth = piece.depth+1;
+            child.V.row(0) = piece.V.row(c);
+            child.d(0) = piece.d(c);
+            child.V.row(1) = M.row((c+2)%3);
+            child.d(1) = Md((c+2)%3);
+            child.V.row(2) = M.row((c+1)%3);
+            child.d(2) = Md((c+1)%3);
+            stack.push_back(child);
+          }
+          stack.push_back({M,Md,piece.depth+1});
+        }
+      };
+
+      // Prune subtree of A if ‖c-B‖ + ½ diagonal ≤ L+tol
+      std::function<void(const igl::AABB<DerivedVA,3> &)> traverse;
+      traverse = [&](const igl::AABB<DerivedVA,3> & node)
+      {
+        if(node.is_leaf())
+        {
+          if(node.m_primitive >= 0) { refine(node.m_primitive); }
+          return;
+        }
+        const Scalar h = 0.5*node.m_box.diagonal().norm();
+        const Scalar up = L+tol-h;
+        if(up > 0)
+        {
+          const Scalar dc = dist_to_B(node.m_box.center().transpose(),up);
+          if(dc < up)
+          {
+            atomic_max(U,dc+h);
+            return;
+          }
+        }
+        traverse(*node.m_left);
+        traverse(*node.m_right);
+      };
+      // Split the top of the tree into subtrees traversed in parallel
+      std::vector<const igl::AABB<DerivedVA,3> *> roots(1,&treeA);
+      for(int level = 0;level<8;level++)
+      {
+        std::vector<const igl::AABB<DerivedVA,3> *> next;
+        for(const auto * node : roots)
+        {
+          if(node->is_leaf())
+          {
+            next.push_back(node);
+          }else
+          {
+            next.push_back(node->m_left);
+            next.push_back(node->m_right);
+          }
+        }
+        roots.swap(next);
+      }
+      igl::parallel_for(roots.size(),[&](const int r)
+      {
+        traverse(*roots[r]);
+      },1);
+    }
+  }
+}
 
 template <
   typename DerivedVA,
@@ -45,46 +274,53 @@ IGL_INLINE void igl::hausdorff(
   Scalar & l,
   Scalar & u)
 {
-  // e  3-long vector of opposite edge lengths
-  Eigen::Matrix<typename DerivedV::Scalar,1,3> e;
-  // Maximum edge length
-  Scalar e_max = 0;
-  for(int i=0;i<3;i++)
-  {
-    e(i) = (V.row((i+1)%3)-V.row((i+2)%3)).norm();
-    e_max = std::max(e_max,e(i));
-  }
-  // Semiperimeter
-  const Scalar s = (e(0)+e(1)+e(2))*0.5;
-  // Area
-  const Scalar A = sqrt(s*(s-e(0))*(s-e(1))*(s-e(2)));
-  // Circumradius
-  const Scalar R = e(0)*e(1)*e(2)/(4.*A);
-  // inradius
-  const Scalar r = A/s;
-  // Initialize lower bound to ∞
-  l = std::numeric_limits<Scalar>::infinity();
   // d  3-long vector of distance from each corner to B
-  Eigen::Matrix<typename DerivedV::Scalar,1,3> d;
-  Scalar u1 = std::numeric_limits<Scalar>::infinity();
-  Scalar u2 = 0;
+  Eigen::Matrix<Scalar,1,3> d;
   for(int i=0;i<3;i++)
   {
     d(i) = dist_to_B(V(i,0),V(i,1),V(i,2));
-    // Lower bound is simply the max over vertex distances
-    l = std::max(d(i),l);
-    // u1 is the minimum of corner distances + maximum adjacent edge
-    u1 = std::min(u1,d(i) + std::max(e((i+1)%3),e((i+2)%3)));
-    // u2 first takes the maximum over corner distances
-    u2 = std::max(u2,d(i));
   }
-  // u2 is the distance from the circumcenter/midpoint of obtuse edge plus the
-  // largest corner distance
-  u2 += (s-r>2.*R ? R : 0.5*e_max);
-  u = std::min(u1,u2);
+  hausdorff_helpers::triangle_bounds(V,d,l,u);
+}
+
+template <
+  typename DerivedVA,
+  typename DerivedFA,
+  typename DerivedVB,
+  typename DerivedFB,
+  typename Scalar>
+IGL_INLINE bool igl::hausdorff(
+  const Eigen::MatrixBase<DerivedVA> & VA,
+  const Eigen::MatrixBase<DerivedFA> & FA,
+  const Eigen::MatrixBase<DerivedVB> & VB,
+  const Eigen::MatrixBase<DerivedFB> & FB,
+  const Scalar tol,
+  Scalar & l,
+  Scalar & u)
+{
+  assert(VA.cols() == 3 && "VA should contain 3d points");
+  assert(FA.cols() == 3 && "FA should contain triangles");
+  assert(VB.cols() == 3 && "VB should contain 3d points");
+  assert(FB.cols() == 3 && "FB should contain triangles");
+  assert(tol > 0 && "tol should be positive");
+  igl::AABB<DerivedVA,3> treeA;
+  treeA.init(VA,FA);
+  igl::AABB<DerivedVB,3> treeB;
+  treeB.init(VB,FB);
+  // Lower bound shared by both directions so that A→B helps pruning B→A
+  std::atomic<Scalar> L(0);
+  std::atomic<Scalar> U(0);
+  // Total work budget: each subdivision costs three distance queries
+  std::atomic<std::int64_t> max_splits(std::int64_t(1)<<20);
+  hausdorff_helpers::one_sided(VA,FA,treeA,VB,FB,treeB,tol,L,U,max_splits);
+  hausdorff_helpers::one_sided(VB,FB,treeB,VA,FA,treeA,tol,L,U,max_splits);
+  l = L;
+  u = std::max(Scalar(L),Scalar(U));
+  return u-l <= tol;
 }
 
 #ifdef IGL_STATIC_LIBRARY
 template void igl::hausdorff<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, double&);
+template bool igl::hausdorff<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, double, double&, double&);
 template void igl::hausdorff<Eigen::Matrix<double, -1, -1, 0, -1, -1>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, std::function<double (double const&, double const&, double const&)> const&, double&, double&);
 #endif
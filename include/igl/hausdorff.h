@@ -32,6 +32,8 @@ namespace igl
   // vertices can give unexpected results. Therefore, we assume the inputs have
   // no unreferenced vertices.
   //
+  // See the overload with tol below for a certified bound.
+  //
   // Inputs:
   //   VA  #VA by 3 list of vertex positions
   //   FA  #FA by 3 list of face indices into VA
@@ -54,6 +56,47 @@ namespace igl
     const Eigen::MatrixBase<DerivedVB> & VB,
     const Eigen::MatrixBase<DerivedFB> & FB,
     Scalar & d);
+  // Compute a certified interval [l,u] containing the exact Hausdorff distance
+  // between mesh (VA,FA) and mesh (VB,FB), aiming for u-l ≤ tol. Unlike the
+  // vertex-based overload above this also accounts for points in the
+  // interior of edges and faces.
+  //
+  // Branch-and-bound over the AABB trees of both meshes: the lower bound is
+  // the largest distance found so far from a point on one mesh to the
+  // other; parts of one mesh (subtrees, then recursively subdivided
+  // triangles) whose upper bound does not exceed l+tol are pruned.
+  // Remaining triangles are refined in parallel.
+  //
+  // Refinement is capped at 24 levels of 1:4 subdivision per input triangle
+  // and at 2²⁰ subdivisions in total, since the work grows as (h/tol)² on
+  // parts at near constant distance (h the triangle size). Past either cap
+  // [l,u] still contains the distance but may be wider than tol.
+  //
+  // Inputs:
+  //   VA  #VA by 3 list of vertex positions
+  //   FA  #FA by 3 list of face indices into VA
+  //   VB  #VB by 3 list of vertex positions
+  //   FB  #FB by 3 list of face indices into VB
+  //   tol  positive tolerance on u-l
+  // Outputs:
+  //   l  lower bound on Hausdorff distance
+  //   u  upper bound on Hausdorff distance
+  // Returns true iff u-l ≤ tol was reached
+  //
+  template <
+    typename DerivedVA,
+    typename DerivedFA,
+    typename DerivedVB,
+    typename DerivedFB,
+    typename Scalar>
+  IGL_INLINE bool hausdorff(
+    const Eigen::MatrixBase<DerivedVA> & VA,
+    const Eigen::MatrixBase<DerivedFA> & FA,
+    const Eigen::MatrixBase<DerivedVB> & VB,
+    const Eigen::MatrixBase<DerivedFB> & FB,
+    const Scalar tol,
+    Scalar & l,
+    Scalar & u);
   // Compute lower and upper bounds (l,u) on the Hausdorff distance between a triangle
   // (V) and a pointset (e.g., mesh, triangle soup) given by a distance function
   // handle (dist_to_B).
@@ -18,6 +18,8 @@
 #include "unique.h"
 #include "slice.h"
 #include "avg_edge_length.h"
+#include "parallel_for.h"
+#include <algorithm>
 
 
 template < typename DerivedV, typename DerivedF, typename Scalar >
@@ -102,68 +104,138 @@ IGL_INLINE void igl::heat_geodesics_solve(
   const Eigen::MatrixBase<Derivedgamma> & gamma,
   Eigen::PlainObjectBase<DerivedD> & D)
 {
+  const std::vector<Eigen::VectorXi> gammas(1,gamma.template cast<int>());
+  Eigen::Matrix<Scalar,Eigen::Dynamic,Eigen::Dynamic> Dk;
+  heat_geodesics_solve(data,gammas,Dk);
+  D = Dk;
+}
+
+template < typename Scalar, typename Derivedgamma, typename DerivedD>
+IGL_INLINE void igl::heat_geodesics_solve(
+  const HeatGeodesicsData<Scalar> & data,
+  const std::vector<Derivedgamma> & gammas,
+  Eigen::PlainObjectBase<DerivedD> & D)
+{
+  typedef Eigen::Matrix<Scalar,Eigen::Dynamic,Eigen::Dynamic> MatrixXS;
   // number of mesh vertices
   const int n = data.Grad.cols();
+  // number of source sets
+  const int k = gammas.size();
+  // Columns are processed in independent blocks
+  const int chunk = 8;
+  const int num_chunks = (k+chunk-1)/chunk;
+  // Z = argmin ½ Zᵀ A Z + Zᵀ B subject to Z(known) = 0 (and Aeq Z = 0)
+  const auto block_solve = [&](
+    const min_quad_with_fixed_data<Scalar> & solver,
+    const int num_known,
+    const int num_eq,
+    const MatrixXS & B,
+    MatrixXS & Z)
+  {
+    Z.resize(n,k);
+    igl::parallel_for(num_chunks,[&](const int c)
+    {
+      const int s = c*chunk;
+      const int w = std::min(chunk,k-s);
+      MatrixXS Zc;
+      igl::min_quad_with_fixed_solve(
+        solver,
+        B.middleCols(s,w).eval(),
+        MatrixXS::Zero(num_known,w).eval(),
+        MatrixXS::Zero(num_eq,w).eval(),
+        Zc);
+      Z.middleCols(s,w) = Zc;
+    },2);
+  };
+  // Y = A * X
+  const auto block_product = [&](
+    const Eigen::SparseMatrix<Scalar> & A,
+    const MatrixXS & X,
+    MatrixXS & Y)
+  {
+    Y.resize(A.rows(),k);
+    igl::parallel_for(num_chunks,[&](const int c)
+    {
+      const int s = c*chunk;
+      const int w = std::min(chunk,k-s);
+      Y.middleCols(s,w) = A*X.middleCols(s,w);
+    },2);
+  };
   // Set up delta at gamma
-  DerivedD u0 = DerivedD::Zero(n,1);
-  for(int g = 0;g<gamma.size();g++)
+  MatrixXS U0 = MatrixXS::Zero(n,k);
+  for(int j = 0;j<k;j++)
   {
-    u0(gamma(g)) = 1;
+    for(int g = 0;g<gammas[j].size();g++)
+    {
+      U0(gammas[j](g),j) = 1;
+    }
   }
   // Neumann solution
-  DerivedD u;
-  igl::min_quad_with_fixed_solve(
-    data.Neumann,u0,DerivedD(),DerivedD(),u);
+  MatrixXS U;
+  block_solve(data.Neumann,0,0,U0,U);
   if(data.b.size()>0)
   {
     // Average Dirichelt and Neumann solutions
-    DerivedD uD;
-    igl::min_quad_with_fixed_solve(
-      data.Dirichlet,u0,DerivedD::Zero(data.b.size()).eval(),DerivedD(),uD);
-    u += uD;
-    u *= 0.5;
+    MatrixXS UD;
+    block_solve(data.Dirichlet,data.b.size(),0,U0,UD);
+    U += UD;
+    U *= 0.5;
   }
-  DerivedD grad_u = data.Grad*u;
+  MatrixXS grad_U;
+  block_product(data.Grad,U,grad_U);
   const int m = data.Grad.rows()/data.ng;
-  for(int i = 0;i<m;i++)
+  igl::parallel_for(m,[&](const int i)
   {
-    // It is very important to use a stable norm calculation here. If the
-    // triangle is far from a source, then the floating point values in the
-    // gradient can be _very_ small (e.g., 1e-300). The standard/naive norm
-    // calculation will suffer from underflow. Dividing by the max value is more
-    // stable. (Eigen implements this as stableNorm or blueNorm).
-    Scalar norm = 0;
-    Scalar ma = 0;
-    for(int d = 0;d<data.ng;d++) {ma = std::max(ma,std::fabs(grad_u(d*m+i)));}
-    for(int d = 0;d<data.ng;d++)
+    for(int j = 0;j<k;j++)
     {
-      const Scalar gui = grad_u(d*m+i) / ma;
-      norm += gui*gui;
+      // It is very important to use a stable norm calculation here. If the
+      // triangle is far from a source, then the floating point values in the
+      // gradient can be _very_ small (e.g., 1e-300). The standard/naive norm
+      // calculation will suffer from underflow. Dividing by the max value is
+      // more stable. (Eigen implements this as stableNorm or blueNorm).
+      Scalar norm = 0;
+      Scalar ma = 0;
+      for(int d = 0;d<data.ng;d++) {ma = std::max(ma,std::fabs(grad_U(d*m+i,j)));}
+      for(int d = 0;d<data.ng;d++)
+      {
+        const Scalar gui = grad_U(d*m+i,j) / ma;
+        norm += gui*gui;
+      }
+      norm = ma*sqrt(norm);
+      // These are probably over kill; ma==0 should be enough
+      if(ma == 0 || norm == 0 || norm!=norm)
+      {
+        for(int d = 0;d<data.ng;d++) { grad_U(d*m+i,j) = 0; }
+      }else
+      {
+        for(int d = 0;d<data.ng;d++) { grad_U(d*m+i,j) /= norm; }
+      }
     }
-    norm = ma*sqrt(norm);
-    // These are probably over kill; ma==0 should be enough
-    if(ma == 0 || norm == 0 || norm!=norm)
+  },1000);
+  // -div_X
+  MatrixXS neg_div_X;
+  block_product(data.Div,grad_U,neg_div_X);
+  MatrixXS Dk;
+  block_solve(data.Poisson,0,1,neg_div_X,Dk);
+  igl::parallel_for(k,[&](const int j)
+  {
+    Scalar Dgamma = 0;
+    for(int g = 0;g<gammas[j].size();g++)
     {
-      for(int d = 0;d<data.ng;d++) { grad_u(d*m+i) = 0; }
-    }else
+      Dgamma += Dk(gammas[j](g),j);
+    }
+    Dk.col(j).array() -= Dgamma/Scalar(gammas[j].size());
+    if(Dk.col(j).mean() < 0)
     {
-      for(int d = 0;d<data.ng;d++) { grad_u(d*m+i) /= norm; }
+      Dk.col(j) = -Dk.col(j);
     }
-  }
-  const DerivedD div_X = -data.Div*grad_u;
-  const DerivedD Beq = (DerivedD(1,1)<<0).finished();
-  igl::min_quad_with_fixed_solve(data.Poisson,(-div_X).eval(),DerivedD(),Beq,D);
-  DerivedD Dgamma;
-  igl::slice(D,gamma,Dgamma);
-  D.array() -= Dgamma.mean();
-  if(D.mean() < 0)
-  {
-    D = -D;
-  }
+  },2);
+  D = Dk;
 }
 
 #ifdef IGL_STATIC_LIBRARY
 // Explicit template instantiation
+template void igl::heat_geodesics_solve<double, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(igl::HeatGeodesicsData<double> const&, std::vector<Eigen::Matrix<int, -1, 1, 0, -1, 1>, std::allocator<Eigen::Matrix<int, -1, 1, 0, -1, 1> > > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
 template void igl::heat_geodesics_solve<double, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1> >(igl::HeatGeodesicsData<double> const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&);
 template bool igl::heat_geodesics_precompute<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, double, igl::HeatGeodesicsData<double>&);
 template bool igl::heat_geodesics_precompute<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, igl::HeatGeodesicsData<double>&);
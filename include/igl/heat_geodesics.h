@@ -10,6 +10,7 @@
 #include "igl_inline.h"
 #include "min_quad_with_fixed.h"
 #include <Eigen/Sparse>
+#include <vector>
 #include <Eigen/Sparse>
 namespace igl
 {
@@ -60,6 +61,21 @@ namespace igl
     const HeatGeodesicsData<Scalar> & data,
     const Eigen::MatrixBase<Derivedgamma> & gamma,
     Eigen::PlainObjectBase<DerivedD> & D);
+  // Compute fast approximate geodesic distances to each of k independent sets
+  // of source vertices. All heat diffusion and Poisson problems are solved
+  // as multi-column right-hand sides, split into column blocks solved in
+  // parallel.
+  //
+  // Inputs: 
+  //   data  precomputation data (see heat_geodesics_precompute)
+  //   gammas  k list of lists of indices into V of source vertices
+  // Outputs:
+  //   D  #V by k list of distances, D.col(j) are the distances to gammas[j]
+  template < typename Scalar, typename Derivedgamma, typename DerivedD>
+  IGL_INLINE void heat_geodesics_solve(
+    const HeatGeodesicsData<Scalar> & data,
+    const std::vector<Derivedgamma> & gammas,
+    Eigen::PlainObjectBase<DerivedD> & D);
 }
 
 #ifndef IGL_STATIC_LIBRARY
@@ -11,8 +11,14 @@
 #include "slice.h"
 #include "random_points_on_mesh.h"
 #include "rigid_alignment.h"
+#include "point_simplex_squared_distance.h"
+#include "parallel_for.h"
+#include "get_seconds.h"
+#include <algorithm>
 #include <cassert>
-#include <iostream>
+#include <cmath>
+#include <cstdint>
+#include <limits>
 
 template <
   typename DerivedVX,
@@ -114,7 +120,138 @@ IGL_INLINE void igl::iterative_closest_point(
   }
 }
 
+template <
+  typename DerivedX,
+  typename DerivedVY,
+  typename DerivedFY,
+  typename DerivedNY,
+  typename DerivedR,
+  typename Derivedt
+  >
+IGL_INLINE void igl::iterative_closest_point(
+  const Eigen::MatrixBase<DerivedX> & X,
+  const Eigen::MatrixBase<DerivedVY> & VY,
+  const Eigen::MatrixBase<DerivedFY> & FY,
+  const igl::AABB<DerivedVY,3> & Ytree, 
+  const Eigen::MatrixBase<DerivedNY> & NY,
+  const double trim,
+  const double sigma,
+  const int max_iters,
+  Eigen::PlainObjectBase<DerivedR> & R,
+  Eigen::PlainObjectBase<Derivedt> & t,
+  std::vector<ICPIteration> & stats)
+{
+  assert(X.cols() == 3 && "X should be points in 3D");
+  assert(VY.cols() == 3 && "Y should be a mesh in 3D");
+  assert(trim > 0 && trim <= 1 && "trim should be in (0,1]");
+  typedef typename DerivedX::Scalar Scalar;
+  typedef Eigen::Matrix<Scalar,Eigen::Dynamic,Eigen::Dynamic> MatrixXS;
+  typedef Eigen::Matrix<Scalar,Eigen::Dynamic,1> VectorXS;
+  typedef Eigen::Matrix<Scalar,3,3> Matrix3S;
+  typedef Eigen::Matrix<Scalar,1,3> RowVector3S;
+  typedef Eigen::Matrix<typename DerivedVY::Scalar,1,3> RowVector3SY;
+  R.setIdentity(3,3);
+  t.setConstant(1,3,0);
+  stats.clear();
+
+  const int n = X.rows();
+  // Closest face of previous iteration (-1 for none)
+  Eigen::VectorXi I = Eigen::VectorXi::Constant(n,-1);
+  MatrixXS XRT(n,3),P(n,3),N(n,3);
+  VectorXS sqrD(n),W(n);
+  std::vector<int> order(n);
+  for(int i = 0;i<n;i++) { order[i] = i; }
+  {
+    // Before any face is known, visit points in Morton order
+    const RowVector3S min_X = X.colwise().minCoeff().template cast<Scalar>();
+    const Scalar h = 
+      (X.colwise().maxCoeff().template cast<Scalar>()-min_X).maxCoeff();
+    std::vector<std::uint32_t> M(n);
+    igl::parallel_for(n,[&](const int i)
+    {
+      std::uint32_t m = 0;
+      for(int c = 0;c<3;c++)
+      {
+        std::uint32_t q = h > 0 ? 
+          std::uint32_t(std::min(Scalar(1023),1024*(X(i,c)-min_X(c))/h)) : 0;
+        for(int b = 0;b<10;b++) { m |= ((q>>b)&1u)<<(3*b+c); }
+      }
+      M[i] = m;
+    },10000);
+    std::sort(order.begin(),order.end(),
+      [&M](const int a, const int b){ return M[a] < M[b]; });
+  }
+  for(int iter = 0;iter<max_iters;iter++)
+  {
+    ICPIteration it;
+    double t0 = get_seconds();
+    // Visit points ordered by their last closest face for coherent BVH
+    // traversals
+    if(iter > 0)
+    {
+      std::sort(order.begin(),order.end(),
+        [&I](const int a, const int b){ return I(a) < I(b); });
+    }
+    igl::parallel_for(n,[&](const int o)
+    {
+      const int i = order[o];
+      XRT.row(i) = X.row(i).template cast<Scalar>()*R+t;
+      const RowVector3SY q = XRT.row(i).template cast<typename DerivedVY::Scalar>();
+      int fi = I(i);
+      RowVector3SY c;
+      typename DerivedVY::Scalar up = std::numeric_limits<typename DerivedVY::Scalar>::infinity();
+      if(fi >= 0)
+      {
+        // Warm start: distance to last closest face bounds the search
+        igl::point_simplex_squared_distance<3>(q,VY,FY,fi,up,c);
+      }
+      sqrD(i) = Ytree.squared_distance(VY,FY,q,up,fi,c);
+      I(i) = fi;
+      P.row(i) = c.template cast<Scalar>();
+      N.row(i) = NY.row(fi).template cast<Scalar>();
+    },1000);
+    it.correspondence_time = get_seconds()-t0;
+
+    t0 = get_seconds();
+    // Trim: keep the trim·n closest correspondences
+    it.num_inliers = std::max(1,int(std::ceil(trim*n)));
+    Scalar max_sqrD = std::numeric_limits<Scalar>::infinity();
+    if(it.num_inliers < n)
+    {
+      VectorXS S = sqrD;
+      std::nth_element(
+        S.data(),S.data()+it.num_inliers-1,S.data()+S.size());
+      max_sqrD = S(it.num_inliers-1);
+    }
+    const Scalar ss = sigma*sigma;
+    Scalar sum_sqrD = 0;
+    int kept = 0;
+    for(int i = 0;i<n;i++)
+    {
+      if(sqrD(i) <= max_sqrD && kept < it.num_inliers)
+      {
+        W(i) = ss > 0 ? ss/(ss+sqrD(i)) : 1;
+        sum_sqrD += sqrD(i);
+        kept++;
+      }else
+      {
+        W(i) = 0;
+      }
+    }
+    it.rms = std::sqrt(sum_sqrD/kept);
+    Matrix3S Rup;
+    RowVector3S tup;
+    rigid_alignment(XRT,P,N,W,Rup,tup);
+    // update running rigid transformation
+    R = (R*Rup).eval();
+    t = (t*Rup + tup).eval();
+    it.alignment_time = get_seconds()-t0;
+    stats.push_back(it);
+  }
+}
+
 #ifdef IGL_STATIC_LIBRARY
 // Explicit template instantiation
 template void igl::iterative_closest_point<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, 3, 3, 0, 3, 3>, Eigen::Matrix<double, 1, 3, 1, 1, 3> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, int, int, Eigen::PlainObjectBase<Eigen::Matrix<double, 3, 3, 0, 3, 3> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> >&);
+template void igl::iterative_closest_point<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, 3, 3, 0, 3, 3>, Eigen::Matrix<double, 1, 3, 1, 1, 3> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3> const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, double, double, int, Eigen::PlainObjectBase<Eigen::Matrix<double, 3, 3, 0, 3, 3> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> >&, std::vector<igl::ICPIteration, std::allocator<igl::ICPIteration> >&);
 #endif
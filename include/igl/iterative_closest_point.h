@@ -10,6 +10,7 @@
 #include "igl_inline.h"
 #include <Eigen/Core>
 #include "AABB.h"
+#include <vector>
 
 namespace igl
 {
@@ -74,6 +75,61 @@ namespace igl
     const int max_iters,
     Eigen::PlainObjectBase<DerivedR> & R,
     Eigen::PlainObjectBase<Derivedt> & t);
+  // Statistics of one iteration of point-set ICP
+  struct ICPIteration
+  {
+    // Seconds spent on closest point queries
+    double correspondence_time;
+    // Seconds spent fitting the rigid transformation
+    double alignment_time;
+    // Number of correspondences kept after trimming
+    int num_inliers;
+    // Root mean squared distance of kept correspondences (before this
+    // iteration's update)
+    double rms;
+  };
+  // Register a fixed point set X (e.g., a scan) onto mesh Y. Unlike the
+  // mesh-sampling version above, the same points are used every iteration
+  // so each closest point query is warm started from the previous
+  // iteration's closest face: its distance bounds the BVH traversal of Y.
+  // Queries run in parallel.
+  //
+  // Inputs:
+  //   X  #X by 3 list of points
+  //   VY  #VY by 3 list of mesh Y vertices
+  //   FY  #FY by 3 list of mesh Y triangle indices into rows of VY
+  //   Ytree  precomputed AABB tree of (VY,FY), reused across calls
+  //   NY  #FY by 3 list of precomputed unit face normals
+  //   trim  fraction in (0,1] of correspondences kept each iteration (those
+  //     with the smallest distances), e.g., 0.9 for partially overlapping
+  //     scans
+  //   sigma  scale of Geman-McClure weights σ²/(σ²+d²) of kept
+  //     correspondences, or 0 for uniform weights
+  //   max_iters  number of iterations
+  // Outputs:
+  //   R  3x3 rotation matrix so that X*R+t ~~ (VY,FY)
+  //   t  1x3 translation row vector
+  //   stats  #iterations list of per-iteration statistics
+  template <
+    typename DerivedX,
+    typename DerivedVY,
+    typename DerivedFY,
+    typename DerivedNY,
+    typename DerivedR,
+    typename Derivedt
+    >
+  IGL_INLINE void iterative_closest_point(
+    const Eigen::MatrixBase<DerivedX> & X,
+    const Eigen::MatrixBase<DerivedVY> & VY,
+    const Eigen::MatrixBase<DerivedFY> & FY,
+    const igl::AABB<DerivedVY,3> & Ytree, 
+    const Eigen::MatrixBase<DerivedNY> & NY,
+    const double trim,
+    const double sigma,
+    const int max_iters,
+    Eigen::PlainObjectBase<DerivedR> & R,
+    Eigen::PlainObjectBase<Derivedt> & t,
+    std::vector<ICPIteration> & stats);
 }
 
 #ifndef IGL_STATIC_LIBRARY
@@ -6,6 +6,113 @@
 #include <queue>
 #include <set>
 #include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace igl
+{
+  namespace knn_helpers
+  {
+    // Squared distance from q to the cube of (full) width w centered at c
+    template <typename Derivedq, typename Derivedc, typename Scalar>
+    inline Scalar squared_distance_to_cube(
+      const Eigen::MatrixBase<Derivedq> & q,
+      const Eigen::MatrixBase<Derivedc> & c,
+      const Scalar w)
+    {
+      Scalar d = 0;
+      for(int j = 0;j<3;j++)
+      {
+        const Scalar e = std::max(Scalar(std::abs(q(j)-c(j)))-Scalar(0.5*w),Scalar(0));
+        d += e*e;
+      }
+      return d;
+    }
+
+    // Bounded k-nearest neighbor search: finds the min(k,#V) nearest
+    // neighbors of q among V, only considering points within distance
+    // sqrt(max_sqr_d).
+    //
+    // Outputs:
+    //   heap  max-heap of (squared distance, index) pairs
+    template <
+      typename Derivedq,
+      typename DerivedV,
+      typename IndexType,
+      typename DerivedCH,
+      typename DerivedCN,
+      typename DerivedW,
+      typename Scalar>
+    inline void bounded_knn(
+      const Eigen::MatrixBase<Derivedq> & q,
+      const Eigen::MatrixBase<DerivedV>& V,
+      const size_t k,
+      const double eps,
+      const Scalar max_sqr_d,
+      const std::vector<std::vector<IndexType> > & point_indices,
+      const Eigen::MatrixBase<DerivedCH>& CH,
+      const Eigen::MatrixBase<DerivedCN>& CN,
+      const Eigen::MatrixBase<DerivedW>& W,
+      std::vector<std::pair<Scalar,IndexType> > & heap,
+      std::vector<std::pair<Scalar,IndexType> > & stack)
+    {
+      heap.clear();
+      stack.clear();
+      const Scalar f = Scalar((1.+eps)*(1.+eps));
+      const auto radius = [&]()->Scalar
+      {
+        return heap.size() < k ? max_sqr_d : heap.front().first;
+      };
+      stack.emplace_back(squared_distance_to_cube(q,CN.row(0),W(0)),0);
+      while(!stack.empty())
+      {
+        const Scalar dc = stack.back().first;
+        const IndexType c = stack.back().second;
+        stack.pop_back();
+        if(dc*f > radius()) { continue; }
+        if(CH(c,0) == -1)
+        {
+          for(const IndexType v : point_indices[c])
+          {
+            const Scalar d = (V.row(v).template cast<Scalar>()-q).squaredNorm();
+            if(heap.size() < k)
+            {
+              if(d <= max_sqr_d)
+              {
+                heap.emplace_back(d,v);
+                std::push_heap(heap.begin(),heap.end());
+              }
+            }else if(d < heap.front().first)
+            {
+              std::pop_heap(heap.begin(),heap.end());
+              heap.back() = {d,v};
+              std::push_heap(heap.begin(),heap.end());
+            }
+          }
+        }else
+        {
+          // Push farthest children first so that the closest is visited first
+          std::pair<Scalar,IndexType> children[8];
+          for(int j = 0;j<8;j++)
+          {
+            const IndexType cj = CH(c,j);
+            children[j] = {squared_distance_to_cube(q,CN.row(cj),W(cj)),cj};
+          }
+          std::sort(children,children+8);
+          for(int j = 7;j>=0;j--)
+          {
+            if(!point_indices[children[j].second].empty() &&
+              children[j].first*f <= radius())
+            {
+              stack.push_back(children[j]);
+            }
+          }
+        }
+      }
+      std::sort_heap(heap.begin(),heap.end());
+    }
+  }
+}
 
 namespace igl {
   template <typename DerivedP, typename IndexType,
@@ -132,7 +239,125 @@ namespace igl {
   }
 }
 
+template <
+  typename DerivedP, 
+  typename DerivedV,
+  typename IndexType,
+  typename DerivedCH,
+  typename DerivedCN,
+  typename DerivedW,
+  typename DerivedI,
+  typename DerivedNI>
+IGL_INLINE void igl::knn(
+  const Eigen::MatrixBase<DerivedP>& P,
+  const Eigen::MatrixBase<DerivedV>& V,
+  const size_t k,
+  const double eps,
+  const std::vector<std::vector<IndexType> > & point_indices,
+  const Eigen::MatrixBase<DerivedCH>& CH,
+  const Eigen::MatrixBase<DerivedCN>& CN,
+  const Eigen::MatrixBase<DerivedW>& W,
+  Eigen::PlainObjectBase<DerivedI> & I,
+  Eigen::PlainObjectBase<DerivedNI> & NI)
+{
+  typedef typename DerivedP::Scalar Scalar;
+  typedef Eigen::Matrix<Scalar,1,3> RowVector3S;
+  const size_t kk = std::min<size_t>(k,V.rows());
+  NI.resize(P.rows()+1);
+  for(Eigen::Index i = 0;i<NI.size();i++) { NI(i) = i*kk; }
+  I.resize(P.rows()*kk);
+  if(kk == 0) { return; }
+  igl::parallel_for(P.rows(),[&](const int i)
+  {
+    std::vector<std::pair<Scalar,IndexType> > heap,stack;
+    const RowVector3S q = P.row(i);
+    knn_helpers::bounded_knn(
+      q,V,kk,eps,std::numeric_limits<Scalar>::infinity(),
+      point_indices,CH,CN,W,heap,stack);
+    for(size_t j = 0;j<kk;j++) { I(i*kk+j) = heap[j].second; }
+  },1000);
+}
 
+template <
+  typename DerivedP, 
+  typename IndexType,
+  typename DerivedCH,
+  typename DerivedCN,
+  typename DerivedW,
+  typename DerivedI,
+  typename DerivedNI>
+IGL_INLINE void igl::knn(
+  const Eigen::MatrixBase<DerivedP>& P,
+  const size_t k,
+  const double eps,
+  const std::vector<std::vector<IndexType> > & point_indices,
+  const Eigen::MatrixBase<DerivedCH>& CH,
+  const Eigen::MatrixBase<DerivedCN>& CN,
+  const Eigen::MatrixBase<DerivedW>& W,
+  Eigen::PlainObjectBase<DerivedI> & I,
+  Eigen::PlainObjectBase<DerivedNI> & NI)
+{
+  typedef typename DerivedP::Scalar Scalar;
+  typedef Eigen::Matrix<Scalar,1,3> RowVector3S;
+  const size_t kk = std::min<size_t>(k,P.rows());
+  NI.resize(P.rows()+1);
+  for(Eigen::Index i = 0;i<NI.size();i++) { NI(i) = i*kk; }
+  I.resize(P.rows()*kk);
+  if(kk == 0) { return; }
+  // Points in octree leaf order (spatially coherent)
+  std::vector<IndexType> order;
+  order.reserve(P.rows());
+  {
+    std::vector<IndexType> stack(1,0);
+    while(!stack.empty())
+    {
+      const IndexType c = stack.back();
+      stack.pop_back();
+      if(CH(c,0) == -1)
+      {
+        order.insert(
+          order.end(),point_indices[c].begin(),point_indices[c].end());
+      }else
+      {
+        for(int j = 7;j>=0;j--) { stack.push_back(CH(c,j)); }
+      }
+    }
+  }
+  assert(order.size() == size_t(P.rows()));
+  // Consecutive queries in a chunk reuse each other's results
+  const int chunk = 256;
+  const int num_chunks = (P.rows()+chunk-1)/chunk;
+  igl::parallel_for(num_chunks,[&](const int b)
+  {
+    std::vector<std::pair<Scalar,IndexType> > heap,stack;
+    RowVector3S prev_q = RowVector3S::Zero();
+    Scalar prev_d = -1;
+    for(int o = b*chunk;o<std::min<int>((b+1)*chunk,P.rows());o++)
+    {
+      const IndexType i = order[o];
+      const RowVector3S q = P.row(i);
+      Scalar max_sqr_d = std::numeric_limits<Scalar>::infinity();
+      if(prev_d >= 0)
+      {
+        // Ball around q of this radius contains the previous k neighbors
+        const Scalar r = (prev_d + (q-prev_q).norm())*Scalar(1.+1e-12);
+        max_sqr_d = r*r;
+      }
+      knn_helpers::bounded_knn(
+        q,P,kk,eps,max_sqr_d,point_indices,CH,CN,W,heap,stack);
+      if(heap.size() < kk)
+      {
+        // Numerical trouble: fall back to unbounded search
+        knn_helpers::bounded_knn(
+          q,P,kk,eps,std::numeric_limits<Scalar>::infinity(),
+          point_indices,CH,CN,W,heap,stack);
+      }
+      for(size_t j = 0;j<kk;j++) { I(i*kk+j) = heap[j].second; }
+      prev_q = q;
+      prev_d = std::sqrt(heap.back().first);
+    }
+  },1);
+}
 
 #ifdef IGL_STATIC_LIBRARY
 // Explicit template instantiation
@@ -140,6 +365,8 @@ namespace igl {
 
 template void igl::knn<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, int, Eigen::Matrix<int, -1, 8, 0, -1, 8>, Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, unsigned long, std::vector<std::vector<int, std::allocator<int> >, std::allocator<std::vector<int, std::allocator<int> > > > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 8, 0, -1, 8> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
 template void igl::knn<Eigen::Matrix<double, -1, -1, 0, -1, -1>, int, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, unsigned long, std::vector<std::vector<int, std::allocator<int> >, std::allocator<std::vector<int, std::allocator<int> > > > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
+template void igl::knn<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, int, Eigen::Matrix<int, -1, 8, 0, -1, 8>, Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, unsigned long, double, std::vector<std::vector<int, std::allocator<int> >, std::allocator<std::vector<int, std::allocator<int> > > > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 8, 0, -1, 8> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
+template void igl::knn<Eigen::Matrix<double, -1, -1, 0, -1, -1>, int, Eigen::Matrix<int, -1, 8, 0, -1, 8>, Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, unsigned long, double, std::vector<std::vector<int, std::allocator<int> >, std::allocator<std::vector<int, std::allocator<int> > > > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 8, 0, -1, 8> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
 #ifdef WIN32
 template void igl::knn<Eigen::Matrix<double,-1,-1,0,-1,-1>,int,Eigen::Matrix<int,-1,-1,0,-1,-1>,Eigen::Matrix<double,-1,-1,0,-1,-1>,Eigen::Matrix<double,-1,1,0,-1,1>,Eigen::Matrix<int,-1,-1,0,-1,-1> >(Eigen::MatrixBase<Eigen::Matrix<double,-1,-1,0,-1,-1> > const &,unsigned __int64,std::vector<std::vector<int,std::allocator<int> >,std::allocator<std::vector<int,std::allocator<int> > > > const &,Eigen::MatrixBase<Eigen::Matrix<int,-1,-1,0,-1,-1> > const &,Eigen::MatrixBase<Eigen::Matrix<double,-1,-1,0,-1,-1> > const &,Eigen::MatrixBase<Eigen::Matrix<double,-1,1,0,-1,1> > const &,Eigen::PlainObjectBase<Eigen::Matrix<int,-1,-1,0,-1,-1> > &);
 template void igl::knn<Eigen::Matrix<double,-1,-1,0,-1,-1>,Eigen::Matrix<double,-1,-1,0,-1,-1>,int,Eigen::Matrix<int,-1,8,0,-1,8>,Eigen::Matrix<double,-1,3,0,-1,3>,Eigen::Matrix<double,-1,1,0,-1,1>,Eigen::Matrix<int,-1,-1,0,-1,-1> >(Eigen::MatrixBase<Eigen::Matrix<double,-1,-1,0,-1,-1> > const &,Eigen::MatrixBase<Eigen::Matrix<double,-1,-1,0,-1,-1> > const &,unsigned __int64,std::vector<std::vector<int,std::allocator<int> >,std::allocator<std::vector<int,std::allocator<int> > > > const &,Eigen::MatrixBase<Eigen::Matrix<int,-1,8,0,-1,8> > const &,Eigen::MatrixBase<Eigen::Matrix<double,-1,3,0,-1,3> > const &,Eigen::MatrixBase<Eigen::Matrix<double,-1,1,0,-1,1> > const &,Eigen::PlainObjectBase<Eigen::Matrix<int,-1,-1,0,-1,-1> > &);
@@ -80,6 +80,74 @@ namespace igl
     const Eigen::MatrixBase<DerivedCN>& CN,
     const Eigen::MatrixBase<DerivedW>& W,
     Eigen::PlainObjectBase<DerivedI> & I);
+  // Approximate k-nearest neighbors with compressed (CSR) output.
+  //
+  // The search prunes octree cells that are farther than the current k-th
+  // distance divided by (1+eps), so that the jth returned neighbor is within
+  // (1+eps) times the distance of the true jth nearest neighbor.
+  //
+  // Inputs:
+  //   P  #P by 3 list of query points
+  //   V  #V by 3 list of point locations which may be neighbors
+  //   k  number of neighbors to find
+  //   eps  approximation factor (0 for exact search)
+  //   point_indices,CH,CN,W  octree of V (see igl::octree)
+  // Outputs:
+  //   I  #P*min(k,#V) list of indices into V so that the neighbors of P.row(i)
+  //     are I(NI(i)),...,I(NI(i+1)-1), sorted by increasing distance
+  //   NI  #P+1 list of cumulative neighbor counts
+  template <
+    typename DerivedP, 
+    typename DerivedV,
+    typename IndexType,
+    typename DerivedCH,
+    typename DerivedCN,
+    typename DerivedW,
+    typename DerivedI,
+    typename DerivedNI>
+  IGL_INLINE void knn(
+    const Eigen::MatrixBase<DerivedP>& P,
+    const Eigen::MatrixBase<DerivedV>& V,
+    const size_t k,
+    const double eps,
+    const std::vector<std::vector<IndexType> > & point_indices,
+    const Eigen::MatrixBase<DerivedCH>& CH,
+    const Eigen::MatrixBase<DerivedCN>& CN,
+    const Eigen::MatrixBase<DerivedW>& W,
+    Eigen::PlainObjectBase<DerivedI> & I,
+    Eigen::PlainObjectBase<DerivedNI> & NI);
+  // All k-nearest neighbors of a point set (each point is its own neighbor).
+  //
+  // Points are processed in octree leaf order; each query starts with the
+  // radius d_k(q') + ‖q-q'‖ obtained from the result of the previous query
+  // q', which already contains k points and prunes most of the octree.
+  //
+  // Inputs:
+  //   P  #P by 3 list of point locations
+  //   k  number of neighbors to find
+  //   eps  approximation factor (0 for exact search)
+  //   point_indices,CH,CN,W  octree of P (see igl::octree)
+  // Outputs:
+  //   I  #P*min(k,#P) list of indices into P, see above
+  //   NI  #P+1 list of cumulative neighbor counts
+  template <
+    typename DerivedP, 
+    typename IndexType,
+    typename DerivedCH,
+    typename DerivedCN,
+    typename DerivedW,
+    typename DerivedI,
+    typename DerivedNI>
+  IGL_INLINE void knn(
+    const Eigen::MatrixBase<DerivedP>& P,
+    const size_t k,
+    const double eps,
+    const std::vector<std::vector<IndexType> > & point_indices,
+    const Eigen::MatrixBase<DerivedCH>& CH,
+    const Eigen::MatrixBase<DerivedCN>& CN,
+    const Eigen::MatrixBase<DerivedW>& W,
+    Eigen::PlainObjectBase<DerivedI> & I,
+    Eigen::PlainObjectBase<DerivedNI> & NI);
 }
 #ifndef IGL_STATIC_LIBRARY
 #  include "knn.cpp"
@@ -14,6 +14,7 @@
 
 #include "max_size.h"
 #include "min_size.h"
+#include <cstdint>
 
 template <typename T, typename Derived>
 IGL_INLINE bool igl::list_to_matrix(const std::vector<std::vector<T > > & V,Eigen::PlainObjectBase<Derived>& M)
@@ -217,6 +218,9 @@ template bool igl::list_to_matrix<int, 3ul, Eigen::Matrix<int, -1, 3, 0, -1, 3>
 template bool igl::list_to_matrix<int, 3ul, Eigen::Matrix<int, -1, 3, 1, -1, 3> >(std::vector<std::array<int, 3ul>, std::allocator<std::array<int, 3ul> > > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 3, 1, -1, 3> >&);
 template bool igl::list_to_matrix<unsigned int, 3ul, Eigen::Matrix<unsigned int, -1, 3, 1, -1, 3> >(std::vector<std::array<unsigned int, 3ul>, std::allocator<std::array<unsigned int, 3ul> > > const&, Eigen::PlainObjectBase<Eigen::Matrix<unsigned int, -1, 3, 1, -1, 3> >&);
 
+template bool igl::list_to_matrix<int, Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> >(std::vector<std::vector<int, std::allocator<int> >, std::allocator<std::vector<int, std::allocator<int> > > > const&, Eigen::PlainObjectBase<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> >&);
+template bool igl::list_to_matrix<std::int64_t, 3ul, Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> >(std::vector<std::array<std::int64_t, 3ul>, std::allocator<std::array<std::int64_t, 3ul> > > const&, Eigen::PlainObjectBase<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> >&);
+template bool igl::list_to_matrix<std::int64_t, Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> >(std::vector<std::vector<std::int64_t, std::allocator<std::int64_t> >, std::allocator<std::vector<std::int64_t, std::allocator<std::int64_t> > > > const&, Eigen::PlainObjectBase<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> >&);
 #ifdef WIN32
 template bool igl::list_to_matrix<double, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(std::vector<double, std::allocator<double> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
 template bool igl::list_to_matrix<double, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(std::vector<double, std::allocator<double> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
@@ -9,6 +9,7 @@
 #define IGL_MARCH_CUBE_H
 #include "igl_inline.h"
 #include <Eigen/Core>
+#include <cstdint>
 #include <unordered_map>
 namespace igl
 {
@@ -23,7 +24,9 @@ namespace igl
   //   n  current number of mesh vertices (i.e., occupied rows in V)
   //   F  #F by 3 current list of output mesh triangle indices into rows of V
   //   m  current number of mesh triangles (i.e., occupied rows in F)
-  //   E2V  current edge (GV_i,GV_j) to vertex (V_k) map
+  //   E2V  current edge (GV_i,GV_j) to vertex (V_k) map, keyed by 3 times
+  //     the index of the edge's first endpoint along its axis plus the axis
+  //     (requires all cubes to list their corners in the same order)
   // Side-effects: V,n,F,m,E2V are updated to contain new vertices and faces of
   // any constructed mesh elements
   //
@@ -32,7 +35,8 @@ namespace igl
     typename Scalar,
     typename Index,
     typename DerivedV,
-    typename DerivedF>
+    typename DerivedF,
+    typename E2VIndex>
   IGL_INLINE void march_cube(
     const DerivedGV & GV,
     const Eigen::Matrix<Scalar,8,1> & cS,
@@ -42,7 +46,7 @@ namespace igl
     Index & n,
     Eigen::PlainObjectBase<DerivedF> &F,
     Index & m,
-    std::unordered_map<int64_t,int> & E2V);
+    std::unordered_map<std::int64_t,E2VIndex> & E2V);
 }
 
 #ifndef IGL_STATIC_LIBRARY
@@ -11,6 +11,7 @@
 // Adapted from public domain code at
 // http://paulbourke.net/geometry/polygonise/marchingsource.cpp
 
+#include <cstdint>
 #include <unordered_map>
 #include <iostream>
 
@@ -26,30 +27,32 @@ IGL_INLINE void igl::marching_cubes(
     Eigen::PlainObjectBase<DerivedF> &F)
 {
   typedef typename DerivedS::Scalar Scalar;
-  typedef unsigned Index;
+  typedef std::int64_t Index;
+  // Grids may have more than 2^32 cells
+  const Index sx = nx, sxy = Index(nx)*Index(ny);
   // use same order as a2fVertexOffset
-  const unsigned ioffset[8] = {0,1,1+nx,nx,nx*ny,1+nx*ny,1+nx+nx*ny,nx+nx*ny};
+  const Index ioffset[8] = {0,1,1+sx,sx,sxy,1+sxy,1+sx+sxy,sx+sxy};
 
 
-  std::unordered_map<int64_t,int> E2V;
-  V.resize(std::pow(nx*ny*nz,2./3.),3);
-  F.resize(std::pow(nx*ny*nz,2./3.),3);
+  std::unordered_map<std::int64_t,Index> E2V;
+  V.resize(std::pow(double(nx)*ny*nz,2./3.),3);
+  F.resize(std::pow(double(nx)*ny*nz,2./3.),3);
   Index n = 0;
   Index m = 0;
 
-  const auto xyz2i = [&nx,&ny,&nz]
-    (const int & x, const int & y, const int & z)->unsigned
+  const auto xyz2i = [&sx,&sxy]
+    (const Index & x, const Index & y, const Index & z)->Index
   {
-    return x+nx*(y+ny*(z));
+    return x+sx*y+sxy*z;
   };
   const auto cube = 
     [
       &GV,&S,&V,&n,&F,&m,&isovalue,
       &E2V,&xyz2i,&ioffset
     ]
-    (const int x, const int y, const int z)
+    (const Index x, const Index y, const Index z)
   {
-    const unsigned i = xyz2i(x,y,z);
+    const Index i = xyz2i(x,y,z);
 
     //Make a local copy of the values at the cube's corners
     Eigen::Matrix<Scalar,8,1> cS;
@@ -57,7 +60,7 @@ IGL_INLINE void igl::marching_cubes(
     //Find which vertices are inside of the surface and which are outside
     for(int c = 0; c < 8; c++)
     {
-      const unsigned ic = i + ioffset[c];
+      const Index ic = i + ioffset[c];
       cI(c) = ic;
       cS(c) = S(ic);
     }
@@ -72,11 +75,11 @@ IGL_INLINE void igl::marching_cubes(
   // Like red-black Gauss Seidel. Probably each thread need's their own E2V,V,F,
   // and then merge at the end. Annoying part are the edges lying on the
   // interface between chunks.
-  for(int z=0;z<nz-1;z++)
+  for(Index z=0;z+1<nz;z++)
   {
-    for(int y=0;y<ny-1;y++)
+    for(Index y=0;y+1<ny;y++)
     {
-      for(int x=0;x<nx-1;x++)
+      for(Index x=0;x+1<nx;x++)
       {
         cube(x,y,z);
       }
@@ -100,10 +103,10 @@ IGL_INLINE void igl::marching_cubes(
   Eigen::PlainObjectBase<DerivedV> &V,
   Eigen::PlainObjectBase<DerivedF> &F)
 {
-  typedef Eigen::Index Index;
+  typedef std::int64_t Index;
   typedef typename DerivedV::Scalar Scalar;
 
-  std::unordered_map<int64_t,int> E2V;
+  std::unordered_map<std::int64_t,Index> E2V;
   V.resize(4*GV.rows(),3);
   F.resize(4*GV.rows(),3);
   Index n = 0;
@@ -136,4 +139,5 @@ template void igl::marching_cubes<Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen:
 // generated by autoexplicit.sh
 template void igl::marching_cubes<Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, unsigned int, unsigned int, unsigned int, Eigen::Matrix<double, -1, 1, 0, -1, 1>::Scalar, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
 template void igl::marching_cubes<Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<double, -1, 1, 0, -1, 1>::Scalar, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
+template void igl::marching_cubes<Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, unsigned int, unsigned int, unsigned int, Eigen::Matrix<double, -1, 1, 0, -1, 1>::Scalar, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> >&);
 #endif
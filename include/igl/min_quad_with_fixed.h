@@ -8,6 +8,7 @@
 #ifndef IGL_MIN_QUAD_WITH_FIXED_H
 #define IGL_MIN_QUAD_WITH_FIXED_H
 #include "igl_inline.h"
+#include "multigrid.h"
 
 #define EIGEN_YES_I_KNOW_SPARSE_MODULE_IS_NOT_STABLE_YET
 #include <Eigen/Core>
@@ -16,6 +17,7 @@
 // Bug in unsupported/Eigen/SparseExtra needs iostream first
 #include <iostream>
 #include <unsupported/Eigen/SparseExtra>
+#include <vector>
 
 namespace igl
 {
@@ -59,6 +61,21 @@ namespace igl
     const bool pd,
     min_quad_with_fixed_data<T> & data
     );
+  // Inputs:
+  //   P  list of prolongation operators of a mesh hierarchy over all n
+  //     variables (see igl::multigrid_hierarchy). If non-empty, pd is true and
+  //     there are no linear equality constraints, then A(unknown,unknown) is
+  //     solved with geometric multigrid (see igl::multigrid_solve) instead of
+  //     a sparse Cholesky factorization. Otherwise P is ignored.
+  template <typename T, typename Derivedknown>
+  IGL_INLINE bool min_quad_with_fixed_precompute(
+    const Eigen::SparseMatrix<T>& A,
+    const Eigen::MatrixBase<Derivedknown> & known,
+    const Eigen::SparseMatrix<T>& Aeq,
+    const bool pd,
+    const std::vector<Eigen::SparseMatrix<T> > & P,
+    min_quad_with_fixed_data<T> & data
+    );
   // Solves a system previously factored using min_quad_with_fixed_precompute
   //
   // Template:
@@ -190,10 +207,12 @@ struct igl::min_quad_with_fixed_data
     LDLT = 1,
     LU = 2,
     QR_LLT = 3,
-    NUM_SOLVER_TYPES = 4
+    MULTIGRID = 4,
+    NUM_SOLVER_TYPES = 5
   } solver_type;
   // Solvers
   Eigen::SimplicialLLT <Eigen::SparseMatrix<T > > llt;
+  MultigridData<T> multigrid;
   Eigen::SimplicialLDLT<Eigen::SparseMatrix<T > > ldlt;
   Eigen::SparseLU<Eigen::SparseMatrix<T, Eigen::ColMajor>, Eigen::COLAMDOrdering<int> >   lu;
   // QR factorization
@@ -16,6 +16,7 @@
 #include "repmat.h"
 #include "EPS.h"
 #include "cat.h"
+#include "multigrid.h"
 
 //#include <Eigen/SparseExtra>
 // Bug in unsupported/Eigen/SparseExtra needs iostream first
@@ -25,6 +26,7 @@
 #include <cstdio>
 #include <igl/matlab_format.h>
 #include <type_traits>
+#include <vector>
 
 template <typename T, typename Derivedknown>
 IGL_INLINE bool igl::min_quad_with_fixed_precompute(
@@ -34,6 +36,20 @@ IGL_INLINE bool igl::min_quad_with_fixed_precompute(
   const bool pd,
   min_quad_with_fixed_data<T> & data
   )
+{
+  return min_quad_with_fixed_precompute(
+    A2,known,Aeq,pd,std::vector<Eigen::SparseMatrix<T> >(),data);
+}
+
+template <typename T, typename Derivedknown>
+IGL_INLINE bool igl::min_quad_with_fixed_precompute(
+  const Eigen::SparseMatrix<T>& A2,
+  const Eigen::MatrixBase<Derivedknown> & known,
+  const Eigen::SparseMatrix<T>& Aeq,
+  const bool pd,
+  const std::vector<Eigen::SparseMatrix<T> > & P,
+  min_quad_with_fixed_data<T> & data
+  )
 {
 //#define MIN_QUAD_WITH_FIXED_CPP_DEBUG
   using namespace Eigen;
@@ -214,7 +230,22 @@ IGL_INLINE bool igl::min_quad_with_fixed_precompute(
 #ifdef MIN_QUAD_WITH_FIXED_CPP_DEBUG
     cout<<"    factorize"<<endl;
 #endif
-    if(data.Auu_pd && neq == 0)
+    if(data.Auu_pd && neq == 0 && !P.empty())
+    {
+#ifdef MIN_QUAD_WITH_FIXED_CPP_DEBUG
+    cout<<"    multigrid"<<endl;
+#endif
+      assert(P[0].rows() == n && "P[0].rows() should match A.rows()");
+      // Restrict finest prolongation to unknowns
+      std::vector<SparseMatrix<T> > Pu = P;
+      slice(P[0],data.unknown,1,Pu[0]);
+      if(!multigrid_precompute(Auu,Pu,data.multigrid))
+      {
+        cerr<<"Error: Multigrid precomputation failed."<<endl;
+        return false;
+      }
+      data.solver_type = min_quad_with_fixed_data<T>::MULTIGRID;
+    }else if(data.Auu_pd && neq == 0)
     {
 #ifdef MIN_QUAD_WITH_FIXED_CPP_DEBUG
     cout<<"    llt"<<endl;
@@ -466,6 +497,14 @@ IGL_INLINE bool igl::min_quad_with_fixed_solve(
         // Not a bottleneck
         sol = data.lu.solve(NB);
         break;
+      case igl::min_quad_with_fixed_data<T>::MULTIGRID:
+        sol.setZero(NB.rows(),NB.cols());
+        if(!multigrid_solve(data.multigrid,NB,sol))
+        {
+          cerr<<"Error: Multigrid solve did not converge."<<endl;
+          return false;
+        }
+        break;
       default:
         cerr<<"Error: invalid solver type"<<endl;
         return false;
@@ -0,0 +1,330 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2023 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "multigrid.h"
+#include "qslim.h"
+#include "decimate.h"
+#include "point_mesh_squared_distance.h"
+#include "barycentric_coordinates.h"
+#include "parallel_for.h"
+#include "slice.h"
+#include <cmath>
+#include <functional>
+#include <vector>
+
+IGL_INLINE bool igl::multigrid_hierarchy(
+  const Eigen::MatrixXd & V,
+  const Eigen::MatrixXi & F,
+  const MultigridCoarseningType coarsening_type,
+  const int min_faces,
+  std::vector<Eigen::SparseMatrix<double> > & P)
+{
+  P.clear();
+  Eigen::MatrixXd Vl = V;
+  Eigen::MatrixXi Fl = F;
+  while(Fl.rows() >= min_faces)
+  {
+    Eigen::MatrixXd U;
+    Eigen::MatrixXi G;
+    Eigen::VectorXi J,I;
+    const size_t max_m = std::max<size_t>(Fl.rows()/4,1);
+    // Not reaching max_m is fine as long as the level got coarser (checked
+    // below)
+    switch(coarsening_type)
+    {
+      case MULTIGRID_COARSENING_TYPE_QSLIM:
+        qslim(Vl,Fl,max_m,U,G,J,I);
+        break;
+      case MULTIGRID_COARSENING_TYPE_DECIMATE:
+        decimate(Vl,Fl,max_m,U,G,J,I);
+        break;
+      default:
+        assert(false && "Unknown coarsening type");
+        return false;
+    }
+    // Decimation failed (e.g., level is not edge-manifold) or stalled: keep
+    // the levels built so far and stop here
+    if(G.rows() == 0 || U.rows() == 0 || G.rows() > 0.9*Fl.rows())
+    {
+      return !P.empty();
+    }
+    // Surviving vertices inject directly
+    Eigen::VectorXi birth = Eigen::VectorXi::Constant(Vl.rows(),-1);
+    for(int i = 0;i<I.size();i++)
+    {
+      birth(I(i)) = i;
+    }
+    // Everyone else interpolates on the closest coarse triangle
+    Eigen::VectorXd sqrD;
+    Eigen::VectorXi K;
+    Eigen::MatrixXd C;
+    point_mesh_squared_distance(Vl,U,G,sqrD,K,C);
+    Eigen::MatrixXd L(Vl.rows(),3);
+    parallel_for(Vl.rows(),[&](const int v)
+    {
+      if(birth(v) >= 0)
+      {
+        return;
+      }
+      Eigen::RowVector3d l;
+      barycentric_coordinates(
+        Eigen::RowVector3d(C.row(v)),
+        Eigen::RowVector3d(U.row(G(K(v),0))),
+        Eigen::RowVector3d(U.row(G(K(v),1))),
+        Eigen::RowVector3d(U.row(G(K(v),2))),
+        l);
+      // Guard against degenerate coarse triangles
+      l = l.cwiseMax(0.0);
+      const double s = l.sum();
+      L.row(v) = (s > 0 && std::isfinite(s)) ?
+        Eigen::RowVector3d(l/s) : Eigen::RowVector3d(1./3.,1./3.,1./3.);
+    },1000);
+    std::vector<Eigen::Triplet<double> > PIJV;
+    PIJV.reserve(3*Vl.rows());
+    for(int v = 0;v<Vl.rows();v++)
+    {
+      if(birth(v) >= 0)
+      {
+        PIJV.emplace_back(v,birth(v),1.0);
+      }else
+      {
+        for(int c = 0;c<3;c++)
+        {
+          PIJV.emplace_back(v,G(K(v),c),L(v,c));
+        }
+      }
+    }
+    Eigen::SparseMatrix<double> Pl(Vl.rows(),U.rows());
+    Pl.setFromTriplets(PIJV.begin(),PIJV.end());
+    Pl.prune(0.0);
+    P.push_back(Pl);
+    Vl = U;
+    Fl = G;
+  }
+  return true;
+}
+
+template <typename Scalar>
+IGL_INLINE bool igl::multigrid_precompute(
+  const Eigen::SparseMatrix<Scalar> & A,
+  const std::vector<Eigen::SparseMatrix<Scalar> > & P,
+  MultigridData<Scalar> & data)
+{
+  assert(A.rows() == A.cols() && "A should be square");
+  data.A.clear();
+  data.P.clear();
+  data.Dinv.clear();
+  data.C.clear();
+  data.CI.clear();
+  data.A.push_back(A);
+  // Indices of coarse dofs of the previous level that were kept
+  Eigen::VectorXi kept;
+  for(size_t l = 0;l<P.size();l++)
+  {
+    Eigen::SparseMatrix<Scalar> Pl = P[l];
+    if(l > 0)
+    {
+      slice(P[l],kept,1,Pl);
+    }
+    if(Pl.rows() != data.A.back().rows())
+    {
+      assert(false && "P[l].rows() should match size of level l");
+      return false;
+    }
+    // Drop coarse dofs without any support on this level
+    Pl.prune(static_cast<Scalar>(0));
+    std::vector<int> keep;
+    keep.reserve(Pl.cols());
+    for(int j = 0;j<Pl.outerSize();j++)
+    {
+      if(Pl.col(j).nonZeros() > 0)
+      {
+        keep.push_back(j);
+      }
+    }
+    kept = Eigen::Map<Eigen::VectorXi>(keep.data(),keep.size());
+    if(kept.size() == 0)
+    {
+      break;
+    }
+    if(kept.size() < Pl.cols())
+    {
+      slice(Eigen::SparseMatrix<Scalar>(Pl),kept,2,Pl);
+    }
+    const Eigen::SparseMatrix<Scalar> PlT = Pl.transpose();
+    data.A.push_back(PlT*data.A.back()*Pl);
+    data.P.push_back(Pl);
+  }
+  // Smoother data on all but the coarsest level
+  data.Dinv.resize(data.P.size());
+  data.C.resize(data.P.size());
+  data.CI.resize(data.P.size());
+  for(size_t l = 0;l<data.P.size();l++)
+  {
+    const Eigen::SparseMatrix<Scalar> & Al = data.A[l];
+    const int n = Al.rows();
+    data.Dinv[l] = Al.diagonal();
+    if((data.Dinv[l].array() == 0).any())
+    {
+      return false;
+    }
+    data.Dinv[l] = data.Dinv[l].cwiseInverse();
+    // Greedy coloring of the sparsity graph
+    Eigen::VectorXi color = Eigen::VectorXi::Constant(n,-1);
+    std::vector<int> mark;
+    int num_colors = 0;
+    for(int i = 0;i<n;i++)
+    {
+      for(typename Eigen::SparseMatrix<Scalar>::InnerIterator it(Al,i);it;++it)
+      {
+        if(it.row() != i && color(it.row()) >= 0)
+        {
+          if(color(it.row()) >= (int)mark.size())
+          {
+            mark.resize(color(it.row())+1,-1);
+          }
+          mark[color(it.row())] = i;
+        }
+      }
+      int c = 0;
+      while(c < (int)mark.size() && mark[c] == i) { c++; }
+      color(i) = c;
+      num_colors = std::max(num_colors,c+1);
+    }
+    Eigen::VectorXi & CI = data.CI[l];
+    Eigen::VectorXi & C = data.C[l];
+    CI = Eigen::VectorXi::Zero(num_colors+1);
+    for(int i = 0;i<n;i++)
+    {
+      CI(color(i)+1)++;
+    }
+    for(int c = 0;c<num_colors;c++)
+    {
+      CI(c+1) += CI(c);
+    }
+    C.resize(n);
+    Eigen::VectorXi fill = CI.head(num_colors);
+    for(int i = 0;i<n;i++)
+    {
+      C(fill(color(i))++) = i;
+    }
+  }
+  data.coarsest.compute(data.A.back());
+  return data.coarsest.info() == Eigen::Success;
+}
+
+template <typename Scalar, typename DerivedB, typename DerivedZ>
+IGL_INLINE bool igl::multigrid_solve(
+  const MultigridData<Scalar> & data,
+  const Eigen::MatrixBase<DerivedB> & B,
+  Eigen::PlainObjectBase<DerivedZ> & Z,
+  int & iterations,
+  Scalar & residual)
+{
+  typedef Eigen::Matrix<Scalar,Eigen::Dynamic,Eigen::Dynamic> MatrixXS;
+  typedef typename Eigen::SparseMatrix<Scalar>::InnerIterator InnerIterator;
+  assert(data.A.size() == data.P.size()+1);
+  const int n = data.A[0].rows();
+  const int k = B.cols();
+  assert(B.rows() == n);
+  iterations = 0;
+  residual = 0;
+  if(Z.rows() != n || Z.cols() != k)
+  {
+    Z.setZero(n,k);
+  }
+  const Scalar normB = B.norm();
+  if(normB == 0)
+  {
+    Z.setZero(n,k);
+    return true;
+  }
+  // One multi-color Gauss-Seidel sweep. Assumes A is symmetric so that
+  // columns can be read as rows.
+  const auto smooth = [&data,&k](
+    const int l,
+    const MatrixXS & b,
+    const bool forward,
+    MatrixXS & x)
+  {
+    const Eigen::SparseMatrix<Scalar> & Al = data.A[l];
+    const Eigen::VectorXi & C = data.C[l];
+    const Eigen::VectorXi & CI = data.CI[l];
+    const int num_colors = CI.size()-1;
+    for(int cc = 0;cc<num_colors;cc++)
+    {
+      const int c = forward ? cc : num_colors-1-cc;
+      parallel_for(CI(c+1)-CI(c),[&](const int ii)
+      {
+        const int i = C(CI(c)+ii);
+        for(int j = 0;j<k;j++)
+        {
+          Scalar s = b(i,j);
+          for(InnerIterator it(Al,i);it;++it)
+          {
+            if(it.row() != i)
+            {
+              s -= it.value()*x(it.row(),j);
+            }
+          }
+          x(i,j) = s*data.Dinv[l](i);
+        }
+      },1000);
+    }
+  };
+  const std::function<void(const int,const MatrixXS &,MatrixXS &)> vcycle =
+    [&](const int l, const MatrixXS & b, MatrixXS & x)
+  {
+    if(l+1 == (int)data.A.size())
+    {
+      x = data.coarsest.solve(b);
+      return;
+    }
+    for(int s = 0;s<data.pre_smoothing;s++)
+    {
+      smooth(l,b,true,x);
+    }
+    const MatrixXS rc = data.P[l].transpose()*(b - data.A[l]*x);
+    MatrixXS xc = MatrixXS::Zero(rc.rows(),rc.cols());
+    vcycle(l+1,rc,xc);
+    x += data.P[l]*xc;
+    for(int s = 0;s<data.post_smoothing;s++)
+    {
+      smooth(l,b,false,x);
+    }
+  };
+  const MatrixXS b = B.template cast<Scalar>();
+  MatrixXS x = Z.template cast<Scalar>();
+  residual = (b - data.A[0]*x).norm()/normB;
+  while(residual > data.tolerance && iterations < data.max_iter)
+  {
+    vcycle(0,b,x);
+    iterations++;
+    residual = (b - data.A[0]*x).norm()/normB;
+  }
+  Z = x.template cast<typename DerivedZ::Scalar>();
+  return residual <= data.tolerance;
+}
+
+template <typename Scalar, typename DerivedB, typename DerivedZ>
+IGL_INLINE bool igl::multigrid_solve(
+  const MultigridData<Scalar> & data,
+  const Eigen::MatrixBase<DerivedB> & B,
+  Eigen::PlainObjectBase<DerivedZ> & Z)
+{
+  int iterations;
+  Scalar residual;
+  return multigrid_solve(data,B,Z,iterations,residual);
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template bool igl::multigrid_precompute<double>(Eigen::SparseMatrix<double, 0, int> const&, std::vector<Eigen::SparseMatrix<double, 0, int>, std::allocator<Eigen::SparseMatrix<double, 0, int> > > const&, igl::MultigridData<double>&);
+template bool igl::multigrid_solve<double, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(igl::MultigridData<double> const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
+template bool igl::multigrid_solve<double, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1> >(igl::MultigridData<double> const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&);
+template bool igl::multigrid_solve<double, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(igl::MultigridData<double> const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, int&, double&);
+#endif
@@ -0,0 +1,117 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2023 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_MULTIGRID_H
+#define IGL_MULTIGRID_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+#include <Eigen/Sparse>
+#include <vector>
+
+namespace igl
+{
+  enum MultigridCoarseningType
+  {
+    MULTIGRID_COARSENING_TYPE_QSLIM = 0,
+    MULTIGRID_COARSENING_TYPE_DECIMATE = 1,
+    NUM_MULTIGRID_COARSENING_TYPE = 2
+  };
+  template <typename Scalar>
+  struct MultigridData
+  {
+    // Galerkin system matrices per level, A[0] is the input system
+    std::vector<Eigen::SparseMatrix<Scalar> > A;
+    // Prolongation operators, P[l] maps values on level l+1 to level l
+    std::vector<Eigen::SparseMatrix<Scalar> > P;
+    // Inverse diagonals of A[l] (used by the smoother)
+    std::vector<Eigen::Matrix<Scalar,Eigen::Dynamic,1> > Dinv;
+    // Multi-color ordering of rows of A[l]: rows of color c are
+    // C[l](CI[l](c)),...,C[l](CI[l](c+1)-1). Rows of the same color share no
+    // off-diagonal entries and can be relaxed concurrently.
+    std::vector<Eigen::VectorXi> C,CI;
+    // Direct solver for the coarsest level
+    Eigen::SimplicialLDLT<Eigen::SparseMatrix<Scalar> > coarsest;
+    // Number of Gauss-Seidel sweeps before and after each coarse correction
+    int pre_smoothing = 2;
+    int post_smoothing = 2;
+    // Maximum number of V-cycles
+    int max_iter = 100;
+    // Stop when ‖B-A*Z‖/‖B‖ drops below this value
+    Scalar tolerance = 1e-8;
+  };
+  // Build a hierarchy of prolongation operators from a sequence of
+  // successively decimated meshes. Each level is decimated to a quarter of the
+  // faces of the previous level. Surviving vertices inject their values via
+  // the birth map I, all other fine vertices interpolate barycentrically on
+  // the closest triangle of the coarse level.
+  //
+  // Inputs:
+  //   V  #V by 3 list of mesh vertex positions
+  //   F  #F by 3 list of mesh face indices into V
+  //   coarsening_type  method used to build coarse levels (see
+  //     igl::qslim, igl::decimate)
+  //   min_faces  stop coarsening once a level has fewer than this many faces
+  // Outputs:
+  //   P  #levels-1 list of prolongation operators, P[0] is #V by #V1, P[1] is
+  //     #V1 by #V2, etc.
+  // Returns true iff at least one coarse level was built. If decimating a
+  //   level fails (e.g., it is not edge-manifold) or stalls, coarsening stops
+  //   there and the levels built so far are kept in P.
+  IGL_INLINE bool multigrid_hierarchy(
+    const Eigen::MatrixXd & V,
+    const Eigen::MatrixXi & F,
+    const MultigridCoarseningType coarsening_type,
+    const int min_faces,
+    std::vector<Eigen::SparseMatrix<double> > & P);
+  // Precompute a geometric multigrid solver for A * Z = B using Galerkin
+  // coarse operators Aₗ₊₁ = Pₗᵀ Aₗ Pₗ. Coarse degrees of freedom with no
+  // support in the fine system (e.g., after removing fixed rows from P[0])
+  // are dropped.
+  //
+  // Inputs:
+  //   A  n by n symmetric positive definite sparse matrix
+  //   P  list of prolongation operators (see multigrid_hierarchy), P[0]
+  //     should have n rows
+  // Outputs:
+  //   data  precomputation data (see multigrid_solve)
+  // Returns true on success, false on error
+  template <typename Scalar>
+  IGL_INLINE bool multigrid_precompute(
+    const Eigen::SparseMatrix<Scalar> & A,
+    const std::vector<Eigen::SparseMatrix<Scalar> > & P,
+    MultigridData<Scalar> & data);
+  // Solve A * Z = B with V-cycles using multi-color Gauss-Seidel smoothing
+  // (colors are relaxed in parallel).
+  //
+  // Inputs:
+  //   data  precomputation data (see multigrid_precompute)
+  //   B  n by k right-hand side
+  //   Z  if n by k on input, then used as initial guess
+  // Outputs:
+  //   Z  n by k solution
+  //   iterations  number of V-cycles performed
+  //   residual  final relative residual ‖B-A*Z‖/‖B‖
+  // Returns true iff residual is below data.tolerance
+  template <typename Scalar, typename DerivedB, typename DerivedZ>
+  IGL_INLINE bool multigrid_solve(
+    const MultigridData<Scalar> & data,
+    const Eigen::MatrixBase<DerivedB> & B,
+    Eigen::PlainObjectBase<DerivedZ> & Z,
+    int & iterations,
+    Scalar & residual);
+  template <typename Scalar, typename DerivedB, typename DerivedZ>
+  IGL_INLINE bool multigrid_solve(
+    const MultigridData<Scalar> & data,
+    const Eigen::MatrixBase<DerivedB> & B,
+    Eigen::PlainObjectBase<DerivedZ> & Z);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "multigrid.cpp"
+#endif
+
+#endif
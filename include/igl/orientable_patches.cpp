@@ -9,6 +9,10 @@
 #include "vertex_components.h"
 #include "sort.h"
 #include "unique_rows.h"
+#include "unique_edge_map.h"
+#include "UnionFind.h"
+#include "parallel_for.h"
+#include <atomic>
 #include <vector>
 #include <iostream>
 
@@ -94,8 +98,39 @@ IGL_INLINE void igl::orientable_patches(
   const Eigen::MatrixBase<DerivedF> & F,
   Eigen::PlainObjectBase<DerivedC> & C)
 {
-  Eigen::SparseMatrix<typename DerivedF::Scalar> A;
-  return orientable_patches(F,C,A);
+  // Merge faces across manifold edges directly with a lock-free union-find
+  // rather than building A
+  typedef typename DerivedF::Scalar Index;
+  assert(F.cols() == 3);
+  const Index m = F.rows();
+  Eigen::Matrix<Index,Eigen::Dynamic,2> E,uE;
+  Eigen::Matrix<Index,Eigen::Dynamic,1> EMAP;
+  unique_edge_map(F,E,uE,EMAP);
+  // Number of faces incident on each unique edge and the first to claim it
+  std::vector<std::atomic<Index> > degree(uE.rows()),first(uE.rows());
+  parallel_for(uE.rows(),[&](const Eigen::Index u)
+  {
+    degree[u].store(0,std::memory_order_relaxed);
+    first[u].store(-1,std::memory_order_relaxed);
+  },1000ul);
+  parallel_for(EMAP.rows(),[&](const Eigen::Index e)
+  {
+    degree[EMAP(e)].fetch_add(1,std::memory_order_relaxed);
+    Index g = -1;
+    first[EMAP(e)].compare_exchange_strong(
+      g,Index(e%m),std::memory_order_relaxed);
+  },1000ul);
+  UnionFind<Index> U(m);
+  parallel_for(EMAP.rows(),[&](const Eigen::Index e)
+  {
+    const Index u = EMAP(e);
+    if(degree[u].load(std::memory_order_relaxed) == 2)
+    {
+      U.unite(Index(e%m),first[u].load(std::memory_order_relaxed));
+    }
+  },1000ul);
+  Eigen::Matrix<Index,Eigen::Dynamic,1> counts;
+  U.components(C,counts);
 }
 
 #ifdef IGL_STATIC_LIBRARY
@@ -104,4 +139,5 @@ template void igl::orientable_patches<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eig
 template void igl::orientable_patches<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
 template void igl::orientable_patches<Eigen::Matrix<int, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, int>(Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 0, -1, 3> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::SparseMatrix<int, 0, int>&);
 template void igl::orientable_patches<Eigen::Matrix<int, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 0, -1, 3> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
+template void igl::orientable_patches<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1>, Eigen::Matrix<std::int64_t, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<std::int64_t, -1, 1, 0, -1, 1> >&);
 #endif
@@ -30,6 +30,8 @@ namespace igl
     const Eigen::MatrixBase<DerivedF> & F,
     Eigen::PlainObjectBase<DerivedC> & C,
     Eigen::SparseMatrix<AScalar> & A);
+  // Without A: faces are merged in parallel with a lock-free union-find (see
+  // UnionFind.h) instead of building the adjacency matrix.
   template <typename DerivedF, typename DerivedC>
   IGL_INLINE void orientable_patches(
     const Eigen::MatrixBase<DerivedF> & F,
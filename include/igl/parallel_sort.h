@@ -0,0 +1,102 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2023 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_PARALLEL_SORT_H
+#define IGL_PARALLEL_SORT_H
+#include <cstddef>
+#include <functional>
+#include <iterator>
+
+namespace igl
+{
+  // Parallel comparison sort (merge sort): one block per thread is sorted
+  // with std::sort, then pairs of sorted blocks are merged in parallel.
+  //
+  // Inputs:
+  //   first  iterator to first element
+  //   last  iterator past last element
+  //   comp  strict weak ordering (like std::sort)
+  //   min_parallel  sort serially with std::sort if there are fewer elements
+  //     than this
+  //
+  // Example:
+  //   std::vector<size_t> I(n);
+  //   ...
+  //   igl::parallel_sort(I.begin(),I.end(),
+  //     [&](const size_t a, const size_t b){ return X(a) < X(b); });
+  template <typename RandomIt, typename Compare>
+  inline void parallel_sort(
+    RandomIt first,
+    RandomIt last,
+    const Compare & comp,
+    const size_t min_parallel = 1<<15);
+  template <typename RandomIt>
+  inline void parallel_sort(RandomIt first, RandomIt last);
+}
+
+// Implementation
+
+#include "default_num_threads.h"
+#include "parallel_for.h"
+#include <algorithm>
+#include <vector>
+
+template <typename RandomIt, typename Compare>
+inline void igl::parallel_sort(
+  RandomIt first,
+  RandomIt last,
+  const Compare & comp,
+  const size_t min_parallel)
+{
+  typedef typename std::iterator_traits<RandomIt>::value_type T;
+  const size_t n = last-first;
+  const size_t num_blocks = std::min<size_t>(
+    igl::default_num_threads(),n/std::max<size_t>(min_parallel,1));
+  if(num_blocks <= 1)
+  {
+    std::sort(first,last,comp);
+    return;
+  }
+  // Block b is [bounds[b],bounds[b+1])
+  std::vector<size_t> bounds(num_blocks+1);
+  for(size_t b = 0;b<=num_blocks;b++)
+  {
+    bounds[b] = n*b/num_blocks;
+  }
+  igl::parallel_for(num_blocks,[&](const size_t b)
+  {
+    std::sort(first+bounds[b],first+bounds[b+1],comp);
+  },2ul);
+  // Merge rounds ping-pong between two buffers
+  std::vector<T> A(first,last), B(n);
+  std::vector<T> * src = &A, * dst = &B;
+  for(size_t width = 1;width<num_blocks;width *= 2)
+  {
+    const size_t num_pairs = (num_blocks+2*width-1)/(2*width);
+    igl::parallel_for(num_pairs,[&](const size_t p)
+    {
+      const size_t b0 = bounds[2*width*p];
+      const size_t b1 = bounds[std::min(2*width*p+width,num_blocks)];
+      const size_t b2 = bounds[std::min(2*width*p+2*width,num_blocks)];
+      std::merge(
+        src->begin()+b0,src->begin()+b1,
+        src->begin()+b1,src->begin()+b2,
+        dst->begin()+b0,comp);
+    },2ul);
+    std::swap(src,dst);
+  }
+  std::copy(src->begin(),src->end(),first);
+}
+
+template <typename RandomIt>
+inline void igl::parallel_sort(RandomIt first, RandomIt last)
+{
+  typedef typename std::iterator_traits<RandomIt>::value_type T;
+  return parallel_sort(first,last,std::less<T>());
+}
+
+#endif
@@ -12,6 +12,7 @@
 #include "PI.h"
 #include "parallel_for.h"
 #include "doublearea.h"
+#include "face_geometry.h"
 #include <Eigen/Geometry>
 
 template <
@@ -42,22 +43,51 @@ IGL_INLINE void igl::per_corner_normals(
   const Eigen::MatrixBase<DerivedVF> & VF,
   const Eigen::MatrixBase<DerivedNI> & NI,
   Eigen::PlainObjectBase<DerivedCN> & CN)
+{
+  return per_corner_normals(
+    V,F,corner_threshold_degrees,PER_VERTEX_NORMALS_WEIGHTING_TYPE_AREA,VF,NI,CN);
+}
+
+template <
+  typename DerivedV,
+  typename DerivedF,
+  typename DerivedVF,
+  typename DerivedNI,
+  typename DerivedCN>
+IGL_INLINE void igl::per_corner_normals(
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedF> & F,
+  const typename DerivedV::Scalar corner_threshold_degrees,
+  const PerVertexNormalsWeightingType weighting,
+  const Eigen::MatrixBase<DerivedVF> & VF,
+  const Eigen::MatrixBase<DerivedNI> & NI,
+  Eigen::PlainObjectBase<DerivedCN> & CN)
 {
   typedef typename DerivedV::Scalar Scalar;
   typedef Eigen::Index Index;
-  // unit normals
-  Eigen::Matrix<Scalar,Eigen::Dynamic,3,Eigen::RowMajor> FN(F.rows(),3);
-  // face areas
-  Eigen::Matrix<Scalar,Eigen::Dynamic,1> FA(F.rows());
-  igl::parallel_for(F.rows(),[&](const Index f)
+  // unit normals, double areas and (if needed) angles at corners in one pass
+  Eigen::Matrix<Scalar,Eigen::Dynamic,3,Eigen::RowMajor> FN;
+  Eigen::Matrix<Scalar,Eigen::Dynamic,1> FA;
+  Eigen::Matrix<Scalar,Eigen::Dynamic,3,Eigen::RowMajor> FK,L_sq,L;
+  face_geometry(
+    V,F,
+    FACE_GEOMETRY_NORMALS | FACE_GEOMETRY_DOUBLEAREA |
+      (weighting == PER_VERTEX_NORMALS_WEIGHTING_TYPE_ANGLE ?
+        FACE_GEOMETRY_INTERNAL_ANGLES : 0),
+    FA,L_sq,L,FK,FN);
+  // Weight of face f's normal at its vertex v
+  const auto weight = [&](const Index f, const Index v)->Scalar
   {
-    const Eigen::Matrix<Scalar,1,3> v10 = V.row(F(f,1))-V.row(F(f,0));
-    const Eigen::Matrix<Scalar,1,3> v20 = V.row(F(f,2))-V.row(F(f,0));
-    const Eigen::Matrix<Scalar,1,3> n = v10.cross(v20);
-    const Scalar a = n.norm();
-    FA(f) = a;
-    FN.row(f) = n/a;
-  },10000);
+    switch(weighting)
+    {
+      case PER_VERTEX_NORMALS_WEIGHTING_TYPE_UNIFORM:
+        return 1;
+      case PER_VERTEX_NORMALS_WEIGHTING_TYPE_ANGLE:
+        return FK(f,F(f,0) == v ? 0 : (F(f,1) == v ? 1 : 2));
+      default:
+        return FA(f);
+    }
+  };
 
   // number of faces
   const Index m = F.rows();
@@ -88,7 +118,7 @@ IGL_INLINE void igl::per_corner_normals(
         if(dp > cos_thresh)
         {
           // add to running sum
-          CN.row(i*n+j) += ifn*FA(VF[k]);
+          CN.row(i*n+j) += ifn*weight(VF[k],v);
         }
       }
       // normalize to take average
@@ -261,4 +291,6 @@ template void igl::per_corner_normals<Eigen::Matrix<double, -1, -1, 0, -1, -1>,
 // Clang thinks this is the same as the one below, but Windows doesn't?
 // template void igl::per_corner_normals<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<double, -1, -1, 0, -1, -1>::Scalar, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
 template void igl::per_corner_normals<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, double, Eigen::PlainObjectBase< Eigen::Matrix<double, -1, -1, 0, -1, -1> > &);
+template void igl::per_corner_normals<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<double, -1, -1, 0, -1, -1>::Scalar, igl::PerVertexNormalsWeightingType, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
+template void igl::per_corner_normals<Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<float, -1, -1, 0, -1, -1>::Scalar, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> >&);
 #endif
@@ -9,6 +9,7 @@
 #ifndef IGL_PER_CORNER_NORMALS_H
 #define IGL_PER_CORNER_NORMALS_H
 #include "igl_inline.h"
+#include "per_vertex_normals.h"
 #include <Eigen/Core>
 #include <vector>
 
@@ -57,6 +58,23 @@ namespace igl
     const Eigen::MatrixBase<DerivedNI> & NI,
     Eigen::PlainObjectBase<DerivedCN> & CN);
   // Inputs:
+  //   weighting  weighting of incident face normals (uniform, area or angle
+  //     at the corner's vertex), the above use area weighting
+  template <
+    typename DerivedV,
+    typename DerivedF,
+    typename DerivedVF,
+    typename DerivedNI,
+    typename DerivedCN>
+  IGL_INLINE void per_corner_normals(
+    const Eigen::MatrixBase<DerivedV> & V,
+    const Eigen::MatrixBase<DerivedF> & F,
+    const typename DerivedV::Scalar corner_threshold_degrees,
+    const PerVertexNormalsWeightingType weighting,
+    const Eigen::MatrixBase<DerivedVF> & VF,
+    const Eigen::MatrixBase<DerivedNI> & NI,
+    Eigen::PlainObjectBase<DerivedCN> & CN);
+  // Inputs:
   //   CI  #CI list of face neighbors as indices into rows of F
   //   CC  3*#F+1 list of cumulative sizes so that CC(i*3+j+1) - CC(i*3+j) is
   //     the number of faces considered smoothly incident on corner at F(i,j)
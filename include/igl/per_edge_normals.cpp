@@ -5,12 +5,12 @@
 // This Source Code Form is subject to the terms of the Mozilla Public License 
 // v. 2.0. If a copy of the MPL was not distributed with this file, You can 
 // obtain one at http://mozilla.org/MPL/2.0/.
-#include "oriented_facets.h"
-#include "doublearea.h"
 #include "per_edge_normals.h"
-#include "get_seconds.h"
+#include "doublearea.h"
+#include "parallel_for.h"
 #include "per_face_normals.h"
-#include "unique_simplices.h"
+#include "unique_edge_map.h"
+#include <cassert>
 
 template <
   typename DerivedV, 
@@ -22,32 +22,47 @@ template <
 IGL_INLINE void igl::per_edge_normals(
   const Eigen::MatrixBase<DerivedV>& V,
   const Eigen::MatrixBase<DerivedF>& F,
-  const PerEdgeNormalsWeightingType weighting,
+  const PerEdgeNormalsWeightingType weight,
   const Eigen::MatrixBase<DerivedFN>& FN,
   Eigen::PlainObjectBase<DerivedN> & N,
   Eigen::PlainObjectBase<DerivedE> & E,
   Eigen::PlainObjectBase<DerivedEMAP> & EMAP)
 
 {
-  using namespace Eigen;
-  using namespace std;
   assert(F.cols() == 3 && "Faces must be triangles");
-  // number of faces
-  const int m = F.rows();
-  // All occurrences of directed edges
-  Matrix<typename DerivedF::Scalar, Dynamic, Dynamic> allE;
-  oriented_facets(F,allE);
-  // Find unique undirected edges and mapping
-  Matrix<typename DerivedF::Scalar, Dynamic, 1> _;
-  unique_simplices(allE,E,_,EMAP);
-  // now sort(allE,2) == E(EMAP,:), that is, if EMAP(i) = j, then E.row(j) is
-  // the undirected edge corresponding to the directed edge allE.row(i).
+  // Find unique undirected edges and mapping (E,EMAP are the same as
+  // unique_simplices of oriented_facets), and directed edges of each
+  Eigen::Matrix<typename DerivedF::Scalar,Eigen::Dynamic,2> allE;
+  Eigen::Matrix<typename DerivedF::Scalar,Eigen::Dynamic,1> uEC,uEE;
+  unique_edge_map(F,allE,E,EMAP,uEC,uEE);
+  return per_edge_normals(V,F,uEC,uEE,weight,FN,N);
+}
 
-  Eigen::VectorXd W;
-  switch(weighting)
+template <
+  typename DerivedV,
+  typename DerivedF,
+  typename DeriveduEC,
+  typename DeriveduEE,
+  typename DerivedFN,
+  typename DerivedN>
+IGL_INLINE void igl::per_edge_normals(
+  const Eigen::MatrixBase<DerivedV>& V,
+  const Eigen::MatrixBase<DerivedF>& F,
+  const Eigen::MatrixBase<DeriveduEC>& uEC,
+  const Eigen::MatrixBase<DeriveduEE>& uEE,
+  const PerEdgeNormalsWeightingType weight,
+  const Eigen::MatrixBase<DerivedFN>& FN,
+  Eigen::PlainObjectBase<DerivedN> & N)
+{
+  typedef typename DerivedN::Scalar Scalar;
+  assert(F.cols() == 3 && "Faces must be triangles");
+  // number of faces
+  const Eigen::Index m = F.rows();
+  Eigen::Matrix<Scalar,Eigen::Dynamic,1> W;
+  switch(weight)
   {
     case PER_EDGE_NORMALS_WEIGHTING_TYPE_UNIFORM:
-      // Do nothing
+      W.setConstant(m,1);
       break;
     default:
       assert(false && "Unknown weighting type");
@@ -59,23 +74,22 @@ IGL_INLINE void igl::per_edge_normals(
     }
   }
 
-  N.setZero(E.rows(),3);
-  for(int f = 0;f<m;f++)
+  // Gather weighted normals of faces incident on each edge (directed edge e
+  // is on face e%m)
+  const Eigen::Index num_edges = uEC.size()-1;
+  N.resize(num_edges,3);
+  parallel_for(num_edges,[&](const Eigen::Index u)
   {
-    for(int c = 0;c<3;c++)
+    Eigen::Matrix<Scalar,1,3> n(0,0,0);
+    for(Eigen::Index k = uEC(u);k<uEC(u+1);k++)
     {
-      if(weighting == PER_EDGE_NORMALS_WEIGHTING_TYPE_UNIFORM)
-      {
-        N.row(EMAP(f+c*m, 0)) += FN.row(f);
-      }else
-      {
-        N.row(EMAP(f+c*m, 0)) += W(f) * FN.row(f);
-      }
+      const Eigen::Index f = uEE(k)%m;
+      n += W(f) * FN.row(f).template cast<Scalar>();
     }
-  }
- 
-  // take average via normalization
-  N.rowwise().normalize();
+    // take average via normalization
+    n.normalize();
+    N.row(u) = n;
+  },1000ul);
 }
 
 template <
@@ -87,14 +101,14 @@ template <
 IGL_INLINE void igl::per_edge_normals(
   const Eigen::MatrixBase<DerivedV>& V,
   const Eigen::MatrixBase<DerivedF>& F,
-  const PerEdgeNormalsWeightingType weighting,
+  const PerEdgeNormalsWeightingType weight,
   Eigen::PlainObjectBase<DerivedN> & N,
   Eigen::PlainObjectBase<DerivedE> & E,
   Eigen::PlainObjectBase<DerivedEMAP> & EMAP)
 {
   Eigen::Matrix<typename DerivedN::Scalar,Eigen::Dynamic,3> FN;
   per_face_normals(V,F,FN);
-  return per_edge_normals(V,F,weighting,FN,N,E,EMAP);
+  return per_edge_normals(V,F,weight,FN,N,E,EMAP);
 }
 
 template <
@@ -137,4 +151,5 @@ template void igl::per_edge_normals<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Ei
 template void igl::per_edge_normals<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, igl::PerEdgeNormalsWeightingType, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
 template void igl::per_edge_normals<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, igl::PerEdgeNormalsWeightingType, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
 template void igl::per_edge_normals<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
+template void igl::per_edge_normals<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, igl::PerEdgeNormalsWeightingType, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
 #endif
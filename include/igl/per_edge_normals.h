@@ -47,6 +47,34 @@ namespace igl
     Eigen::PlainObjectBase<DerivedN> & N,
     Eigen::PlainObjectBase<DerivedE> & E,
     Eigen::PlainObjectBase<DerivedEMAP> & EMAP);
+  // Inputs:
+  //   uEC  #E+1 list of cumulative counts of directed edges sharing each
+  //     undirected edge
+  //   uEE  #F*3 list of indices into oriented_facets(F), so that
+  //     uEE.segment(uEC(i),uEC(i+1)-uEC(i)) lists all directed edges of
+  //     undirected edge i
+  //
+  // Each edge gathers from its incident faces, so edges are computed in
+  // parallel without write conflicts. Pass the same uEC,uEE for every frame
+  // of an animation to skip rebuilding the edge map (uEC,uEE come before
+  // weight so that this is not confused with the overload above).
+  //
+  // See also: unique_edge_map
+  template <
+    typename DerivedV,
+    typename DerivedF,
+    typename DeriveduEC,
+    typename DeriveduEE,
+    typename DerivedFN,
+    typename DerivedN>
+  IGL_INLINE void per_edge_normals(
+    const Eigen::MatrixBase<DerivedV>& V,
+    const Eigen::MatrixBase<DerivedF>& F,
+    const Eigen::MatrixBase<DeriveduEC>& uEC,
+    const Eigen::MatrixBase<DeriveduEE>& uEE,
+    const PerEdgeNormalsWeightingType weight,
+    const Eigen::MatrixBase<DerivedFN>& FN,
+    Eigen::PlainObjectBase<DerivedN> & N);
   template <
     typename DerivedV, 
     typename DerivedF, 
@@ -12,6 +12,9 @@
 #include "doublearea.h"
 #include "parallel_for.h"
 #include "internal_angles.h"
+#include "vertex_triangle_adjacency.h"
+#include <cassert>
+#include <cstdint>
 
 template <
   typename DerivedV,
@@ -45,12 +48,33 @@ IGL_INLINE void igl::per_vertex_normals(
   const Eigen::MatrixBase<DerivedFN>& FN,
   Eigen::PlainObjectBase<DerivedN> & N)
 {
-  using namespace std;
+  Eigen::Matrix<typename DerivedF::Scalar,Eigen::Dynamic,1> VF,NI;
+  vertex_triangle_adjacency(F,V.rows(),VF,NI);
+  return per_vertex_normals(V,F,weighting,FN,VF,NI,N);
+}
+
+template <
+  typename DerivedV,
+  typename DerivedF,
+  typename DerivedFN,
+  typename DerivedVF,
+  typename DerivedNI,
+  typename DerivedN>
+IGL_INLINE void igl::per_vertex_normals(
+  const Eigen::MatrixBase<DerivedV>& V,
+  const Eigen::MatrixBase<DerivedF>& F,
+  const igl::PerVertexNormalsWeightingType weighting,
+  const Eigen::MatrixBase<DerivedFN>& FN,
+  const Eigen::MatrixBase<DerivedVF>& VF,
+  const Eigen::MatrixBase<DerivedNI>& NI,
+  Eigen::PlainObjectBase<DerivedN> & N)
+{
+  typedef typename DerivedN::Scalar Scalar;
+  assert(NI.size() == V.rows()+1);
   // Resize for output
-  N.setZero(V.rows(),3);
+  N.resize(V.rows(),3);
 
-  Eigen::Matrix<typename DerivedN::Scalar,DerivedF::RowsAtCompileTime,3>
-    W(F.rows(),3);
+  Eigen::Matrix<Scalar,DerivedF::RowsAtCompileTime,3> W(F.rows(),3);
   switch(weighting)
   {
     case PER_VERTEX_NORMALS_WEIGHTING_TYPE_UNIFORM:
@@ -61,7 +85,7 @@ IGL_INLINE void igl::per_vertex_normals(
     case PER_VERTEX_NORMALS_WEIGHTING_TYPE_DEFAULT:
     case PER_VERTEX_NORMALS_WEIGHTING_TYPE_AREA:
     {
-      Eigen::Matrix<typename DerivedN::Scalar,DerivedF::RowsAtCompileTime,1> A;
+      Eigen::Matrix<Scalar,DerivedF::RowsAtCompileTime,1> A;
       doublearea(V,F,A);
       W = A.replicate(1,3);
       break;
@@ -71,37 +95,29 @@ IGL_INLINE void igl::per_vertex_normals(
       break;
   }
 
-  // loop over faces
-  for(int i = 0;i<F.rows();i++)
+  // Gather weighted normals of incident faces. Faces are visited in
+  // increasing order, so sums match accumulating over faces.
+  parallel_for(V.rows(),[&](const Eigen::Index v)
   {
-    // throw normal at each corner
-    for(int j = 0; j < 3;j++)
+    Eigen::Matrix<Scalar,1,3> n(0,0,0);
+    Eigen::Index prev_f = -1;
+    int c = 0;
+    for(Eigen::Index k = NI(v);k<NI(v+1);k++)
     {
-      N.row(F(i,j)) += W(i,j) * FN.row(i);
+      const Eigen::Index f = VF(k);
+      // A combinatorially degenerate face is listed once per corner at v
+      c = f == prev_f ? c+1 : 0;
+      while(F(f,c) != v)
+      {
+        c++;
+      }
+      n += W(f,c) * FN.row(f).template cast<Scalar>();
+      prev_f = f;
     }
-  }
-
-  //// loop over faces
-  //std::mutex critical;
-  //std::vector<DerivedN> NN;
-  //parallel_for(
-  //  F.rows(),
-  //  [&NN,&N](const size_t n){ NN.resize(n,DerivedN::Zero(N.rows(),3));},
-  //  [&F,&W,&FN,&NN,&critical](const int i, const size_t t)
-  //  {
-  //    // throw normal at each corner
-  //    for(int j = 0; j < 3;j++)
-  //    {
-  //      // Q: Does this need to be critical?
-  //      // A: Yes. Different (i,j)'s could produce the same F(i,j)
-  //      NN[t].row(F(i,j)) += W(i,j) * FN.row(i);
-  //    }
-  //  },
-  //  [&N,&NN](const size_t t){ N += NN[t]; },
-  //  1000l);
-
-  // take average via normalization
-  N.rowwise().normalize();
+    // take average via normalization
+    n.normalize();
+    N.row(v) = n;
+  },1000ul);
 }
 
 template <
@@ -136,4 +152,8 @@ template void igl::per_vertex_normals<Eigen::Matrix<double, -1, -1, 0, -1, -1>,
 template void igl::per_vertex_normals<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<double, -1, 3, 0, -1, 3> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, igl::PerVertexNormalsWeightingType, Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> >&);
 template void igl::per_vertex_normals<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, igl::PerVertexNormalsWeightingType, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
 template void igl::per_vertex_normals<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
+template void igl::per_vertex_normals<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, igl::PerVertexNormalsWeightingType, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
+template void igl::per_vertex_normals<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
+template void igl::per_vertex_normals<Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, igl::PerVertexNormalsWeightingType, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> >&);
+template void igl::per_vertex_normals<Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> >&);
 #endif
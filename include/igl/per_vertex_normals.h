@@ -59,6 +59,33 @@ namespace igl
     const PerVertexNormalsWeightingType weighting,
     const Eigen::MatrixBase<DerivedFN>& FN,
     Eigen::PlainObjectBase<DerivedN> & N);
+  // Inputs:
+  //   VF  3*#F list  List of faces indice on each vertex, so that VF(NI(i)+j) =
+  //     f, means that face f is the jth face incident on vertex i (in
+  //     increasing order, as output by vertex_triangle_adjacency)
+  //   NI  #V+1 list  cumulative sum of vertex-triangle degrees with a
+  //     preceeding zero.
+  //
+  // Each vertex gathers from its incident faces, so vertices are computed in
+  // parallel without write conflicts. Pass the same VF,NI for every frame of
+  // an animation to skip rebuilding the adjacency.
+  //
+  // See also: vertex_triangle_adjacency
+  template <
+    typename DerivedV,
+    typename DerivedF,
+    typename DerivedFN,
+    typename DerivedVF,
+    typename DerivedNI,
+    typename DerivedN>
+  IGL_INLINE void per_vertex_normals(
+    const Eigen::MatrixBase<DerivedV>& V,
+    const Eigen::MatrixBase<DerivedF>& F,
+    const PerVertexNormalsWeightingType weighting,
+    const Eigen::MatrixBase<DerivedFN>& FN,
+    const Eigen::MatrixBase<DerivedVF>& VF,
+    const Eigen::MatrixBase<DerivedNI>& NI,
+    Eigen::PlainObjectBase<DerivedN> & N);
   // Without weighting
   template <
     typename DerivedV, 
@@ -7,21 +7,17 @@
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "principal_curvature.h"
 #include <iostream>
-#include <fstream>
-#include <iomanip>
-#include <iostream>
-#include <queue>
-#include <list>
+#include <algorithm>
 #include <cmath>
+#include <cstdio>
 #include <limits>
-
-#include <Eigen/SparseCholesky>
+#include <utility>
+#include <vector>
 
 // Lib IGL includes
-#include <igl/adjacency_list.h>
+#include <igl/parallel_for.h>
 #include <igl/per_face_normals.h>
 #include <igl/per_vertex_normals.h>
-#include <igl/avg_edge_length.h>
 #include <igl/vertex_triangle_adjacency.h>
 
 typedef enum
@@ -39,15 +35,6 @@ typedef enum
 class CurvatureCalculator
 {
 public:
-  /* Row number i represents the i-th vertex, whose columns are:
-   curv[i][0] : K1
-   curv[i][1] : K2
-   curvDir[i][0] : PD1
-   curvDir[i][1] : PD2
-   */
-  std::vector< std::vector<double> > curv;
-  std::vector< std::vector<Eigen::Vector3d> > curvDir;
-  bool curvatureComputed;
   class Quadric
   {
   public:
@@ -104,53 +91,81 @@ public:
       return 2.0*c();
     }
 
-
-    IGL_INLINE static Quadric fit(const std::vector<Eigen::Vector3d> &VV)
+    // Least squares fit of z = a*u*u + b*u*v + c*v*v + d*u + e*v to points
+    // (u,v,z) added one at a time. Each point is rotated (Givens) into the
+    // triangular factor R of a QR decomposition of the #points by 5 system,
+    // so nothing is allocated no matter how many points are added.
+    class Fit
     {
-      assert(VV.size() >= 5);
-      if (VV.size() < 5)
+    public:
+      // 5 by 5 upper triangular factor with Q'*z in the last column
+      Eigen::Matrix<double,5,6> R;
+
+      IGL_INLINE Fit()
       {
-        std::cerr << "ASSERT FAILED! fit function requires at least 5 points: Only " << VV.size() << " were given." << std::endl;
-        exit(0);
+        R.setZero();
       }
 
-      Eigen::MatrixXd A(VV.size(),5);
-      Eigen::MatrixXd b(VV.size(),1);
-      Eigen::MatrixXd sol(5,1);
-
-      for(unsigned int c=0; c < VV.size(); ++c)
+      IGL_INLINE void add(double u, double v, double z)
       {
-        double u = VV[c][0];
-        double v = VV[c][1];
-        double n = VV[c][2];
-
-        A(c,0) = u*u;
-        A(c,1) = u*v;
-        A(c,2) = v*v;
-        A(c,3) = u;
-        A(c,4) = v;
-
-        b(c) = n;
+        double r[6] = {u*u, u*v, v*v, u, v, z};
+        for (int k = 0; k < 5; ++k)
+        {
+          if (r[k] == 0)
+            continue;
+          const double rho = std::sqrt(R(k,k)*R(k,k) + r[k]*r[k]);
+          const double c = R(k,k)/rho;
+          const double s = r[k]/rho;
+          for (int j = k; j < 6; ++j)
+          {
+            const double Rkj = R(k,j);
+            R(k,j) = c*Rkj + s*r[j];
+            r[j] = c*r[j] - s*Rkj;
+          }
+        }
       }
 
-      sol=A.jacobiSvd(Eigen::ComputeThinU | Eigen::ComputeThinV).solve(b);
+      IGL_INLINE Quadric solve() const
+      {
+        // R spans the same rows as the full system, so this is the same
+        // (minimum norm) least squares solution as for the full system
+        const Eigen::Matrix<double,5,5> R5 = R.leftCols<5>();
+        const Eigen::Matrix<double,5,1> sol =
+          Eigen::CompleteOrthogonalDecomposition<Eigen::Matrix<double,5,5> >(
+            R5).solve(R.col(5));
+        return Quadric(sol(0),sol(1),sol(2),sol(3),sol(4));
+      }
+    };
+  };
 
-      return Quadric(sol(0),sol(1),sol(2),sol(3),sol(4));
-    }
+  // Buffers reused across the vertices handled by one thread
+  class Scratch
+  {
+  public:
+    std::vector<int> vv;
+    std::vector<int> vvtmp;
+    // mark[j] == i iff vertex j was reached by the search around vertex i
+    std::vector<int> mark;
+    std::vector<std::pair<int, double> > extra_candidates;
   };
 
 public:
 
-  Eigen::MatrixXd vertices;
-  // Face list of current mesh    (#F x 3) or (#F x 4)
+  Eigen::Matrix<double,Eigen::Dynamic,3,Eigen::RowMajor> vertices;
+  // Face list of current mesh    (#F x 3)
   // The i-th row contains the indices of the vertices that forms the i-th face in ccw order
-  Eigen::MatrixXi faces;
-
-  std::vector<std::vector<int> > vertex_to_vertices;
-  std::vector<std::vector<int> > vertex_to_faces;
-  std::vector<std::vector<int> > vertex_to_faces_index;
-  Eigen::MatrixXd face_normals;
-  Eigen::MatrixXd vertex_normals;
+  Eigen::Matrix<int,Eigen::Dynamic,3,Eigen::RowMajor> faces;
+
+  // Neighbors of vertex i (sorted) are
+  // vertex_to_vertices(vertex_to_vertices_index(i)) ...
+  // vertex_to_vertices(vertex_to_vertices_index(i+1)-1), and likewise for
+  // incident faces
+  Eigen::VectorXi vertex_to_vertices;
+  Eigen::VectorXi vertex_to_vertices_index;
+  Eigen::VectorXi vertex_to_faces;
+  Eigen::VectorXi vertex_to_faces_index;
+  Eigen::Matrix<double,Eigen::Dynamic,3,Eigen::RowMajor> face_normals;
+  Eigen::Matrix<double,Eigen::Dynamic,3,Eigen::RowMajor> vertex_normals;
 
   /* Size of the neighborhood */
   double sphereRadius;
@@ -158,36 +173,25 @@ public:
 
   bool localMode; /* Use local mode */
   bool projectionPlaneCheck; /* Check collected vertices on tangent plane */
-  bool montecarlo;
-  unsigned int montecarloN;
 
   searchType st; /* Use either a sphere search or a k-ring search */
   normalType nt;
 
-  double lastRadius;
   double scaledRadius;
-  std::string lastMeshName;
-
-  /* Benchmark related variables */
-  bool expStep; /* True if we want the radius to increase exponentially */
-  int step;  /* If expStep==false, by how much rhe radius increases on every step */
-  int maxSize; /* The maximum limit of the radius in the benchmark */
 
   IGL_INLINE CurvatureCalculator();
   IGL_INLINE void init(const Eigen::MatrixXd& V, const Eigen::MatrixXi& F);
 
-  IGL_INLINE void finalEigenStuff(int, const std::vector<Eigen::Vector3d>&, Quadric&);
-  IGL_INLINE void fitQuadric(const Eigen::Vector3d&, const std::vector<Eigen::Vector3d>& ref, const std::vector<int>& , Quadric *);
+  IGL_INLINE void finalEigenStuff(const Eigen::Matrix3d&, Quadric&, double&, double&, Eigen::Vector3d&, Eigen::Vector3d&);
+  IGL_INLINE void fitQuadric(const Eigen::Vector3d&, const Eigen::Matrix3d& ref, const std::vector<int>& , Quadric *);
   IGL_INLINE void applyProjOnPlane(const Eigen::Vector3d&, const std::vector<int>&, std::vector<int>&);
-  IGL_INLINE void getSphere(const int, const double, std::vector<int>&, int min);
-  IGL_INLINE void getKRing(const int, const double,std::vector<int>&);
+  IGL_INLINE void getSphere(const int, const double, std::vector<int>&, int min, Scratch&);
+  IGL_INLINE void getKRing(const int, const double,std::vector<int>&, Scratch&);
   IGL_INLINE Eigen::Vector3d project(const Eigen::Vector3d&, const Eigen::Vector3d&, const Eigen::Vector3d&);
-  IGL_INLINE void computeReferenceFrame(int, const Eigen::Vector3d&, std::vector<Eigen::Vector3d>&);
+  IGL_INLINE void computeReferenceFrame(int, const Eigen::Vector3d&, Eigen::Matrix3d&);
   IGL_INLINE void getAverageNormal(int, const std::vector<int>&, Eigen::Vector3d&);
   IGL_INLINE void getProjPlane(int, const std::vector<int>&, Eigen::Vector3d&);
-  IGL_INLINE void applyMontecarlo(const std::vector<int>&,std::vector<int>*);
-  IGL_INLINE void computeCurvature();
-  IGL_INLINE void printCurvature(const std::string& outpath);
+  IGL_INLINE bool computeCurvature(int, Scratch&, double&, double&, Eigen::Vector3d&, Eigen::Vector3d&);
   IGL_INLINE double getAverageEdge();
 
   IGL_INLINE static int rotateForward (double *v0, double *v1, double *v2)
@@ -308,58 +312,87 @@ IGL_INLINE CurvatureCalculator::CurvatureCalculator()
   this->sphereRadius=5;
   this->st=SPHERE_SEARCH;
   this->nt=AVERAGE;
-  this->montecarlo=false;
-  this->montecarloN=0;
   this->kRing=3;
-  this->curvatureComputed=false;
-  this->expStep=true;
 }
 
 IGL_INLINE void CurvatureCalculator::init(const Eigen::MatrixXd& V, const Eigen::MatrixXi& F)
 {
-  // Normalize vertices
   vertices = V;
-
-//  vertices = vertices.array() - vertices.minCoeff();
-//  vertices = vertices.array() / vertices.maxCoeff();
-//  vertices = vertices.array() * (1.0/igl::avg_edge_length(V,F));
-
   faces = F;
-  igl::adjacency_list(F, vertex_to_vertices);
-  igl::vertex_triangle_adjacency(V, F, vertex_to_faces, vertex_to_faces_index);
-  igl::per_face_normals(V, F, face_normals);
-  igl::per_vertex_normals(V, F, face_normals, vertex_normals);
+  const int n = V.rows();
+  igl::vertex_triangle_adjacency(F, n, vertex_to_faces, vertex_to_faces_index);
+
+  // Sorted, duplicate free neighbors of each vertex (as adjacency_list),
+  // gathered from the two other corners of each incident face
+  Eigen::VectorXi buffer(2*vertex_to_faces.size());
+  Eigen::VectorXi count(n);
+  igl::parallel_for(n,[&](const int i)
+  {
+    int * begin = buffer.data() + 2*vertex_to_faces_index(i);
+    int * end = begin;
+    for (int k=vertex_to_faces_index(i); k<vertex_to_faces_index(i+1); ++k)
+    {
+      const int f = vertex_to_faces(k);
+      int c = 0;
+      while (faces(f,c) != i)
+        ++c;
+      *(end++) = faces(f,(c+1)%3);
+      *(end++) = faces(f,(c+2)%3);
+    }
+    std::sort(begin,end);
+    count(i) = std::unique(begin,end) - begin;
+  },1000ul);
+  vertex_to_vertices_index.resize(n+1);
+  vertex_to_vertices_index(0) = 0;
+  for (int i=0; i<n; ++i)
+    vertex_to_vertices_index(i+1) = vertex_to_vertices_index(i) + count(i);
+  vertex_to_vertices.resize(vertex_to_vertices_index(n));
+  igl::parallel_for(n,[&](const int i)
+  {
+    std::copy(
+      buffer.data() + 2*vertex_to_faces_index(i),
+      buffer.data() + 2*vertex_to_faces_index(i) + count(i),
+      vertex_to_vertices.data() + vertex_to_vertices_index(i));
+  },1000ul);
+
+  Eigen::MatrixXd FN,N;
+  igl::per_face_normals(V, F, FN);
+  igl::per_vertex_normals(
+    V, F, igl::PER_VERTEX_NORMALS_WEIGHTING_TYPE_DEFAULT, FN,
+    vertex_to_faces, vertex_to_faces_index, N);
+  face_normals = FN;
+  vertex_normals = N;
 }
 
-IGL_INLINE void CurvatureCalculator::fitQuadric(const Eigen::Vector3d& v, const std::vector<Eigen::Vector3d>& ref, const std::vector<int>& vv, Quadric *q)
+IGL_INLINE void CurvatureCalculator::fitQuadric(const Eigen::Vector3d& v, const Eigen::Matrix3d& ref, const std::vector<int>& vv, Quadric *q)
 {
-  std::vector<Eigen::Vector3d> points;
-  points.reserve (vv.size());
-
-  for (unsigned int i = 0; i < vv.size(); ++i) {
-
-    Eigen::Vector3d  cp = vertices.row(vv[i]);
-
-    // vtang non e` il v tangente!!!
-    Eigen::Vector3d  vTang = cp - v;
-
-    double x = vTang.dot(ref[0]);
-    double y = vTang.dot(ref[1]);
-    double z = vTang.dot(ref[2]);
-    points.push_back(Eigen::Vector3d (x,y,z));
-  }
-  if (points.size() < 5)
+  if (vv.size() < 5)
   {
-    std::cerr << "ASSERT FAILED! fit function requires at least 5 points: Only " << points.size() << " were given." << std::endl;
+    std::cerr << "ASSERT FAILED! fit function requires at least 5 points: Only " << vv.size() << " were given." << std::endl;
     *q = Quadric(0,0,0,0,0);
+    return;
   }
-  else
+
+  Quadric::Fit fit;
+  for (unsigned int i = 0; i < vv.size(); ++i)
   {
-    *q = Quadric::fit (points);
+    const Eigen::Vector3d cp = vertices.row(vv[i]);
+
+    // vtang non e` il v tangente!!!
+    const Eigen::Vector3d vTang = cp - v;
+
+    fit.add(vTang.dot(ref.col(0)), vTang.dot(ref.col(1)), vTang.dot(ref.col(2)));
   }
+  *q = fit.solve();
 }
 
-IGL_INLINE void CurvatureCalculator::finalEigenStuff(int i, const std::vector<Eigen::Vector3d>& ref, Quadric& q)
+IGL_INLINE void CurvatureCalculator::finalEigenStuff(
+  const Eigen::Matrix3d& ref,
+  Quadric& q,
+  double& k1,
+  double& k2,
+  Eigen::Vector3d& d1,
+  Eigen::Vector3d& d2)
 {
 
   const double a = q.a();
@@ -368,11 +401,6 @@ IGL_INLINE void CurvatureCalculator::finalEigenStuff(int i, const std::vector<Ei
   const double d = q.d();
   const double e = q.e();
 
-//  if (fabs(a) < 10e-8 || fabs(b) < 10e-8)
-//  {
-//    std::cout << "Degenerate quadric: " << i << std::endl;
-//  }
-
   double E = 1.0 + d*d;
   double F = d*e;
   double G = 1.0 + e*e;
@@ -393,11 +421,6 @@ IGL_INLINE void CurvatureCalculator::finalEigenStuff(int i, const std::vector<Ei
   Eigen::Vector2d c_val = eig.eigenvalues();
   Eigen::Matrix2d c_vec = eig.eigenvectors();
 
-  // std::cerr << "c_val:" << c_val << std::endl;
-  // std::cerr << "c_vec:" << c_vec << std::endl;
-
-  // std::cerr << "c_vec:" << c_vec(0) << " "  << c_vec(1) << std::endl;
-
   c_val = -c_val;
 
   Eigen::Vector3d v1, v2;
@@ -409,12 +432,8 @@ IGL_INLINE void CurvatureCalculator::finalEigenStuff(int i, const std::vector<Ei
   v2[1] = c_vec(3);
   v2[2] = 0; //d * v2[0] + e * v2[1];
 
-
-  // v1 = v1.normalized();
-  // v2 = v2.normalized();
-
-  Eigen::Vector3d v1global = ref[0] * v1[0] + ref[1] * v1[1] + ref[2] * v1[2];
-  Eigen::Vector3d v2global = ref[0] * v2[0] + ref[1] * v2[1] + ref[2] * v2[2];
+  Eigen::Vector3d v1global = ref * v1;
+  Eigen::Vector3d v2global = ref * v2;
 
   v1global.normalize();
   v2global.normalize();
@@ -424,99 +443,95 @@ IGL_INLINE void CurvatureCalculator::finalEigenStuff(int i, const std::vector<Ei
 
   if (c_val[0] > c_val[1])
   {
-    curv[i]=std::vector<double>(2);
-    curv[i][0]=c_val(0);
-    curv[i][1]=c_val(1);
-    curvDir[i]=std::vector<Eigen::Vector3d>(2);
-    curvDir[i][0]=v1global;
-    curvDir[i][1]=v2global;
+    k1=c_val(0);
+    k2=c_val(1);
+    d1=v1global;
+    d2=v2global;
   }
   else
   {
-    curv[i]=std::vector<double>(2);
-    curv[i][0]=c_val(1);
-    curv[i][1]=c_val(0);
-    curvDir[i]=std::vector<Eigen::Vector3d>(2);
-    curvDir[i][0]=v2global;
-    curvDir[i][1]=v1global;
+    k1=c_val(1);
+    k2=c_val(0);
+    d1=v2global;
+    d2=v1global;
   }
   // ---- end Eigen stuff
 }
 
-IGL_INLINE void CurvatureCalculator::getKRing(const int start, const double r, std::vector<int>&vv)
+IGL_INLINE void CurvatureCalculator::getKRing(const int start, const double r, std::vector<int>&vv, Scratch& s)
 {
-  int bufsize=vertices.rows();
-  vv.reserve(bufsize);
-  std::list<std::pair<int,int> > queue;
-  std::vector<bool> visited(bufsize, false);
-  queue.push_back(std::pair<int,int>(start,0));
-  visited[start]=true;
-  while (!queue.empty())
+  // Breadth first search, one ring at a time: vv doubles as the queue
+  std::vector<int>& mark = s.mark;
+  vv.push_back(start);
+  mark[start]=start;
+  size_t ring_begin=0;
+  for (int distance=0; distance<(int)r && ring_begin<vv.size(); ++distance)
   {
-    int toVisit=queue.front().first;
-    int distance=queue.front().second;
-    queue.pop_front();
-    vv.push_back(toVisit);
-    if (distance<(int)r)
+    const size_t ring_end=vv.size();
+    for (size_t q=ring_begin; q<ring_end; ++q)
     {
-      for (unsigned int i=0; i<vertex_to_vertices[toVisit].size(); ++i)
+      const int toVisit=vv[q];
+      for (int k=vertex_to_vertices_index(toVisit); k<vertex_to_vertices_index(toVisit+1); ++k)
       {
-        int neighbor=vertex_to_vertices[toVisit][i];
-        if (!visited[neighbor])
+        const int neighbor=vertex_to_vertices(k);
+        if (mark[neighbor]!=start)
         {
-          queue.push_back(std::pair<int,int> (neighbor,distance+1));
-          visited[neighbor]=true;
+          vv.push_back(neighbor);
+          mark[neighbor]=start;
         }
       }
     }
+    ring_begin=ring_end;
   }
 }
 
 
-IGL_INLINE void CurvatureCalculator::getSphere(const int start, const double r, std::vector<int> &vv, int min)
+IGL_INLINE void CurvatureCalculator::getSphere(const int start, const double r, std::vector<int> &vv, int min, Scratch& s)
 {
-  int bufsize=vertices.rows();
-  vv.reserve(bufsize);
-  std::list<int> queue;
-  std::vector<bool> visited(bufsize, false);
-  queue.push_back(start);
-  visited[start]=true;
-  Eigen::Vector3d me=vertices.row(start);
-  std::priority_queue<std::pair<int, double>, std::vector<std::pair<int, double> >, comparer > extra_candidates;
-  while (!queue.empty())
+  // vv doubles as the queue: vv[0] ... vv[head-1] have been visited
+  std::vector<int>& mark = s.mark;
+  std::vector<std::pair<int, double> >& extra_candidates = s.extra_candidates;
+  extra_candidates.clear();
+  vv.push_back(start);
+  mark[start]=start;
+  const Eigen::Vector3d me=vertices.row(start);
+  for (size_t head=0; head<vv.size();)
   {
-    int toVisit=queue.front();
-    queue.pop_front();
-    vv.push_back(toVisit);
-    for (unsigned int i=0; i<vertex_to_vertices[toVisit].size(); ++i)
+    const int toVisit=vv[head++];
+    for (int k=vertex_to_vertices_index(toVisit); k<vertex_to_vertices_index(toVisit+1); ++k)
     {
-      int neighbor=vertex_to_vertices[toVisit][i];
-      if (!visited[neighbor])
+      const int neighbor=vertex_to_vertices(k);
+      if (mark[neighbor]!=start)
       {
-        Eigen::Vector3d neigh=vertices.row(neighbor);
+        const Eigen::Vector3d neigh=vertices.row(neighbor);
         double distance=(me-neigh).norm();
         if (distance<r)
-          queue.push_back(neighbor);
-        else if ((int)vv.size()<min)
-          extra_candidates.push(std::pair<int,double>(neighbor,distance));
-        visited[neighbor]=true;
+          vv.push_back(neighbor);
+        else if ((int)head<min)
+        {
+          extra_candidates.push_back(std::pair<int,double>(neighbor,distance));
+          std::push_heap(extra_candidates.begin(),extra_candidates.end(),comparer());
+        }
+        mark[neighbor]=start;
       }
     }
   }
   while (!extra_candidates.empty() && (int)vv.size()<min)
   {
-    std::pair<int, double> cand=extra_candidates.top();
-    extra_candidates.pop();
+    std::pop_heap(extra_candidates.begin(),extra_candidates.end(),comparer());
+    const std::pair<int, double> cand=extra_candidates.back();
+    extra_candidates.pop_back();
     vv.push_back(cand.first);
-    for (unsigned int i=0; i<vertex_to_vertices[cand.first].size(); ++i)
+    for (int k=vertex_to_vertices_index(cand.first); k<vertex_to_vertices_index(cand.first+1); ++k)
     {
-      int neighbor=vertex_to_vertices[cand.first][i];
-      if (!visited[neighbor])
+      const int neighbor=vertex_to_vertices(k);
+      if (mark[neighbor]!=start)
       {
-        Eigen::Vector3d neigh=vertices.row(neighbor);
+        const Eigen::Vector3d neigh=vertices.row(neighbor);
         double distance=(me-neigh).norm();
-        extra_candidates.push(std::pair<int,double>(neighbor,distance));
-        visited[neighbor]=true;
+        extra_candidates.push_back(std::pair<int,double>(neighbor,distance));
+        std::push_heap(extra_candidates.begin(),extra_candidates.end(),comparer());
+        mark[neighbor]=start;
       }
     }
   }
@@ -527,19 +542,19 @@ IGL_INLINE Eigen::Vector3d CurvatureCalculator::project(const Eigen::Vector3d& v
   return (vp - (ppn * ((vp - v).dot(ppn))));
 }
 
-IGL_INLINE void CurvatureCalculator::computeReferenceFrame(int i, const Eigen::Vector3d& normal, std::vector<Eigen::Vector3d>& ref )
+IGL_INLINE void CurvatureCalculator::computeReferenceFrame(int i, const Eigen::Vector3d& normal, Eigen::Matrix3d& ref )
 {
 
-  Eigen::Vector3d longest_v=Eigen::Vector3d(vertices.row(vertex_to_vertices[i][0]));
+  Eigen::Vector3d longest_v=Eigen::Vector3d(vertices.row(vertex_to_vertices(vertex_to_vertices_index(i))));
 
   longest_v=(project(vertices.row(i),longest_v,normal)-Eigen::Vector3d(vertices.row(i))).normalized();
 
   /* L'ultimo asse si ottiene come prodotto vettoriale tra i due
    * calcolati */
   Eigen::Vector3d y_axis=(normal.cross(longest_v)).normalized();
-  ref[0]=longest_v;
-  ref[1]=y_axis;
-  ref[2]=normal;
+  ref.col(0)=longest_v;
+  ref.col(1)=y_axis;
+  ref.col(2)=normal;
 }
 
 IGL_INLINE void CurvatureCalculator::getAverageNormal(int j, const std::vector<int>& vv, Eigen::Vector3d& normal)
@@ -566,9 +581,9 @@ IGL_INLINE void CurvatureCalculator::getProjPlane(int j, const std::vector<int>&
 
   if (localMode)
   {
-    for (unsigned int i=0; i<vertex_to_faces.at(j).size(); ++i)
+    for (int k=vertex_to_faces_index(j); k<vertex_to_faces_index(j+1); ++k)
     {
-      Eigen::Vector3d faceNormal=face_normals.row(vertex_to_faces.at(j).at(i));
+      Eigen::Vector3d faceNormal=face_normals.row(vertex_to_faces(k));
       a += faceNormal[0];
       b += faceNormal[1];
       c += faceNormal[2];
@@ -622,150 +637,73 @@ IGL_INLINE double CurvatureCalculator::getAverageEdge()
 IGL_INLINE void CurvatureCalculator::applyProjOnPlane(const Eigen::Vector3d& ppn, const std::vector<int>& vin, std::vector<int> &vout)
 {
   for (std::vector<int>::const_iterator vpi = vin.begin(); vpi != vin.end(); ++vpi)
-    if (vertex_normals.row(*vpi) * ppn > 0.0)
+    if (vertex_normals.row(*vpi).dot(ppn) > 0.0)
       vout.push_back(*vpi);
 }
 
-IGL_INLINE void CurvatureCalculator::applyMontecarlo(const std::vector<int>& vin, std::vector<int> *vout)
+IGL_INLINE bool CurvatureCalculator::computeCurvature(
+  int i,
+  Scratch& s,
+  double& k1,
+  double& k2,
+  Eigen::Vector3d& d1,
+  Eigen::Vector3d& d2)
 {
-  if (montecarloN >= vin.size ())
+  std::vector<int>& vv = s.vv;
+  std::vector<int>& vvtmp = s.vvtmp;
+  vv.clear();
+  vvtmp.clear();
+  if (s.mark.empty())
+    s.mark.resize(vertices.rows(),-1);
+
+  Eigen::Vector3d me=vertices.row(i);
+  switch (st)
   {
-    *vout = vin;
-    return;
+    case SPHERE_SEARCH:
+      getSphere(i,scaledRadius,vv,6,s);
+      break;
+    case K_RING_SEARCH:
+      getKRing(i,kRing,vv,s);
+      break;
+    default:
+      fprintf(stderr,"Error: search type not recognized");
+      return false;
   }
 
-  float p = ((float) montecarloN) / (float) vin.size();
-  for (std::vector<int>::const_iterator vpi = vin.begin(); vpi != vin.end(); ++vpi)
+  if (vv.size()<6)
   {
-    float r;
-    if ((r = ((float)rand () / RAND_MAX)) < p)
-    {
-      vout->push_back(*vpi);
-    }
+    //std::cerr << "Could not compute curvature of radius " << scaledRadius << std::endl;
+    return false;
   }
-}
-
-IGL_INLINE void CurvatureCalculator::computeCurvature()
-{
-  //CHECK che esista la mesh
-  const size_t vertices_count=vertices.rows();
-
-  if (vertices_count ==0)
-    return;
-
-  curvDir=std::vector< std::vector<Eigen::Vector3d> >(vertices_count);
-  curv=std::vector<std::vector<double> >(vertices_count);
-
-
 
-  scaledRadius=getAverageEdge()*sphereRadius;
-
-  std::vector<int> vv;
-  std::vector<int> vvtmp;
-  Eigen::Vector3d normal;
-
-  //double time_spent;
-  //double searchtime=0, ref_time=0, fit_time=0, final_time=0;
-
-  for (size_t i=0; i<vertices_count; ++i)
+  if (projectionPlaneCheck)
   {
-    vv.clear();
-    vvtmp.clear();
-    Eigen::Vector3d me=vertices.row(i);
-    switch (st)
-    {
-      case SPHERE_SEARCH:
-        getSphere(i,scaledRadius,vv,6);
-        break;
-      case K_RING_SEARCH:
-        getKRing(i,kRing,vv);
-        break;
-      default:
-        fprintf(stderr,"Error: search type not recognized");
-        return;
-    }
-
-    if (vv.size()<6)
-    {
-      //std::cerr << "Could not compute curvature of radius " << scaledRadius << std::endl;
-      continue;
-    }
-
-
-    if (projectionPlaneCheck)
-    {
-      vvtmp.reserve (vv.size ());
-      applyProjOnPlane (vertex_normals.row(i), vv, vvtmp);
-      if (vvtmp.size() >= 6 && vvtmp.size()<vv.size())
-        vv = vvtmp;
-    }
-
-
-    switch (nt)
-    {
-      case AVERAGE:
-        getAverageNormal(i,vv,normal);
-        break;
-      case PROJ_PLANE:
-        getProjPlane(i,vv,normal);
-        break;
-      default:
-        fprintf(stderr,"Error: normal type not recognized");
-        return;
-    }
-    if (vv.size()<6)
-    {
-      //std::cerr << "Could not compute curvature of radius " << scaledRadius << std::endl;
-      continue;
-    }
-    if (montecarlo)
-    {
-      if(montecarloN<6)
-        break;
-      vvtmp.reserve(vv.size());
-      applyMontecarlo(vv,&vvtmp);
-      vv=vvtmp;
-    }
-
-    if (vv.size()<6)
-      return;
-    std::vector<Eigen::Vector3d> ref(3);
-    computeReferenceFrame(i,normal,ref);
-
-    Quadric q;
-    fitQuadric (me, ref, vv, &q);
-    finalEigenStuff(i,ref,q);
-  }
-
-  lastRadius=sphereRadius;
-  curvatureComputed=true;
-}
-
-IGL_INLINE void CurvatureCalculator::printCurvature(const std::string& outpath)
-{
-  using namespace std;
-  if (!curvatureComputed)
-    return;
-
-  std::ofstream of;
-  of.open(outpath.c_str());
-
-  if (!of)
-  {
-    fprintf(stderr, "Error: could not open output file %s\n", outpath.c_str());
-    return;
+    applyProjOnPlane (vertex_normals.row(i), vv, vvtmp);
+    if (vvtmp.size() >= 6 && vvtmp.size()<vv.size())
+      vv.swap(vvtmp);
   }
 
-  int vertices_count=vertices.rows();
-  of << vertices_count << endl;
-  for (int i=0; i<vertices_count; ++i)
+  Eigen::Vector3d normal;
+  switch (nt)
   {
-    of << curv[i][0] << " " << curv[i][1] << " " << curvDir[i][0][0] << " " << curvDir[i][0][1] << " " << curvDir[i][0][2] << " " <<
-    curvDir[i][1][0] << " " << curvDir[i][1][1] << " " << curvDir[i][1][2] << endl;
+    case AVERAGE:
+      getAverageNormal(i,vv,normal);
+      break;
+    case PROJ_PLANE:
+      getProjPlane(i,vv,normal);
+      break;
+    default:
+      fprintf(stderr,"Error: normal type not recognized");
+      return false;
   }
 
-  of.close();
+  Eigen::Matrix3d ref;
+  computeReferenceFrame(i,normal,ref);
 
+  Quadric q;
+  fitQuadric (me, ref, vv, &q);
+  finalEigenStuff(ref,q,k1,k2,d1,d2);
+  return true;
 }
 
 template <
@@ -812,46 +750,55 @@ IGL_INLINE void igl::principal_curvature(
     cc.kRing = radius;
     cc.st = K_RING_SEARCH;
   }
-
-  // Compute
-  cc.computeCurvature();
-
-  // Copy it back
-  for (unsigned i=0; i<V.rows(); ++i)
+  else
   {
-    if (!cc.curv[i].empty())
-    {
-      PD1.row(i) << cc.curvDir[i][0][0], cc.curvDir[i][0][1], cc.curvDir[i][0][2];
-      PD2.row(i) << cc.curvDir[i][1][0], cc.curvDir[i][1][1], cc.curvDir[i][1][2];
-      PD1.row(i).normalize();
-      PD2.row(i).normalize();
+    cc.scaledRadius = cc.getAverageEdge()*cc.sphereRadius;
+  }
 
-      if (std::isnan(PD1(i,0)) || std::isnan(PD1(i,1)) || std::isnan(PD1(i,2)) || std::isnan(PD2(i,0)) || std::isnan(PD2(i,1)) || std::isnan(PD2(i,2)))
+  // Compute each vertex independently and write it straight into the output
+  std::vector<CurvatureCalculator::Scratch> scratch;
+  std::vector<char> bad(V.rows(),0);
+  igl::parallel_for(
+    V.rows(),
+    [&scratch](const size_t nthreads){ scratch.resize(nthreads); },
+    [&](const Eigen::Index i, const size_t t)
+    {
+      double k1 = 0, k2 = 0;
+      Eigen::Vector3d d1(0,0,0), d2(0,0,0);
+      if (cc.computeCurvature(i,scratch[t],k1,k2,d1,d2))
       {
-        PD1.row(i) << 0,0,0;
-        PD2.row(i) << 0,0,0;
-      }
+        d1.normalize();
+        d2.normalize();
 
-      PV1(i) = cc.curv[i][0];
-      PV2(i) = cc.curv[i][1];
+        if (std::isnan(d1(0)) || std::isnan(d1(1)) || std::isnan(d1(2)) || std::isnan(d2(0)) || std::isnan(d2(1)) || std::isnan(d2(2)))
+        {
+          d1.setZero();
+          d2.setZero();
+        }
 
-      if (PD1.row(i) * PD2.row(i).transpose() > 10e-6)
-      {
-        bad_vertices.push_back((Index)i);
+        if (d1.dot(d2) > 10e-6)
+        {
+          bad[i] = 1;
 
-        PD1.row(i) *= 0;
-        PD2.row(i) *= 0;
+          d1.setZero();
+          d2.setZero();
+        }
+      } else {
+        bad[i] = 1;
       }
-    } else {
+      PD1.row(i) = d1.transpose().template cast<typename DerivedPD1::Scalar>();
+      PD2.row(i) = d2.transpose().template cast<typename DerivedPD2::Scalar>();
+      PV1(i) = k1;
+      PV2(i) = k2;
+    },
+    [](const size_t){},
+    1000ul);
+
+  for (Eigen::Index i=0; i<V.rows(); ++i)
+  {
+    if (bad[i])
       bad_vertices.push_back((Index)i);
-
-      PV1(i) = 0;
-      PV2(i) = 0;
-      PD1.row(i) << 0,0,0;
-      PD2.row(i) << 0,0,0;
-    }
   }
-
 }
 
 template <
@@ -871,59 +818,9 @@ IGL_INLINE void igl::principal_curvature(
   unsigned radius,
   bool useKring)
 {
-  if (radius < 2)
-  {
-    radius = 2;
-    std::cout << "WARNING: igl::principal_curvature needs a radius >= 2, fixing it to 2." << std::endl;
-  }
-
-  // Preallocate memory
-  PD1.resize(V.rows(),3);
-  PD2.resize(V.rows(),3);
-
-  // Preallocate memory
-  PV1.resize(V.rows(),1);
-  PV2.resize(V.rows(),1);
-
-  // Precomputation
-  CurvatureCalculator cc;
-  cc.init(V.template cast<double>(),F.template cast<int>());
-  cc.sphereRadius = radius;
-
-  if (useKring)
-  {
-    cc.kRing = radius;
-    cc.st = K_RING_SEARCH;
-  }
-
-  // Compute
-  cc.computeCurvature();
-
-  // Copy it back
-  for (unsigned i=0; i<V.rows(); ++i)
-  {
-    PD1.row(i) << cc.curvDir[i][0][0], cc.curvDir[i][0][1], cc.curvDir[i][0][2];
-    PD2.row(i) << cc.curvDir[i][1][0], cc.curvDir[i][1][1], cc.curvDir[i][1][2];
-    PD1.row(i).normalize();
-    PD2.row(i).normalize();
-
-    if (std::isnan(PD1(i,0)) || std::isnan(PD1(i,1)) || std::isnan(PD1(i,2)) || std::isnan(PD2(i,0)) || std::isnan(PD2(i,1)) || std::isnan(PD2(i,2)))
-    {
-      PD1.row(i) << 0,0,0;
-      PD2.row(i) << 0,0,0;
-    }
-
-    PV1(i) = cc.curv[i][0];
-    PV2(i) = cc.curv[i][1];
-
-    if (PD1.row(i) * PD2.row(i).transpose() > 10e-6)
-    {
-      std::cerr << "PRINCIPAL_CURVATURE: Something is wrong with vertex: " << i << std::endl;
-      PD1.row(i) *= 0;
-      PD2.row(i) *= 0;
-    }
-  }
-
+  std::vector<int> bad_vertices;
+  return principal_curvature(
+    V,F,PD1,PD2,PV1,PV2,bad_vertices,radius,useKring);
 }
 
 #ifdef IGL_STATIC_LIBRARY
@@ -38,7 +38,11 @@ namespace igl
   //   PV2 #V by 1 minimal curvature value for each vertex.
   //
   // Return value:
-  //   Function returns vector of indices of bad vertices if any.
+  //   Function returns vector of indices of bad vertices if any. Bad vertices
+  //   (e.g., with too few neighbors to fit a quadric) get zero curvature.
+  //
+  // Vertices are processed in parallel, each thread reusing its own
+  // neighborhood buffers.
   //
   // See also: average_onto_faces, average_onto_vertices
   //
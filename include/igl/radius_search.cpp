@@ -0,0 +1,92 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2023 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "radius_search.h"
+#include "parallel_for.h"
+#include <algorithm>
+#include <cmath>
+
+template <
+  typename DerivedP,
+  typename DerivedV,
+  typename IndexType,
+  typename DerivedCH,
+  typename DerivedCN,
+  typename DerivedW,
+  typename DerivedI,
+  typename DerivedNI>
+IGL_INLINE void igl::radius_search(
+  const Eigen::MatrixBase<DerivedP>& P,
+  const Eigen::MatrixBase<DerivedV>& V,
+  const typename DerivedP::Scalar r,
+  const std::vector<std::vector<IndexType> > & point_indices,
+  const Eigen::MatrixBase<DerivedCH>& CH,
+  const Eigen::MatrixBase<DerivedCN>& CN,
+  const Eigen::MatrixBase<DerivedW>& W,
+  Eigen::PlainObjectBase<DerivedI> & I,
+  Eigen::PlainObjectBase<DerivedNI> & NI)
+{
+  typedef typename DerivedP::Scalar Scalar;
+  typedef Eigen::Matrix<Scalar,1,3> RowVector3S;
+  const Scalar rr = r*r;
+  std::vector<std::vector<IndexType> > N(P.rows());
+  igl::parallel_for(P.rows(),[&](const int i)
+  {
+    const RowVector3S q = P.row(i);
+    std::vector<IndexType> & Ni = N[i];
+    std::vector<IndexType> stack(1,0);
+    while(!stack.empty())
+    {
+      const IndexType c = stack.back();
+      stack.pop_back();
+      if(point_indices[c].empty()) { continue; }
+      // Squared distances to the nearest and farthest point of the cell
+      Scalar lo = 0, hi = 0;
+      for(int j = 0;j<3;j++)
+      {
+        const Scalar e = std::abs(q(j)-Scalar(CN(c,j)));
+        const Scalar h = Scalar(0.5*W(c));
+        lo += std::max(e-h,Scalar(0))*std::max(e-h,Scalar(0));
+        hi += (e+h)*(e+h);
+      }
+      if(lo > rr) { continue; }
+      if(hi <= rr)
+      {
+        Ni.insert(Ni.end(),point_indices[c].begin(),point_indices[c].end());
+      }else if(CH(c,0) == -1)
+      {
+        for(const IndexType v : point_indices[c])
+        {
+          if((V.row(v).template cast<Scalar>()-q).squaredNorm() <= rr)
+          {
+            Ni.push_back(v);
+          }
+        }
+      }else
+      {
+        for(int j = 0;j<8;j++) { stack.push_back(CH(c,j)); }
+      }
+    }
+    std::sort(Ni.begin(),Ni.end());
+  },1000);
+  NI.resize(P.rows()+1);
+  NI(0) = 0;
+  for(int i = 0;i<P.rows();i++)
+  {
+    NI(i+1) = NI(i) + N[i].size();
+  }
+  I.resize(NI(P.rows()));
+  igl::parallel_for(P.rows(),[&](const int i)
+  {
+    std::copy(N[i].begin(),N[i].end(),I.data()+NI(i));
+  },1000);
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template void igl::radius_search<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, int, Eigen::Matrix<int, -1, 8, 0, -1, 8>, Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<double, -1, -1, 0, -1, -1>::Scalar, std::vector<std::vector<int, std::allocator<int> >, std::allocator<std::vector<int, std::allocator<int> > > > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 8, 0, -1, 8> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
+#endif
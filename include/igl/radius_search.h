@@ -0,0 +1,64 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2023 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_RADIUS_SEARCH_H
+#define IGL_RADIUS_SEARCH_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+#include <vector>
+
+namespace igl
+{
+  // Find all points of V within distance r of each query point using the
+  // pointerless octree of V (see igl::octree). Octree cells entirely inside
+  // the query ball are reported without visiting their points one by one.
+  // Queries are processed in parallel.
+  //
+  // Inputs:
+  //   P  #P by 3 list of query points
+  //   V  #V by 3 list of point locations which may be neighbors
+  //   r  search radius
+  //   point_indices  a vector of vectors, where the ith entry is a vector of
+  //                  the indices into V that are the ith octree cell's points
+  //   CH     #OctreeCells by 8, where the ith row is the indices of
+  //          the ith octree cell's children
+  //   CN     #OctreeCells by 3, where the ith row is a 3d row vector
+  //          representing the position of the ith cell's center
+  //   W      #OctreeCells, a vector where the ith entry is the width
+  //          of the ith octree cell
+  // Outputs:
+  //   I  list of indices into V so that the neighbors (‖P.row(i)-V.row(j)‖ ≤
+  //     r) of P.row(i) are I(NI(i)),...,I(NI(i+1)-1), in increasing order
+  //   NI  #P+1 list of cumulative neighbor counts
+  //
+  // See also: knn, octree
+  template <
+    typename DerivedP,
+    typename DerivedV,
+    typename IndexType,
+    typename DerivedCH,
+    typename DerivedCN,
+    typename DerivedW,
+    typename DerivedI,
+    typename DerivedNI>
+  IGL_INLINE void radius_search(
+    const Eigen::MatrixBase<DerivedP>& P,
+    const Eigen::MatrixBase<DerivedV>& V,
+    const typename DerivedP::Scalar r,
+    const std::vector<std::vector<IndexType> > & point_indices,
+    const Eigen::MatrixBase<DerivedCH>& CH,
+    const Eigen::MatrixBase<DerivedCN>& CN,
+    const Eigen::MatrixBase<DerivedW>& W,
+    Eigen::PlainObjectBase<DerivedI> & I,
+    Eigen::PlainObjectBase<DerivedNI> & NI);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "radius_search.cpp"
+#endif
+
+#endif
@@ -0,0 +1,125 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2023 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "radix_sort.h"
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include "default_num_threads.h"
+#include "parallel_for.h"
+
+template <typename Value>
+IGL_INLINE void igl::radix_sort(
+  std::vector<std::uint64_t> & keys,
+  std::vector<Value> & values)
+{
+  assert(keys.size() == values.size());
+  const size_t n = keys.size();
+  if(n < 64)
+  {
+    // Insertion sort is stable and faster for tiny inputs
+    for(size_t i = 1;i<n;i++)
+    {
+      const std::uint64_t key = keys[i];
+      const Value value = values[i];
+      size_t j = i;
+      for(;j>0 && keys[j-1] > key;j--)
+      {
+        keys[j] = keys[j-1];
+        values[j] = values[j-1];
+      }
+      keys[j] = key;
+      values[j] = value;
+    }
+    return;
+  }
+  // Each thread histograms and scatters its own contiguous block, small
+  // inputs are sorted by a single block
+  const size_t min_block = 1<<16;
+  const size_t num_blocks = std::max<size_t>(1,
+    std::min<size_t>(igl::default_num_threads(),n/min_block));
+  const size_t block_size = (n+num_blocks-1)/num_blocks;
+  // Bits that are not the same in all keys
+  std::vector<std::uint64_t> block_or(num_blocks,0), block_and(num_blocks,~0ull);
+  igl::parallel_for(num_blocks,[&](const size_t t)
+  {
+    const size_t end = std::min(n,(t+1)*block_size);
+    for(size_t i = t*block_size;i<end;i++)
+    {
+      block_or[t] |= keys[i];
+      block_and[t] &= keys[i];
+    }
+  },2ul);
+  std::uint64_t varying = 0, all_and = ~0ull;
+  for(size_t t = 0;t<num_blocks;t++)
+  {
+    varying |= block_or[t];
+    all_and &= block_and[t];
+  }
+  varying &= ~all_and;
+
+  // 11-bit digits: 64-bit keys need at most 6 passes and each thread's
+  // counters still fit in L1
+  const int bits = 11;
+  const size_t radix = size_t(1)<<bits;
+  const std::uint64_t mask = radix-1;
+  std::vector<std::uint64_t> sorted_keys(n);
+  std::vector<Value> sorted_values(n);
+  std::vector<size_t> offsets(num_blocks*radix);
+  for(int shift = 0;shift<64;shift+=bits)
+  {
+    if(((varying>>shift) & mask) == 0)
+    {
+      continue;
+    }
+    std::fill(offsets.begin(),offsets.end(),0);
+    igl::parallel_for(num_blocks,[&](const size_t t)
+    {
+      size_t * count = offsets.data()+t*radix;
+      const size_t end = std::min(n,(t+1)*block_size);
+      for(size_t i = t*block_size;i<end;i++)
+      {
+        count[(keys[i]>>shift) & mask]++;
+      }
+    },2ul);
+    // Digit-major, block-minor exclusive prefix sum keeps the sort stable
+    size_t sum = 0;
+    for(size_t d = 0;d<radix;d++)
+    {
+      for(size_t t = 0;t<num_blocks;t++)
+      {
+        const size_t c = offsets[t*radix+d];
+        offsets[t*radix+d] = sum;
+        sum += c;
+      }
+    }
+    igl::parallel_for(num_blocks,[&](const size_t t)
+    {
+      size_t * offset = offsets.data()+t*radix;
+      const size_t end = std::min(n,(t+1)*block_size);
+      for(size_t i = t*block_size;i<end;i++)
+      {
+        const size_t j = offset[(keys[i]>>shift) & mask]++;
+        sorted_keys[j] = keys[i];
+        sorted_values[j] = values[i];
+      }
+    },2ul);
+    keys.swap(sorted_keys);
+    values.swap(sorted_values);
+  }
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template void igl::radix_sort<int>(std::vector<std::uint64_t, std::allocator<std::uint64_t> >&, std::vector<int, std::allocator<int> >&);
+// Eigen::Index is std::int64_t on 64-bit platforms
+template void igl::radix_sort<std::int64_t>(std::vector<std::uint64_t, std::allocator<std::uint64_t> >&, std::vector<std::int64_t, std::allocator<std::int64_t> >&);
+template void igl::radix_sort<std::size_t>(std::vector<std::uint64_t, std::allocator<std::uint64_t> >&, std::vector<std::size_t, std::allocator<std::size_t> >&);
+#ifdef WIN32
+template void igl::radix_sort<long>(std::vector<std::uint64_t, std::allocator<std::uint64_t> >&, std::vector<long, std::allocator<long> >&);
+#endif
+#endif
@@ -0,0 +1,82 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2023 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_RADIX_SORT_H
+#define IGL_RADIX_SORT_H
+#include "igl_inline.h"
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace igl
+{
+  // Stable least-significant-digit radix sort of unsigned 64-bit keys, each
+  // carrying a value. Digit passes are skipped when all keys share those
+  // bits, so tightly packed keys (e.g., two vertex indices packed into one
+  // key) only cost as many passes as they have significant bits. Large
+  // inputs are split into one block per thread and sorted in parallel.
+  //
+  // Inputs:
+  //   keys  #keys list of keys
+  //   values  #keys list of values
+  // Outputs:
+  //   keys  #keys list of keys sorted in ascending order
+  //   values  #keys list of values permuted along with keys (values of equal
+  //     keys keep their input order)
+  //
+  // Example:
+  //   // sort rows of unsigned int E by (E(:,0),E(:,1))
+  //   std::vector<std::uint64_t> keys(E.rows());
+  //   std::vector<int> I(E.rows());
+  //   for(int e = 0;e<E.rows();e++)
+  //   {
+  //     keys[e] = (std::uint64_t(E(e,0))<<32) | E(e,1);
+  //     I[e] = e;
+  //   }
+  //   igl::radix_sort(keys,I);
+  template <typename Value>
+  IGL_INLINE void radix_sort(
+    std::vector<std::uint64_t> & keys,
+    std::vector<Value> & values);
+
+  // Order preserving map from numbers to radix_sort keys: x < y if and only
+  // if radix_sort_key(x) < radix_sort_key(y) (-0 and 0 map to the same key).
+  //
+  // Inputs:
+  //   x  integer or floating point number
+  // Returns unsigned 64-bit key
+  template <typename Integer>
+  inline typename std::enable_if<std::is_integral<Integer>::value,
+    std::uint64_t>::type radix_sort_key(const Integer x)
+  {
+    // Flip sign bit so that negative numbers come first
+    return std::uint64_t(x) ^
+      (std::is_signed<Integer>::value ? (std::uint64_t(1)<<63) : 0);
+  }
+  inline std::uint64_t radix_sort_key(const double x)
+  {
+    const double y = x == 0 ? 0.0 : x;
+    std::uint64_t b;
+    std::memcpy(&b,&y,sizeof(b));
+    // Negative numbers: reverse order, positive: after negatives
+    return (b>>63) ? ~b : b | (std::uint64_t(1)<<63);
+  }
+  inline std::uint64_t radix_sort_key(const float x)
+  {
+    const float y = x == 0 ? 0.0f : x;
+    std::uint32_t b;
+    std::memcpy(&b,&y,sizeof(b));
+    return (b>>31) ? std::uint32_t(~b) : b | (std::uint32_t(1)<<31);
+  }
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "radix_sort.cpp"
+#endif
+
+#endif
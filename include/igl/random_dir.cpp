@@ -7,6 +7,7 @@
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "random_dir.h"
 #include <igl/PI.h>
+#include "Philox.h"
 #include <cmath>
 
 IGL_INLINE Eigen::Vector3d igl::random_dir()
@@ -22,31 +23,40 @@ IGL_INLINE Eigen::Vector3d igl::random_dir()
 }
 
 IGL_INLINE Eigen::MatrixXd igl::random_dir_stratified(const int n)
+{
+  return random_dir_stratified(n,std::uint64_t(rand()));
+}
+
+IGL_INLINE Eigen::MatrixXd igl::random_dir_stratified(
+  const int n,
+  const std::uint64_t seed)
 {
   using namespace Eigen;
   using namespace std;
-  const double m = std::floor(sqrt(double(n)));
+  const int m = std::floor(sqrt(double(n)));
   MatrixXd N(n,3);
-  int row = 0;
-  for(int i = 0;i<m;i++)
+  // Each direction draws from its own stream
+  for(int row = 0;row<n;row++)
   {
-    const double x = double(i)*1./m;
-    for(int j = 0;j<m;j++)
+    Philox rng(seed,row);
+    double z,t;
+    if(row < m*m)
     {
-      const double y = double(j)*1./m;
-      double z = (x+(1./m)*(double)rand() / (double)RAND_MAX)*2.0 - 1.0;
-      double t = (y+(1./m)*(double)rand() / (double)RAND_MAX)*2.0*PI;
-      double r = sqrt(1.0-z*z);
-      N(row,0) = r * cos(t);
-      N(row,1) = r * sin(t);
-      N(row,2) = z;
-      row++;
+      // stratified
+      const double x = double(row/m)*1./m;
+      const double y = double(row%m)*1./m;
+      z = (x+(1./m)*rng.uniform())*2.0 - 1.0;
+      t = (y+(1./m)*rng.uniform())*2.0*PI;
+    }else
+    {
+      // Finish off with uniform random directions
+      z = rng.uniform()*2.0 - 1.0;
+      t = rng.uniform()*2.0*PI;
     }
-  }
-  // Finish off with uniform random directions
-  for(;row<n;row++)
-  {
-    N.row(row) = random_dir();
+    const double r = sqrt(1.0-z*z);
+    N(row,0) = r * cos(t);
+    N(row,1) = r * sin(t);
+    N(row,2) = z;
   }
   return N;
 }
@@ -10,6 +10,7 @@
 #include "igl_inline.h"
 
 #include <Eigen/Core>
+#include <cstdint>
 
 namespace igl
 {
@@ -22,6 +23,12 @@ namespace igl
   //   n  number of directions
   // Return n by 3 matrix of random directions
   IGL_INLINE Eigen::MatrixXd random_dir_stratified(const int n);
+  // Inputs:
+  //   seed  seed of the random number generator (see igl::Philox), the same
+  //     seed always produces the same directions
+  IGL_INLINE Eigen::MatrixXd random_dir_stratified(
+    const int n,
+    const std::uint64_t seed);
 }
 
 #ifndef IGL_STATIC_LIBRARY
@@ -8,7 +8,9 @@
 #include "random_points_on_mesh.h"
 #include "doublearea.h"
 #include "cumsum.h"
-#include "histc.h"
+#include "Philox.h"
+#include "parallel_for.h"
+#include <algorithm>
 #include <iostream>
 #include <cassert>
 
@@ -19,6 +21,18 @@ IGL_INLINE void igl::random_points_on_mesh(
   const Eigen::MatrixBase<DerivedF > & F,
   Eigen::PlainObjectBase<DerivedB > & B,
   Eigen::PlainObjectBase<DerivedFI > & FI)
+{
+  random_points_on_mesh(n,V,F,B,FI,std::uint64_t(rand()));
+}
+
+template <typename DerivedV, typename DerivedF, typename DerivedB, typename DerivedFI>
+IGL_INLINE void igl::random_points_on_mesh(
+  const int n,
+  const Eigen::MatrixBase<DerivedV > & V,
+  const Eigen::MatrixBase<DerivedF > & F,
+  Eigen::PlainObjectBase<DerivedB > & B,
+  Eigen::PlainObjectBase<DerivedFI > & FI,
+  const std::uint64_t seed)
 {
   using namespace Eigen;
   using namespace std;
@@ -38,17 +52,22 @@ IGL_INLINE void igl::random_points_on_mesh(
   assert(Cmax > 0 && "Total surface area should be positive");
   // Why is this more accurate than `C /= C(C.size()-1)` ?
   for(int i = 0;i<C.size();i++) { C(i) = C(i)/Cmax; }
-  const VectorXs R = (VectorXs::Random(n,1).array() + 1.)/2.;
-  assert(R.minCoeff() >= 0);
-  assert(R.maxCoeff() <= 1);
-  histc(R,C,FI);
-  FI = FI.array().min(int(F.rows()) - 1); // fix the bin when R(i) == 1 exactly
-  const VectorXs S = (VectorXs::Random(n,1).array() + 1.)/2.;
-  const VectorXs T = (VectorXs::Random(n,1).array() + 1.)/2.;
+  FI.resize(n,1);
   B.resize(n,3);
-  B.col(0) = 1.-T.array().sqrt();
-  B.col(1) = (1.-S.array()) * T.array().sqrt();
-  B.col(2) = S.array() * T.array().sqrt();
+  parallel_for(n,[&](const int i)
+  {
+    Philox rng(seed,i);
+    const Scalar R = rng.uniform();
+    const Scalar S = rng.uniform();
+    const Scalar T = rng.uniform();
+    // bin so that C(f) ≤ R < C(f+1) (like histc)
+    const int f = std::upper_bound(C.data(),C.data()+C.size(),R)-C.data()-1;
+    // fix the bin when R(i) == 1 exactly
+    FI(i) = std::max(std::min(f,int(F.rows())-1),0);
+    B(i,0) = 1.-sqrt(T);
+    B(i,1) = (1.-S) * sqrt(T);
+    B(i,2) = S * sqrt(T);
+  },1000);
 }
 
 template <
@@ -65,7 +84,25 @@ IGL_INLINE void igl::random_points_on_mesh(
   Eigen::PlainObjectBase<DerivedFI > & FI,
   Eigen::PlainObjectBase<DerivedX> & X)
 {
-  random_points_on_mesh(n,V,F,B,FI);
+  random_points_on_mesh(n,V,F,B,FI,X,std::uint64_t(rand()));
+}
+
+template <
+  typename DerivedV,
+  typename DerivedF,
+  typename DerivedB,
+  typename DerivedFI,
+  typename DerivedX>
+IGL_INLINE void igl::random_points_on_mesh(
+  const int n,
+  const Eigen::MatrixBase<DerivedV > & V,
+  const Eigen::MatrixBase<DerivedF > & F,
+  Eigen::PlainObjectBase<DerivedB > & B,
+  Eigen::PlainObjectBase<DerivedFI > & FI,
+  Eigen::PlainObjectBase<DerivedX> & X,
+  const std::uint64_t seed)
+{
+  random_points_on_mesh(n,V,F,B,FI,seed);
   X = DerivedX::Zero(B.rows(),V.cols());
   for(int x = 0;x<B.rows();x++)
   {
@@ -11,6 +11,7 @@
 #include "igl_inline.h"
 #include <Eigen/Core>
 #include <Eigen/Sparse>
+#include <cstdint>
 
 namespace igl
 {
@@ -32,6 +33,18 @@ namespace igl
     const Eigen::MatrixBase<DerivedF > & F,
     Eigen::PlainObjectBase<DerivedB > & B,
     Eigen::PlainObjectBase<DerivedFI > & FI);
+  // Inputs:
+  //   seed  seed of the random number generator (see igl::Philox). Samples
+  //     are drawn in parallel, each from its own stream, so the output only
+  //     depends on the seed (not on the number of threads).
+  template <typename DerivedV, typename DerivedF, typename DerivedB, typename DerivedFI>
+  IGL_INLINE void random_points_on_mesh(
+    const int n,
+    const Eigen::MatrixBase<DerivedV > & V,
+    const Eigen::MatrixBase<DerivedF > & F,
+    Eigen::PlainObjectBase<DerivedB > & B,
+    Eigen::PlainObjectBase<DerivedFI > & FI,
+    const std::uint64_t seed);
   // Outputs:
   //   X  n by dim list of sample positions.
   template <
@@ -47,6 +60,20 @@ namespace igl
     Eigen::PlainObjectBase<DerivedB > & B,
     Eigen::PlainObjectBase<DerivedFI > & FI,
     Eigen::PlainObjectBase<DerivedX> & X);
+  template <
+    typename DerivedV, 
+    typename DerivedF, 
+    typename DerivedB, 
+    typename DerivedFI,
+    typename DerivedX>
+  IGL_INLINE void random_points_on_mesh(
+    const int n,
+    const Eigen::MatrixBase<DerivedV > & V,
+    const Eigen::MatrixBase<DerivedF > & F,
+    Eigen::PlainObjectBase<DerivedB > & B,
+    Eigen::PlainObjectBase<DerivedFI > & FI,
+    Eigen::PlainObjectBase<DerivedX> & X,
+    const std::uint64_t seed);
   // Outputs:
   //   B n by #V sparse matrix so that  B*V produces a list of sample points
   template <typename DerivedV, typename DerivedF, typename ScalarB, typename DerivedFI>
@@ -17,6 +17,9 @@ namespace igl
   // When urbg is not specified, randperm will use default random bit generator
   // std::minstd_rand initialized with random seed generated by std::rand()
   //
+  // For reproducible permutations independent of global state pass, e.g.,
+  // igl::Philox(seed) (see Philox.h)
+  //
   // Inputs:
   //   n  number of elements
   //   urbg An instance of UnformRandomBitGenerator.
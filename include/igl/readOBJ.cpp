@@ -18,6 +18,7 @@
 #include <fstream>
 #include <sstream>
 #include <iterator>
+#include <cstdint>
 
 template <typename Scalar, typename Index>
 IGL_INLINE bool igl::readOBJ(
@@ -100,7 +101,8 @@ IGL_INLINE bool igl::readOBJ(
   char line[IGL_LINE_MAX];
   char currentmaterialref[MATERIAL_LINE_MAX] = "";
   bool FMwasinit = false;
-  int line_no = 1, previous_face_no=0, current_face_no = 0;
+  long long line_no = 1;
+  Index previous_face_no = 0, current_face_no = 0;
   while (fgets(line, IGL_LINE_MAX, obj_file) != NULL)
   {
     char type[IGL_LINE_MAX];
@@ -117,7 +119,7 @@ IGL_INLINE bool igl::readOBJ(
         if (vertex.size() < 3)
         {
           fprintf(stderr,
-                  "Error: readOBJ() vertex on line %d should have at least 3 coordinates",
+                  "Error: readOBJ() vertex on line %lld should have at least 3 coordinates",
                   line_no);
           fclose(obj_file);
           return false;
@@ -132,7 +134,7 @@ IGL_INLINE bool igl::readOBJ(
         if(count != 3)
         {
           fprintf(stderr,
-                  "Error: readOBJ() normal on line %d should have 3 coordinates",
+                  "Error: readOBJ() normal on line %lld should have 3 coordinates",
                   line_no);
           fclose(obj_file);
           return false;
@@ -151,7 +153,7 @@ IGL_INLINE bool igl::readOBJ(
         if(count != 2 && count != 3)
         {
           fprintf(stderr,
-                  "Error: readOBJ() texture coords on line %d should have 2 "
+                  "Error: readOBJ() texture coords on line %lld should have 2 "
                   "or 3 coordinates (%d)",
                   line_no,count);
           fclose(obj_file);
@@ -165,15 +167,15 @@ IGL_INLINE bool igl::readOBJ(
         TC.push_back(tex);
       }else if(type == f)
       {
-        const auto & shift = [&V](const int i)->int
+        const auto & shift = [&V](const long long i)->Index
         {
           return i<0 ? i+V.size() : i-1;
         };
-        const auto & shift_t = [&TC](const int i)->int
+        const auto & shift_t = [&TC](const long long i)->Index
         {
           return i<0 ? i+TC.size() : i-1;
         };
-        const auto & shift_n = [&N](const int i)->int
+        const auto & shift_n = [&N](const long long i)->Index
         {
           return i<0 ? i+N.size() : i-1;
         };
@@ -188,27 +190,27 @@ IGL_INLINE bool igl::readOBJ(
           // adjust offset
           l += offset;
           // Process word
-          long int i,it,in;
-          if(sscanf(word,"%ld/%ld/%ld",&i,&it,&in) == 3)
+          long long i,it,in;
+          if(sscanf(word,"%lld/%lld/%lld",&i,&it,&in) == 3)
           {
             f.push_back(shift(i));
             ftc.push_back(shift_t(it));
             fn.push_back(shift_n(in));
-          }else if(sscanf(word,"%ld/%ld",&i,&it) == 2)
+          }else if(sscanf(word,"%lld/%lld",&i,&it) == 2)
           {
             f.push_back(shift(i));
             ftc.push_back(shift_t(it));
-          }else if(sscanf(word,"%ld//%ld",&i,&in) == 2)
+          }else if(sscanf(word,"%lld//%lld",&i,&in) == 2)
           {
             f.push_back(shift(i));
             fn.push_back(shift_n(in));
-          }else if(sscanf(word,"%ld",&i) == 1)
+          }else if(sscanf(word,"%lld",&i) == 1)
           {
             f.push_back(shift(i));
           }else
           {
             fprintf(stderr,
-                    "Error: readOBJ() face on line %d has invalid element format\n",
+                    "Error: readOBJ() face on line %lld has invalid element format\n",
                     line_no);
             fclose(obj_file);
             return false;
@@ -229,7 +231,7 @@ IGL_INLINE bool igl::readOBJ(
         }else
         {
           fprintf(stderr,
-                  "Error: readOBJ() face on line %d has invalid format\n", line_no);
+                  "Error: readOBJ() face on line %lld has invalid format\n", line_no);
           fclose(obj_file);
           return false;
         }
@@ -254,7 +256,7 @@ IGL_INLINE bool igl::readOBJ(
       {
         //ignore any other lines
         fprintf(stderr,
-                "Warning: readOBJ() ignored non-comment line %d:\n  %s",
+                "Warning: readOBJ() ignored non-comment line %lld:\n  %s",
                 line_no,
                 line);
       }
@@ -304,7 +306,7 @@ IGL_INLINE bool igl::readOBJ(
   Eigen::PlainObjectBase<DerivedFN>& FN)
 {
   std::vector<std::vector<double> > vV,vTC,vN;
-  std::vector<std::vector<int> > vF,vFTC,vFN;
+  std::vector<std::vector<typename DerivedF::Scalar> > vF,vFTC,vFN;
   bool success = igl::readOBJ(str,vV,vTC,vN,vF,vFTC,vFN);
   if(!success)
   {
@@ -375,7 +377,7 @@ IGL_INLINE bool igl::readOBJ(
   Eigen::PlainObjectBase<DerivedF>& F)
 {
   std::vector<std::vector<double> > vV,vTC,vN;
-  std::vector<std::vector<int> > vF,vFTC,vFN;
+  std::vector<std::vector<typename DerivedF::Scalar> > vF,vFTC,vFN;
   bool success = igl::readOBJ(str,vV,vTC,vN,vF,vFTC,vFN);
   if(!success)
   {
@@ -407,7 +409,7 @@ IGL_INLINE bool igl::readOBJ(
 {
   // we should flip this so that the base implementation uses arrays.
   std::vector<std::vector<double> > vV,vTC,vN;
-  std::vector<std::vector<int> > vF,vFTC,vFN;
+  std::vector<std::vector<typename DerivedI::Scalar> > vF,vFTC,vFN;
   bool success = igl::readOBJ(str,vV,vTC,vN,vF,vFTC,vFN);
   if(!success)
   {
@@ -436,4 +438,6 @@ template bool igl::readOBJ<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matr
 template bool igl::readOBJ<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(std::basic_string<char, std::char_traits<char>, std::allocator<char> >, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
 template bool igl::readOBJ<Eigen::Matrix<double, -1, -1, 1, -1, -1>, Eigen::Matrix<double, -1, -1, 1, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 3, 1, -1, 3>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(std::basic_string<char, std::char_traits<char>, std::allocator<char> >, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 1, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 1, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 3, 1, -1, 3> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
 template bool igl::readOBJ<Eigen::Matrix<float, -1, 3, 1, -1, 3>, Eigen::Matrix<float, -1, 2, 1, -1, 2>, Eigen::Matrix<float, -1, 3, 1, -1, 3>, Eigen::Matrix<unsigned int, -1, 3, 1, -1, 3>, Eigen::Matrix<unsigned int, -1, 3, 1, -1, 3>, Eigen::Matrix<unsigned int, -1, 3, 1, -1, 3> >(std::basic_string<char, std::char_traits<char>, std::allocator<char> >, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, 3, 1, -1, 3> >&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, 2, 1, -1, 2> >&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, 3, 1, -1, 3> >&, Eigen::PlainObjectBase<Eigen::Matrix<unsigned int, -1, 3, 1, -1, 3> >&, Eigen::PlainObjectBase<Eigen::Matrix<unsigned int, -1, 3, 1, -1, 3> >&, Eigen::PlainObjectBase<Eigen::Matrix<unsigned int, -1, 3, 1, -1, 3> >&);
+template bool igl::readOBJ<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> >(std::string, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> >&);
+template bool igl::readOBJ<Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(std::string, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
 #endif
@@ -29,7 +29,7 @@ namespace igl
   // Templates:
   //   Scalar  type for positions and vectors (will be read as double and cast
   //     to Scalar)
-  //   Index  type for indices (will be read as int and cast to Index)
+  //   Index  type for indices (will be read as 64-bit int and cast to Index)
   // Inputs:
   //  str  path to .obj file
   // Outputs:
@@ -55,7 +55,7 @@ namespace igl
   // Templates:
   //   Scalar  type for positions and vectors (will be read as double and cast
   //     to Scalar)
-  //   Index  type for indices (will be read as int and cast to Index)
+  //   Index  type for indices (will be read as 64-bit int and cast to Index)
   // Inputs:
   //  str  path to .obj file
   // Outputs:
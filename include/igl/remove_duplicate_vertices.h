@@ -29,6 +29,8 @@ namespace igl
   //   % remap faces
   //   SF = SVJ(F);
   //
+  // See also: weld_vertices (parallel, no sorting, vertices within epsilon)
+  //
   template <
     typename DerivedV, 
     typename DerivedSV, 
@@ -6,11 +6,10 @@
 // v. 2.0. If a copy of the MPL was not distributed with this file, You can 
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "rigid_alignment.h"
-#include "polar_svd.h"
-#include <Eigen/Sparse>
+#include "parallel_for.h"
 #include <Eigen/Cholesky>
 #include <vector>
-#include <iostream>
+#include <cassert>
 
 template <
   typename DerivedX,
@@ -19,55 +18,87 @@ template <
   typename DerivedR,
   typename Derivedt
 >
+IGL_INLINE void igl::rigid_alignment(
+  const Eigen::MatrixBase<DerivedX> & X,
+  const Eigen::MatrixBase<DerivedP> & P,
+  const Eigen::MatrixBase<DerivedN> & N,
+  Eigen::PlainObjectBase<DerivedR> & R,
+  Eigen::PlainObjectBase<Derivedt> & t)
+{
+  typedef typename DerivedX::Scalar Scalar;
+  typedef Eigen::Matrix<Scalar,Eigen::Dynamic,1> VectorXS;
+  return rigid_alignment(X,P,N,VectorXS::Ones(X.rows()),R,t);
+}
+
+template <
+  typename DerivedX,
+  typename DerivedP,
+  typename DerivedN,
+  typename DerivedW,
+  typename DerivedR,
+  typename Derivedt
+>
 IGL_INLINE void igl::rigid_alignment(
   const Eigen::MatrixBase<DerivedX> & _X,
   const Eigen::MatrixBase<DerivedP> & P,
   const Eigen::MatrixBase<DerivedN> & N,
+  const Eigen::MatrixBase<DerivedW> & W,
   Eigen::PlainObjectBase<DerivedR> & R,
   Eigen::PlainObjectBase<Derivedt> & t)
 {
   typedef typename DerivedX::Scalar Scalar;
   typedef Eigen::Matrix<Scalar,Eigen::Dynamic,Eigen::Dynamic> MatrixXS;
-  typedef Eigen::Matrix<Scalar,Eigen::Dynamic,1> VectorXS;
   typedef Eigen::Matrix<Scalar,3,3> Matrix3S;
+  typedef Eigen::Matrix<Scalar,6,6> Matrix6S;
+  typedef Eigen::Matrix<Scalar,6,1> Vector6S;
+  typedef Eigen::Matrix<Scalar,1,3> RowVector3S;
   const int k = _X.rows();
-  VectorXS Z = VectorXS::Zero(k,1);
-  VectorXS I = VectorXS::Ones(k,1);
+  assert(P.rows() == k && N.rows() == k && W.size() == k);
 
-  DerivedX X = _X;
+  MatrixXS X = _X;
   R = DerivedR::Identity(3,3);
   t = Derivedt::Zero(1,3);
+  // Nothing to align (parallel_for would not even set up the accumulators)
+  if(k == 0) { return; }
   // See gptoolbox, each iter could be O(1) instead of O(k)
   const int max_iters = 5;
   for(int iters = 0;iters<max_iters;iters++)
   {
-    MatrixXS A(k*3,6);
-    A <<
-               Z, X.col(2),-X.col(1),I,Z,Z,
-       -X.col(2),        Z, X.col(0),Z,I,Z,
-        X.col(1),-X.col(0),        Z,Z,Z,I;
-    VectorXS B(k*3,1);
-    B<<
-      P.col(0)-X.col(0),
-      P.col(1)-X.col(1),
-      P.col(2)-X.col(2);
-    std::vector<Eigen::Triplet<Scalar> > NNIJV;
-    for(int i = 0;i<k;i++)
-    {
-      for(int c = 0;c<3;c++)
+    // Linearize rotation about current X: residual of point i is
+    // aᵢ⋅u - bᵢ with aᵢ = [xᵢ×nᵢ nᵢ] and bᵢ = (pᵢ-xᵢ)⋅nᵢ. Accumulate the
+    // 6×6 normal equations per thread.
+    std::vector<Matrix6S> AtA;
+    std::vector<Vector6S> AtB;
+    igl::parallel_for(
+      k,
+      [&](const size_t nt)
       {
-        NNIJV.emplace_back(i,i+k*c,N(i,c));
-      }
-    }
-    Eigen::SparseMatrix<Scalar> NN(k,k*3);
-    NN.setFromTriplets(NNIJV.begin(),NNIJV.end());
-    A = (NN * A).eval();
-    B = (NN * B).eval();
-    VectorXS u = (A.transpose() * A).ldlt().solve(A.transpose() * B);
+        AtA.assign(nt,Matrix6S::Zero());
+        AtB.assign(nt,Vector6S::Zero());
+      },
+      [&](const int i, const size_t th)
+      {
+        if(W(i) == 0) { return; }
+        const RowVector3S xi = X.row(i);
+        const RowVector3S ni = N.row(i).template cast<Scalar>();
+        Vector6S a;
+        a << xi.cross(ni).transpose(), ni.transpose();
+        const Scalar b = (P.row(i).template cast<Scalar>()-xi).dot(ni);
+        AtA[th].noalias() += W(i)*a*a.transpose();
+        AtB[th] += (W(i)*b)*a;
+      },
+      [&](const size_t th)
+      {
+        if(th == 0) { return; }
+        AtA[0] += AtA[th];
+        AtB[0] += AtB[th];
+      },
+      1000);
+    const Vector6S u = AtA[0].ldlt().solve(AtB[0]);
     Derivedt ti = u.tail(3).transpose();
 
-    Matrix3S W;
-    W<<
+    Matrix3S S;
+    S<<
           0, u(2),-u(1),
       -u(2),    0, u(0),
        u(1),-u(0),    0;
@@ -81,8 +112,8 @@ IGL_INLINE void igl::rigid_alignment(
     {
       Ri = 
         DerivedR::Identity(3,3) + 
-        sin(x)/x*W + 
-        (1.0-cos(x))/(x*x)*W*W;
+        sin(x)/x*S + 
+        (1.0-cos(x))/(x*x)*S*S;
     }
     
     R = (R*Ri).eval();
@@ -94,4 +125,5 @@ IGL_INLINE void igl::rigid_alignment(
 #ifdef IGL_STATIC_LIBRARY
 // Explicit template instantiation
 template void igl::rigid_alignment<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, 3, 3, 0, 3, 3>, Eigen::Matrix<double, 1, 3, 1, 1, 3> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, 3, 3, 0, 3, 3> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> >&);
+template void igl::rigid_alignment<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, 3, 3, 0, 3, 3>, Eigen::Matrix<double, 1, 3, 1, 1, 3> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, 3, 3, 0, 3, 3> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> >&);
 #endif
@@ -41,6 +41,30 @@ namespace igl
     const Eigen::MatrixBase<DerivedN> & N,
     Eigen::PlainObjectBase<DerivedR> & R,
     Eigen::PlainObjectBase<Derivedt> & t);
+  // Weighted version
+  //
+  //  min       ∑ wᵢ ((xᵢR+t-pᵢ)⋅nᵢ)²
+  //  R∈SO(3)
+  //  t∈R³
+  //
+  // Inputs:
+  //   W  #X list of non-negative weights (e.g., 0 to ignore a
+  //     correspondence)
+  template <
+    typename DerivedX,
+    typename DerivedP,
+    typename DerivedN,
+    typename DerivedW,
+    typename DerivedR,
+    typename Derivedt
+  >
+  IGL_INLINE void rigid_alignment(
+    const Eigen::MatrixBase<DerivedX> & X,
+    const Eigen::MatrixBase<DerivedP> & P,
+    const Eigen::MatrixBase<DerivedN> & N,
+    const Eigen::MatrixBase<DerivedW> & W,
+    Eigen::PlainObjectBase<DerivedR> & R,
+    Eigen::PlainObjectBase<Derivedt> & t);
 }
 
 #ifndef IGL_STATIC_LIBRARY
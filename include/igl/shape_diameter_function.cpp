@@ -17,6 +17,7 @@
 #include <functional>
 #include <vector>
 #include <algorithm>
+#include <limits>
 
 template <
   typename DerivedP,
@@ -83,27 +84,46 @@ IGL_INLINE void igl::shape_diameter_function(
   const int num_samples,
   Eigen::PlainObjectBase<DerivedS> & S)
 {
-  const auto & shoot_ray = [&aabb,&V,&F](
-    const Eigen::Vector3f& _s,
-    const Eigen::Vector3f& dir)->double
+  typedef typename DerivedV::Scalar Scalar;
+  typedef Eigen::Matrix<Scalar,Eigen::Dynamic,3> MatrixX3S;
+  const int n = P.rows();
+  // Resize output
+  S.resize(n,1);
+  // Stratified directions as in the per-ray version above
+  const MatrixX3S D = 
+    random_dir_stratified(num_samples).cast<float>().cast<Scalar>();
+  // All samples of a point form a single packet of rays sharing its origin.
+  // Rather than offsetting the origin along each ray, ignore hits closer than
+  // the offset (and measure distances from the offset point as before).
+  const Scalar offset = 1e-4;
+  const auto & inner = [&](const int p)
   {
-    Eigen::Vector3f s = _s+1e-4*dir;
-    igl::Hit hit;
-    if(aabb.intersect_ray(
-      V,
-      F,
-      s  .cast<typename DerivedV::Scalar>().eval(),
-      dir.cast<typename DerivedV::Scalar>().eval(),
-      hit))
+    const Eigen::Matrix<Scalar,1,3> origin = P.row(p).template cast<Scalar>();
+    const Eigen::Matrix<Scalar,1,3> normal = N.row(p).template cast<Scalar>();
+    MatrixX3S dirs = D;
+    for(int s = 0;s<num_samples;s++)
     {
-      return hit.t;
-    }else
+      // Shoot _inward_
+      if(dirs.row(s).dot(normal) > 0)
+      {
+        // reverse ray
+        dirs.row(s) *= -1;
+      }
+    }
+    std::vector<igl::Hit> hits;
+    const int num_hits = aabb.intersect_rays(
+      V,F,origin,dirs,offset,std::numeric_limits<Scalar>::infinity(),false,hits);
+    double total_distance = 0;
+    for(const auto & hit : hits)
     {
-      return std::numeric_limits<double>::infinity();
+      if(hit.id >= 0)
+      {
+        total_distance += hit.t - offset;
+      }
     }
+    S(p) = total_distance/(double)num_hits;
   };
-  return shape_diameter_function(shoot_ray,P,N,num_samples,S);
-
+  parallel_for(n,inner,1000);
 }
 
 template <
@@ -178,5 +198,6 @@ template void igl::shape_diameter_function<Eigen::Matrix<double, -1, 3, 0, -1, 3
 template void igl::shape_diameter_function<Eigen::Matrix<double, 1, 3, 1, 1, 3>, Eigen::Matrix<double, 1, 3, 1, 1, 3>, Eigen::Matrix<double, -1, 1, 0, -1, 1> >(std::function<double (Eigen::Matrix<float, 3, 1, 0, 3, 1> const&, Eigen::Matrix<float, 3, 1, 0, 3, 1> const&)> const&, Eigen::MatrixBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> > const&, int, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&);
 template void igl::shape_diameter_function<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(std::function<double (Eigen::Matrix<float, 3, 1, 0, 3, 1> const&, Eigen::Matrix<float, 3, 1, 0, 3, 1> const&)> const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, int, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
 template void igl::shape_diameter_function<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, bool, int, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
+template void igl::shape_diameter_function<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1> >(igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3> const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, int, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&);
 #endif
 
@@ -39,6 +39,14 @@
 #include "Timer.h"
 #include "sparse_cached.h"
 #include "AtA_cached.h"
+#include "parallel_for.h"
+#include "svd3x3.h"
+#ifdef __SSE__
+#  include "svd3x3_sse.h"
+#endif
+#ifdef __AVX__
+#  include "svd3x3_avx.h"
+#endif
 
 #ifdef CHOLMOD
 #include <Eigen/CholmodSupport>
@@ -98,7 +106,7 @@ namespace igl
     IGL_INLINE void update_weights_and_closest_rotations(igl::SLIMData& s, Eigen::MatrixXd &uv)
     {
       compute_jacobians(s, uv);
-      slim_update_weights_and_closest_rotations_with_jacobians(s.Ji, s.slim_energy, s.exp_factor, s.W, s.Ri);
+      slim_update_weights_and_closest_rotations_with_jacobians(s.Ji, s.slim_energy, s.exp_factor, s.use_svd3x3, s.W, s.Ri);
     }
     
 
@@ -124,8 +132,15 @@ namespace igl
 #ifndef CHOLMOD
       if (s.dim == 2)
       {
-        SimplicialLDLT<Eigen::SparseMatrix<double> > solver;
-        Uc = solver.compute(L).solve(s.rhs);
+        // L's sparsity pattern is fixed across iterations when cached, so
+        // only the numeric factorization needs to be redone
+        if (!s.cached || !s.solver)
+        {
+          s.solver = std::make_shared<SimplicialLDLT<Eigen::SparseMatrix<double> > >();
+          s.solver->analyzePattern(L);
+        }
+        s.solver->factorize(L);
+        Uc = s.solver->solve(s.rhs);
       }
       else
       { // seems like CG performs much worse for 2D and way better for 3D
@@ -215,60 +230,52 @@ namespace igl
     {
       // formula (35) in paper
       std::vector<Eigen::Triplet<double> > IJV;
-      
-      #ifdef SLIM_CACHED
-      slim_buildA(s.Dx, s.Dy, s.Dz, s.W, IJV);
-      if (s.A.rows() == 0)
-      {
-        s.A = Eigen::SparseMatrix<double>(s.dim * s.dim * s.f_n, s.dim * s.v_n);
-        igl::sparse_cached_precompute(IJV,s.A_data,s.A);
-      }
-      else
-        igl::sparse_cached(IJV,s.A_data,s.A);
-      #else
-      Eigen::SparseMatrix<double> A(s.dim * s.dim * s.f_n, s.dim * s.v_n);
       slim_buildA(s.Dx, s.Dy, s.Dz, s.W, IJV);
-      A.setFromTriplets(IJV.begin(),IJV.end());
-      A.makeCompressed();
-      #endif
-
-      #ifdef SLIM_CACHED
-      #else
-      Eigen::SparseMatrix<double> At = A.transpose();
-      At.makeCompressed();
-      #endif
-
-      #ifdef SLIM_CACHED
-      Eigen::SparseMatrix<double> id_m(s.A.cols(), s.A.cols());
-      #else
-      Eigen::SparseMatrix<double> id_m(A.cols(), A.cols());
-      #endif
 
+      Eigen::SparseMatrix<double> id_m(s.dim * s.v_n, s.dim * s.v_n);
       id_m.setIdentity();
 
-      // add proximal penalty
-      #ifdef SLIM_CACHED
-      s.AtA_data.W = s.WGL_M;
-      if (s.AtA.rows() == 0)
-        igl::AtA_cached_precompute(s.A,s.AtA_data,s.AtA);
-      else
-        igl::AtA_cached(s.A,s.AtA_data,s.AtA);
+      if (s.cached)
+      {
+        // An empty A_data means no valid pattern: first iteration, a new
+        // problem, or the previous iteration ran with cached off
+        if (s.A_data.size() == 0)
+        {
+          s.A = Eigen::SparseMatrix<double>(s.dim * s.dim * s.f_n, s.dim * s.v_n);
+          igl::sparse_cached_precompute(IJV,s.A_data,s.A);
+          // Patterns derived from A must be rebuilt as well
+          s.AtA.resize(0, 0);
+          s.solver.reset();
+        }
+        else
+          igl::sparse_cached(IJV,s.A_data,s.A);
 
-      L = s.AtA + s.proximal_p * id_m; //add also a proximal 
-      L.makeCompressed();
+        // add proximal penalty
+        s.AtA_data.W = s.WGL_M;
+        if (s.AtA.rows() == 0)
+          igl::AtA_cached_precompute(s.A,s.AtA_data,s.AtA);
+        else
+          igl::AtA_cached(s.A,s.AtA_data,s.AtA);
 
-      #else
-      L = At * s.WGL_M.asDiagonal() * A + s.proximal_p * id_m; //add also a proximal term
-      L.makeCompressed();
-      #endif
+        L = s.AtA + s.proximal_p * id_m; //add also a proximal 
+        L.makeCompressed();
+      }
+      else
+      {
+        // A is rebuilt from scratch: invalidate the cached patterns
+        s.A_data.resize(0);
+        s.AtA.resize(0, 0);
+        s.A = Eigen::SparseMatrix<double>(s.dim * s.dim * s.f_n, s.dim * s.v_n);
+        s.A.setFromTriplets(IJV.begin(),IJV.end());
+        s.A.makeCompressed();
+        Eigen::SparseMatrix<double> At = s.A.transpose();
+        At.makeCompressed();
+        L = At * s.WGL_M.asDiagonal() * s.A + s.proximal_p * id_m; //add also a proximal term
+        L.makeCompressed();
+      }
 
-      #ifdef SLIM_CACHED
       buildRhs(s, s.A);
-      #else
-      buildRhs(s, A);
-      #endif
 
-      Eigen::SparseMatrix<double> OldL = L;
       add_soft_constraints(s,L);
       L.makeCompressed();
     }
@@ -319,13 +326,13 @@ namespace igl
              W11*R12 + W12*R22;
              W21*R11 + W22*R21;
              W21*R12 + W22*R22];*/
-        for (int i = 0; i < s.f_n; i++)
+        igl::parallel_for(s.f_n, [&s, &f_rhs](const int i)
         {
           f_rhs(i + 0 * s.f_n) = s.W(i, 0) * s.Ri(i, 0) + s.W(i, 1) * s.Ri(i, 1);
           f_rhs(i + 1 * s.f_n) = s.W(i, 0) * s.Ri(i, 2) + s.W(i, 1) * s.Ri(i, 3);
           f_rhs(i + 2 * s.f_n) = s.W(i, 2) * s.Ri(i, 0) + s.W(i, 3) * s.Ri(i, 1);
           f_rhs(i + 3 * s.f_n) = s.W(i, 2) * s.Ri(i, 2) + s.W(i, 3) * s.Ri(i, 3);
-        }
+        }, 1000);
       }
       else
       {
@@ -338,7 +345,7 @@ namespace igl
              W31*R11 + W32*R21 + W33*R31;
              W31*R12 + W32*R22 + W33*R32;
              W31*R13 + W32*R23 + W33*R33;];*/
-        for (int i = 0; i < s.f_n; i++)
+        igl::parallel_for(s.f_n, [&s, &f_rhs](const int i)
         {
           f_rhs(i + 0 * s.f_n) = s.W(i, 0) * s.Ri(i, 0) + s.W(i, 1) * s.Ri(i, 1) + s.W(i, 2) * s.Ri(i, 2);
           f_rhs(i + 1 * s.f_n) = s.W(i, 0) * s.Ri(i, 3) + s.W(i, 1) * s.Ri(i, 4) + s.W(i, 2) * s.Ri(i, 5);
@@ -349,7 +356,7 @@ namespace igl
           f_rhs(i + 6 * s.f_n) = s.W(i, 6) * s.Ri(i, 0) + s.W(i, 7) * s.Ri(i, 1) + s.W(i, 8) * s.Ri(i, 2);
           f_rhs(i + 7 * s.f_n) = s.W(i, 6) * s.Ri(i, 3) + s.W(i, 7) * s.Ri(i, 4) + s.W(i, 8) * s.Ri(i, 5);
           f_rhs(i + 8 * s.f_n) = s.W(i, 6) * s.Ri(i, 6) + s.W(i, 7) * s.Ri(i, 7) + s.W(i, 8) * s.Ri(i, 8);
-        }
+        }, 1000);
       }
       Eigen::VectorXd uv_flat(s.dim *s.v_n);
       for (int i = 0; i < s.dim; i++)
@@ -367,6 +374,16 @@ IGL_INLINE void igl::slim_update_weights_and_closest_rotations_with_jacobians(co
                                           double exp_factor,
                                           Eigen::MatrixXd &W,
                                           Eigen::MatrixXd &Ri)
+{
+  slim_update_weights_and_closest_rotations_with_jacobians(Ji, slim_energy, exp_factor, false, W, Ri);
+}
+
+IGL_INLINE void igl::slim_update_weights_and_closest_rotations_with_jacobians(const Eigen::MatrixXd &Ji,
+                                          igl::MappingEnergyType slim_energy,
+                                          double exp_factor,
+                                          const bool use_svd3x3,
+                                          Eigen::MatrixXd &W,
+                                          Eigen::MatrixXd &Ri)
 {
   const double eps = 1e-8;
   double exp_f = exp_factor;
@@ -374,7 +391,7 @@ IGL_INLINE void igl::slim_update_weights_and_closest_rotations_with_jacobians(co
 
   if (dim == 2)
   {
-    for (int i = 0; i < Ji.rows(); ++i)
+    igl::parallel_for(Ji.rows(), [&](const int i)
     {
       typedef Eigen::Matrix2d Mat2;
       typedef Eigen::Matrix<double, 2, 2, Eigen::RowMajor> RMat2;
@@ -476,27 +493,20 @@ IGL_INLINE void igl::slim_update_weights_and_closest_rotations_with_jacobians(co
       W.row(i) = Eigen::Map<Eigen::Matrix<double, 1, 4, Eigen::RowMajor>>(mat_W.data());
       // 2) Update local step (doesn't have to be a rotation, for instance in case of conformal energy)
       Ri.row(i) = Eigen::Map<Eigen::Matrix<double, 1,4,Eigen::RowMajor>>(ri.data());
-    }
+    }, 1000);
   }
   else
   {
     typedef Eigen::Matrix<double, 3, 1> Vec3;
     typedef Eigen::Matrix<double, 3, 3, Eigen::ColMajor> Mat3;
     typedef Eigen::Matrix<double, 3, 3, Eigen::RowMajor> RMat3;
-    Mat3 ji;
-    Vec3 m_sing_new;
-    Vec3 closest_sing_vec;
     const double sqrt_2 = sqrt(2);
-    for (int i = 0; i < Ji.rows(); ++i)
+    // Update weights and closest rotation of element i given the SVD of its
+    // jacobian
+    const auto update = [&](const int i, const Mat3 & ui, const Vec3 & sing, const Mat3 & vi, Mat3 & ri)
     {
-      ji << Ji(i,0), Ji(i,1), Ji(i,2), 
-      Ji(i,3), Ji(i,4), Ji(i,5), 
-      Ji(i,6), Ji(i,7), Ji(i,8);
-
-      Mat3 ri, ti, ui, vi;
-      Vec3 sing;
-      igl::polar_svd(ji, ri, ti, ui, sing, vi);
-
+      Vec3 m_sing_new;
+      Vec3 closest_sing_vec;
       double s1 = sing(0);
       double s2 = sing(1);
       double s3 = sing(2);
@@ -606,7 +616,68 @@ IGL_INLINE void igl::slim_update_weights_and_closest_rotations_with_jacobians(co
       W.row(i) = Eigen::Map<Eigen::Matrix<double, 1,9,Eigen::RowMajor>>(mat_W.data());
       // 2) Update closest rotations (not rotations in case of conformal energy)
       Ri.row(i) = Eigen::Map<Eigen::Matrix<double, 1,9,Eigen::RowMajor>>(ri.data());
-    } // for loop end
+    };
+
+    if (!use_svd3x3)
+    {
+      igl::parallel_for(Ji.rows(), [&](const int i)
+      {
+        Mat3 ji;
+        ji << Ji(i,0), Ji(i,1), Ji(i,2), 
+        Ji(i,3), Ji(i,4), Ji(i,5), 
+        Ji(i,6), Ji(i,7), Ji(i,8);
+
+        Mat3 ri, ti, ui, vi;
+        Vec3 sing;
+        igl::polar_svd(ji, ri, ti, ui, sing, vi);
+        update(i, ui, sing, vi, ri);
+      }, 1000);
+    }
+    else
+    {
+      // Single precision SVD of cStep jacobians at a time
+#if defined(__AVX__)
+      const int cStep = 8;
+#elif defined(__SSE__)
+      const int cStep = 4;
+#else
+      const int cStep = 1;
+#endif
+      const int num_batches = (Ji.rows() + cStep - 1) / cStep;
+      igl::parallel_for(num_batches, [&](const int batch)
+      {
+        const int r = batch * cStep;
+        const int numMats = std::min<int>(cStep, Ji.rows() - r);
+        Eigen::Matrix<float, 3*cStep, 3> A, U, V;
+        Eigen::Matrix<float, 3*cStep, 1> S;
+        A.setZero();
+        for (int k = 0; k < numMats; k++)
+          for (int a = 0; a < 3; a++)
+            for (int c = 0; c < 3; c++)
+              A(3*k + a, c) = Ji(r + k, 3*a + c);
+#if defined(__AVX__)
+        igl::svd3x3_avx(A, U, S, V);
+#elif defined(__SSE__)
+        igl::svd3x3_sse(A, U, S, V);
+#else
+        {
+          Eigen::Matrix3f Uk, Vk;
+          Eigen::Vector3f Sk;
+          igl::svd3x3(Eigen::Matrix3f(A), Uk, Sk, Vk);
+          U = Uk; S = Sk; V = Vk;
+        }
+#endif
+        for (int k = 0; k < numMats; k++)
+        {
+          const Mat3 ui = U.template block<3,3>(3*k, 0).template cast<double>();
+          const Mat3 vi = V.template block<3,3>(3*k, 0).template cast<double>();
+          const Vec3 sing = S.template segment<3>(3*k).template cast<double>();
+          // svd3x3 guarantees det(U)=det(V)=1 so this is already a rotation
+          Mat3 ri = ui * vi.transpose();
+          update(r + k, ui, sing, vi, ri);
+        }
+      }, 1000 / cStep);
+    }
 
   } // if dim end
 
@@ -771,6 +842,12 @@ IGL_INLINE void igl::slim_precompute(
 
   data.proximal_p = 0.0001;
 
+  // Discard any cached patterns/factorization from a previous problem
+  data.A.resize(0, 0);
+  data.A_data.resize(0);
+  data.AtA.resize(0, 0);
+  data.solver.reset();
+
   igl::doublearea(V, F, data.M);
   data.M /= 2.;
   data.mesh_area = data.M.sum();
@@ -10,16 +10,15 @@
 
 #include "igl_inline.h"
 #include "MappingEnergyType.h"
+#include "AtA_cached.h"
 #include <Eigen/Dense>
 #include <Eigen/Sparse>
+#include <memory>
 
-// This option makes the iterations faster (all except the first) by caching the 
-// sparsity pattern of the matrix involved in the assembly. It should be on if you plan to do many iterations, off if you have to change the matrix structure at every iteration.
-#define SLIM_CACHED 
-
-#ifdef SLIM_CACHED
-#include <igl/AtA_cached.h>
-#endif
+// SLIMData always has the cached members (A, A_data, AtA, AtA_data) and
+// caching is now switched at run time with SLIMData::cached. Still defined
+// for code that tests for it.
+#define SLIM_CACHED
 
 namespace igl
 {
@@ -41,6 +40,16 @@ struct SLIMData
   double exp_factor; // used for exponential energies, ignored otherwise
   bool mesh_improvement_3d; // only supported for 3d
 
+  // Options
+  // Cache the sparsity pattern of the matrices involved in the assembly and
+  // the symbolic factorization of the global step. This makes all iterations
+  // but the first faster. It should be on if you plan to do many iterations,
+  // off if you have to change the matrix structure at every iteration.
+  bool cached = true;
+  // Use the single precision 3x3 SVD (SSE/AVX batched when available) in the
+  // local step of tet meshes instead of Eigen's double precision JacobiSVD.
+  bool use_svd3x3 = false;
+
   // Output
   Eigen::MatrixXd V_o; // #V by dim list of mesh vertex positions (dim = 2 for parametrization, 3 otherwise)
   double energy; // objective value
@@ -63,12 +72,12 @@ struct SLIMData
   bool has_pre_calc = false;
   int dim;
 
-  #ifdef SLIM_CACHED
   Eigen::SparseMatrix<double> A;
   Eigen::VectorXi A_data;
   Eigen::SparseMatrix<double> AtA;
   igl::AtA_cached_data AtA_data;
-  #endif
+  // Global step solver (symbolic factorization reused when cached is on)
+  std::shared_ptr<Eigen::SimplicialLDLT<Eigen::SparseMatrix<double> > > solver;
 };
 
 // Compute necessary information to start using SLIM
@@ -100,6 +109,15 @@ IGL_INLINE void slim_update_weights_and_closest_rotations_with_jacobians(const E
                                                                     double exp_factor,
                                                                     Eigen::MatrixXd &W,
                                                                     Eigen::MatrixXd &Ri);
+// Inputs:
+//    use_svd3x3  whether to use the single precision igl::svd3x3 (batched with
+//      SSE/AVX when available) for tet meshes (see SLIMData::use_svd3x3)
+IGL_INLINE void slim_update_weights_and_closest_rotations_with_jacobians(const Eigen::MatrixXd &Ji,
+                                                                    igl::MappingEnergyType slim_energy,
+                                                                    double exp_factor,
+                                                                    const bool use_svd3x3,
+                                                                    Eigen::MatrixXd &W,
+                                                                    Eigen::MatrixXd &Ri);
 
 IGL_INLINE void slim_buildA(const Eigen::SparseMatrix<double> &Dx,
                         const Eigen::SparseMatrix<double> &Dy,
@@ -12,10 +12,56 @@
 #include "IndexComparison.h"
 #include "colon.h"
 #include "parallel_for.h"
+#include "parallel_sort.h"
+#include "radix_sort.h"
 
 #include <cassert>
 #include <algorithm>
+#include <cstdint>
 #include <iostream>
+#include <type_traits>
+
+namespace igl
+{
+  namespace sort_helpers
+  {
+    // Numbers: radix sort of their keys
+    template <class T>
+    IGL_INLINE void sort_index_map(
+      const std::vector<T> & unsorted,
+      std::vector<size_t> & index_map,
+      std::true_type)
+    {
+      const size_t n = unsorted.size();
+      if(n < 1024)
+      {
+        std::stable_sort(
+          index_map.begin(),
+          index_map.end(),
+          igl::IndexLessThan<const std::vector<T>& >(unsorted));
+        return;
+      }
+      std::vector<std::uint64_t> keys(n);
+      igl::parallel_for(n,[&](const size_t i)
+      {
+        keys[i] = igl::radix_sort_key(unsorted[index_map[i]]);
+      },1000ul);
+      igl::radix_sort(keys,index_map);
+    }
+    // Anything else with operator<: parallel comparison sort
+    template <class T>
+    IGL_INLINE void sort_index_map(
+      const std::vector<T> & unsorted,
+      std::vector<size_t> & index_map,
+      std::false_type)
+    {
+      igl::parallel_sort(
+        index_map.begin(),
+        index_map.end(),
+        igl::IndexLessThan<const std::vector<T>& >(unsorted));
+    }
+  }
+}
 
 template <typename DerivedX, typename DerivedY, typename DerivedIX>
 IGL_INLINE void igl::sort(
@@ -47,8 +93,9 @@ IGL_INLINE void igl::sort(
   Y.resizeLike(X);
   IX.resizeLike(X);
   // idea is to process each column (or row) as a std vector
-  // loop over columns (or rows)
-  for(int i = 0; i<num_outer;i++)
+  // loop over columns (or rows) in parallel unless each column (or row) is
+  // long enough to be sorted in parallel itself
+  igl::parallel_for(num_outer,[&](const int i)
   {
     // Unsorted index map for this column (or row)
     std::vector<size_t> index_map(num_inner);
@@ -78,7 +125,7 @@ IGL_INLINE void igl::sort(
         IX(i,j) = int(index_map[j]);
       }
     }
-  }
+  },num_inner < (1<<15) ? 2 : num_outer+1);
 }
 
 template <typename DerivedX, typename DerivedY>
@@ -309,10 +356,8 @@ for(size_t i=0;i<unsorted.size();i++)
   index_map[i] = i;
 }
 // Sort the index map, using unsorted for comparison
-std::sort(
-  index_map.begin(),
-  index_map.end(),
-  igl::IndexLessThan<const std::vector<T>& >(unsorted));
+sort_helpers::sort_index_map(
+  unsorted,index_map,std::integral_constant<bool,std::is_arithmetic<T>::value>());
 
 // if not ascending then reverse
 if(!ascending)
@@ -377,6 +422,10 @@ template void igl::sort<Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int,
 template void igl::sort<Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<long, -1, 1, 0, -1, 1> >(Eigen::DenseBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, int, bool, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<long, -1, 1, 0, -1, 1> >&);
 template void igl::sort<Eigen::Matrix<double, -1, 2, 0, -1, 2>, Eigen::Matrix<double, -1, 2, 0, -1, 2>, Eigen::Matrix<int, -1, 2, 0, -1, 2> >(Eigen::DenseBase<Eigen::Matrix<double, -1, 2, 0, -1, 2> > const&, int, bool, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 2, 0, -1, 2> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 2, 0, -1, 2> >&);
 template void igl::sort<Eigen::Matrix<int, -1, 2, 0, -1, 2>, Eigen::Matrix<int, -1, 2, 0, -1, 2>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::DenseBase<Eigen::Matrix<int, -1, 2, 0, -1, 2> > const&, int, bool, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 2, 0, -1, 2> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
+template void igl::sort<Eigen::Matrix<float, -1, 2, 0, -1, 2>, Eigen::Matrix<float, -1, 2, 0, -1, 2>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::DenseBase<Eigen::Matrix<float, -1, 2, 0, -1, 2> > const&, int, bool, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, 2, 0, -1, 2> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
+template void igl::sort<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1>, Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> >(Eigen::DenseBase<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> > const&, int, bool, Eigen::PlainObjectBase<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> >&);
+template void igl::sort<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1>, Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1>, Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> >(Eigen::DenseBase<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> > const&, int, bool, Eigen::PlainObjectBase<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> >&);
+template void igl::sort<Eigen::Matrix<std::int64_t, -1, 2, 0, -1, 2>, Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1>, Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> >(Eigen::DenseBase<Eigen::Matrix<std::int64_t, -1, 2, 0, -1, 2> > const&, int, bool, Eigen::PlainObjectBase<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> >&);
 #ifdef WIN32
 template void igl::sort<class Eigen::Matrix<int,-1,1,0,-1,1>,class Eigen::Matrix<int,-1,1,0,-1,1>,class Eigen::Matrix<__int64,-1,1,0,-1,1> >(class Eigen::DenseBase<class Eigen::Matrix<int,-1,1,0,-1,1> > const &,int,bool,class Eigen::PlainObjectBase<class Eigen::Matrix<int,-1,1,0,-1,1> > &,class Eigen::PlainObjectBase<class Eigen::Matrix<__int64,-1,1,0,-1,1> > &);
 template void igl::sort<__int64>(class std::vector<__int64,class std::allocator<__int64> > const &,bool,class std::vector<__int64,class std::allocator<__int64> > &,class std::vector<unsigned __int64,class std::allocator<unsigned __int64> > &);
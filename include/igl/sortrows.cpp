@@ -12,7 +12,13 @@
 #include "sort.h"
 #include "colon.h"
 #include "IndexComparison.h"
+#include "parallel_for.h"
+#include "parallel_sort.h"
+#include "radix_sort.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
 #include <vector>
 
 // Obsolete slower version converst to vector
@@ -49,6 +55,148 @@
 //  }
 //}
 
+namespace igl
+{
+  namespace sortrows_helpers
+  {
+    // Numbers: columns are mapped to radix_sort keys relative to their
+    // minimum key and as many leading columns as fit are packed into one
+    // 64-bit key, which is radix sorted. Runs of equal keys are then sorted
+    // by the remaining columns (if any) with a comparison sort. Ties keep
+    // their input order.
+    template <typename DerivedX, typename Index>
+    IGL_INLINE void sort_rows(
+      const Eigen::DenseBase<DerivedX>& X,
+      const bool ascending,
+      std::vector<Index> & I,
+      std::true_type)
+    {
+      const size_t num_rows = X.rows();
+      const Eigen::Index num_cols = X.cols();
+      // Range of keys of each column
+      std::vector<std::uint64_t> lo(num_cols,~std::uint64_t(0)), hi(num_cols,0);
+      {
+        std::vector<std::vector<std::uint64_t> > Tlo,Thi;
+        igl::parallel_for(
+          num_rows,
+          [&](const size_t nt)
+          {
+            Tlo.resize(nt,lo);
+            Thi.resize(nt,hi);
+          },
+          [&](const size_t i, const size_t t)
+          {
+            for(Eigen::Index c = 0;c<num_cols;c++)
+            {
+              const std::uint64_t k = igl::radix_sort_key(X.coeff(i,c));
+              Tlo[t][c] = std::min(Tlo[t][c],k);
+              Thi[t][c] = std::max(Thi[t][c],k);
+            }
+          },
+          [&](const size_t t)
+          {
+            for(Eigen::Index c = 0;c<num_cols;c++)
+            {
+              lo[c] = std::min(lo[c],Tlo[t][c]);
+              hi[c] = std::max(hi[c],Thi[t][c]);
+            }
+          },
+          1000ul);
+      }
+      std::vector<int> bits(num_cols,0);
+      for(Eigen::Index c = 0;c<num_cols;c++)
+      {
+        while(bits[c] < 64 && ((hi[c]-lo[c])>>bits[c]))
+        {
+          bits[c]++;
+        }
+      }
+      // Leading columns [0,end) that fit in one key
+      Eigen::Index end = 0;
+      for(int total = 0;end<num_cols && total+bits[end] <= 64;end++)
+      {
+        total += bits[end];
+      }
+      std::vector<std::uint64_t> keys(num_rows);
+      igl::parallel_for(num_rows,[&](const size_t j)
+      {
+        std::uint64_t key = 0;
+        for(Eigen::Index c = 0;c<end;c++)
+        {
+          if(bits[c] < 64)
+          {
+            key <<= bits[c];
+          }
+          key |= igl::radix_sort_key(X.coeff(I[j],c))-lo[c];
+        }
+        keys[j] = ascending ? key : ~key;
+      },1000ul);
+      igl::radix_sort(keys,I);
+      if(end == num_cols)
+      {
+        return;
+      }
+      const auto & less = [&](const Index a, const Index b)
+      {
+        for(Eigen::Index c = end;c<num_cols;c++)
+        {
+          if(X.coeff(a,c) != X.coeff(b,c))
+          {
+            return ascending ?
+              X.coeff(a,c) < X.coeff(b,c) : X.coeff(a,c) > X.coeff(b,c);
+          }
+        }
+        return a < b;
+      };
+      igl::parallel_for(num_rows,[&](const size_t j)
+      {
+        if(j > 0 && keys[j] == keys[j-1])
+        {
+          return;
+        }
+        size_t k = j+1;
+        while(k < num_rows && keys[k] == keys[j])
+        {
+          k++;
+        }
+        if(k-j > 1)
+        {
+          std::sort(I.begin()+j,I.begin()+k,less);
+        }
+      },1000ul);
+    }
+    // Anything else with operator<: parallel comparison sort
+    template <typename DerivedX, typename Index>
+    IGL_INLINE void sort_rows(
+      const Eigen::DenseBase<DerivedX>& X,
+      const bool ascending,
+      std::vector<Index> & I,
+      std::false_type)
+    {
+      const size_t num_cols = X.cols();
+      if (ascending) {
+        auto index_less_than = [&X, num_cols](size_t i, size_t j) {
+          for (size_t c=0; c<num_cols; c++) {
+            if (X.coeff(i, c) < X.coeff(j, c)) return true;
+            else if (X.coeff(j,c) < X.coeff(i,c)) return false;
+          }
+          return false;
+        };
+        igl::parallel_sort(I.begin(),I.end(),index_less_than);
+      } else {
+        auto index_greater_than = [&X, num_cols](size_t i, size_t j) {
+          for (size_t c=0; c<num_cols; c++) {
+            if (X.coeff(i, c) > X.coeff(j, c)) return true;
+            else if (X.coeff(j,c) > X.coeff(i,c)) return false;
+          }
+          return false;
+        };
+        igl::parallel_sort(I.begin(),I.end(),index_greater_than);
+      }
+    }
+  }
+}
+
 template <typename DerivedX, typename DerivedIX>
 IGL_INLINE void igl::sortrows(
   const Eigen::DenseBase<DerivedX>& X,
@@ -56,53 +204,27 @@ IGL_INLINE void igl::sortrows(
   Eigen::PlainObjectBase<DerivedX>& Y,
   Eigen::PlainObjectBase<DerivedIX>& IX)
 {
-  // This is already 2x faster than matlab's builtin `sortrows`. I have tried
-  // implementing a "multiple-pass" sort on each column, but see no performance
-  // improvement.
-  using namespace std;
-  using namespace Eigen;
   // Resize output
   const size_t num_rows = X.rows();
   const size_t num_cols = X.cols();
   Y.resize(num_rows,num_cols);
   IX.resize(num_rows,1);
-  for(int i = 0;i<num_rows;i++)
+  std::vector<size_t> I(num_rows);
+  for(size_t i = 0;i<num_rows;i++)
   {
-    IX(i) = i;
-  }
-  if (ascending) {
-    auto index_less_than = [&X, num_cols](size_t i, size_t j) {
-      for (size_t c=0; c<num_cols; c++) {
-        if (X.coeff(i, c) < X.coeff(j, c)) return true;
-        else if (X.coeff(j,c) < X.coeff(i,c)) return false;
-      }
-      return false;
-    };
-      std::sort(
-        IX.data(),
-        IX.data()+IX.size(),
-        index_less_than
-        );
-  } else {
-    auto index_greater_than = [&X, num_cols](size_t i, size_t j) {
-      for (size_t c=0; c<num_cols; c++) {
-        if (X.coeff(i, c) > X.coeff(j, c)) return true;
-        else if (X.coeff(j,c) > X.coeff(i,c)) return false;
-      }
-      return false;
-    };
-      std::sort(
-        IX.data(),
-        IX.data()+IX.size(),
-        index_greater_than
-        );
-  }
-  for (size_t j=0; j<num_cols; j++) {
-      for(int i = 0;i<num_rows;i++)
-      {
-          Y(i,j) = X(IX(i), j);
-      }
+    I[i] = i;
   }
+  typedef typename DerivedX::Scalar Scalar;
+  sortrows_helpers::sort_rows(
+    X,ascending,I,std::integral_constant<bool,std::is_arithmetic<Scalar>::value>());
+  igl::parallel_for(num_rows,[&](const size_t i)
+  {
+    IX(i) = I[i];
+    for(size_t j = 0;j<num_cols;j++)
+    {
+      Y(i,j) = X(I[i],j);
+    }
+  },1000ul);
 }
 
 template <typename DerivedX >
@@ -154,6 +276,7 @@ template void igl::sortrows<Eigen::Matrix<int, -1, 2, 0, -1, 2>, Eigen::Matrix<i
 template void igl::sortrows<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::DenseBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, bool, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
 template void igl::sortrows<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<long, -1, 1, 0, -1, 1> >(Eigen::DenseBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, bool, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<long, -1, 1, 0, -1, 1> >&);
 template void igl::sortrows<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::DenseBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, bool, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
+template void igl::sortrows<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::DenseBase<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> > const&, bool, Eigen::PlainObjectBase<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
 #ifdef WIN32
 template void igl::sortrows<class Eigen::Matrix<double,-1,-1,0,-1,-1>,class Eigen::Matrix<__int64,-1,1,0,-1,1> >(class Eigen::DenseBase<class Eigen::Matrix<double,-1,-1,0,-1,-1> > const &,bool,class Eigen::PlainObjectBase<class Eigen::Matrix<double,-1,-1,0,-1,-1> > &,class Eigen::PlainObjectBase<class Eigen::Matrix<__int64,-1,1,0,-1,1> > &);
 template void igl::sortrows<class Eigen::Matrix<int,-1,2,0,-1,2>,class Eigen::Matrix<__int64,-1,1,0,-1,1> >(class Eigen::DenseBase<class Eigen::Matrix<int,-1,2,0,-1,2> > const &,bool,class Eigen::PlainObjectBase<class Eigen::Matrix<int,-1,2,0,-1,2> > &,class Eigen::PlainObjectBase<class Eigen::Matrix<__int64,-1,1,0,-1,1> > &);
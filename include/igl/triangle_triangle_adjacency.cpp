@@ -10,7 +10,9 @@
 #include "vertex_triangle_adjacency.h"
 #include "parallel_for.h"
 #include "unique_edge_map.h"
+#include "radix_sort.h"
 #include <algorithm>
+#include <cstdint>
 #include <iostream>
 
 // Extract the face adjacencies
@@ -20,12 +22,12 @@ IGL_INLINE void igl::triangle_triangle_adjacency_extractTT(
   std::vector<std::vector<TTT_type> >& TTT,
   Eigen::PlainObjectBase<DerivedTT>& TT)
 {
-  TT.setConstant((int)(F.rows()),F.cols(),-1);
+  TT.setConstant(F.rows(),F.cols(),-1);
 
-  for(int i=1;i<(int)TTT.size();++i)
+  for(size_t i=1;i<TTT.size();++i)
   {
-    std::vector<int>& r1 = TTT[i-1];
-    std::vector<int>& r2 = TTT[i];
+    const std::vector<TTT_type>& r1 = TTT[i-1];
+    const std::vector<TTT_type>& r2 = TTT[i];
     if ((r1[0] == r2[0]) && (r1[1] == r2[1]))
     {
       TT(r1[2],r1[3]) = r2[2];
@@ -39,22 +41,24 @@ IGL_INLINE void igl::triangle_triangle_adjacency(
   const Eigen::MatrixBase<DerivedF>& F,
   Eigen::PlainObjectBase<DerivedTT>& TT)
 {
-  const int n = F.maxCoeff()+1;
-  typedef Eigen::Matrix<typename DerivedTT::Scalar,Eigen::Dynamic,1> VectorXI;
+  typedef typename DerivedF::Scalar FIndex;
+  typedef typename DerivedTT::Scalar TTIndex;
+  const Eigen::Index n = F.maxCoeff()+1;
+  typedef Eigen::Matrix<TTIndex,Eigen::Dynamic,1> VectorXI;
   VectorXI VF,NI;
   vertex_triangle_adjacency(F,n,VF,NI);
   TT = DerivedTT::Constant(F.rows(),3,-1);
   // Loop over faces
-  igl::parallel_for(F.rows(),[&](int f)
+  igl::parallel_for(F.rows(),[&](const Eigen::Index f)
   {
     // Loop over corners
     for (int k = 0; k < 3; k++)
     {
-      int vi = F(f,k), vin = F(f,(k+1)%3);
+      const FIndex vi = F(f,k), vin = F(f,(k+1)%3);
       // Loop over face neighbors incident on this corner
-      for (int j = NI[vi]; j < NI[vi+1]; j++)
+      for (TTIndex j = NI[vi]; j < NI[vi+1]; j++)
       {
-        int fn = VF[j];
+        const TTIndex fn = VF[j];
         // Not this face
         if (fn != f)
         {
@@ -70,24 +74,69 @@ IGL_INLINE void igl::triangle_triangle_adjacency(
   });
 }
 
+template <typename Index, typename DerivedTT, typename DerivedTTi>
+IGL_INLINE void igl::triangle_triangle_adjacency(
+  const HalfEdgeMesh<Index> & H,
+  Eigen::PlainObjectBase<DerivedTT>& TT,
+  Eigen::PlainObjectBase<DerivedTTi>& TTi)
+{
+  TT.resize(H.num_faces(),3);
+  TTi.resize(H.num_faces(),3);
+  igl::parallel_for(H.num_halfedges(),[&](const Index h)
+  {
+    const Index t = H.twin(h);
+    TT(h/3,h%3) = t < 0 ? -1 : t/3;
+    TTi(h/3,h%3) = t < 0 ? -1 : t%3;
+  },1000ul);
+}
+
 template <typename DerivedF, typename TTT_type>
 IGL_INLINE void igl::triangle_triangle_adjacency_preprocess(
   const Eigen::MatrixBase<DerivedF>& F,
   std::vector<std::vector<TTT_type> >& TTT)
 {
-  for(int f=0;f<F.rows();++f)
-    for (int i=0;i<F.cols();++i)
+  // v1 v2 f ei rows sorted lexicographically: sort (v1,v2) keys of the
+  // half-edges, which are already ordered by (f,ei)
+  const Eigen::Index m = F.rows();
+  const Eigen::Index c = F.cols();
+  if(m > 0 && std::uint64_t(F.maxCoeff()) > 0xFFFFFFFFull)
+  {
+    // Vertex indices do not fit in half a key: sort the rows directly
+    TTT.resize(m*c);
+    igl::parallel_for(m,[&](const Eigen::Index f)
     {
-      // v1 v2 f ei
-      int v1 = F(f,i);
-      int v2 = F(f,(i+1)%F.cols());
+      for(Eigen::Index i = 0;i<c;i++)
+      {
+        TTT_type v1 = F(f,i);
+        TTT_type v2 = F(f,(i+1)%c);
+        if (v1 > v2) std::swap(v1,v2);
+        TTT[f*c+i] = {v1,v2,TTT_type(f),TTT_type(i)};
+      }
+    },1000ul);
+    std::sort(TTT.begin(),TTT.end());
+    return;
+  }
+  std::vector<std::uint64_t> keys(m*c);
+  std::vector<Eigen::Index> H(m*c);
+  igl::parallel_for(m,[&](const Eigen::Index f)
+  {
+    for(Eigen::Index i = 0;i<c;i++)
+    {
+      std::uint64_t v1 = F(f,i);
+      std::uint64_t v2 = F(f,(i+1)%c);
       if (v1 > v2) std::swap(v1,v2);
-      std::vector<int> r(4);
-      r[0] = v1; r[1] = v2;
-      r[2] = f;  r[3] = i;
-      TTT.push_back(r);
+      keys[f*c+i] = (v1<<32) | v2;
+      H[f*c+i] = f*c+i;
     }
-  std::sort(TTT.begin(),TTT.end());
+  },1000ul);
+  igl::radix_sort(keys,H);
+  TTT.resize(keys.size());
+  igl::parallel_for(keys.size(),[&](const size_t j)
+  {
+    TTT[j] = {
+      TTT_type(keys[j]>>32), TTT_type(keys[j] & 0xFFFFFFFF),
+      TTT_type(H[j]/c), TTT_type(H[j]%c)};
+  },1000ul);
 }
 
 // Extract the face adjacencies indices (needed for fast traversal)
@@ -97,12 +146,12 @@ IGL_INLINE void igl::triangle_triangle_adjacency_extractTTi(
   std::vector<std::vector<TTT_type> >& TTT,
   Eigen::PlainObjectBase<DerivedTTi>& TTi)
 {
-  TTi.setConstant((int)(F.rows()),F.cols(),-1);
+  TTi.setConstant(F.rows(),F.cols(),-1);
 
-  for(int i=1;i<(int)TTT.size();++i)
+  for(size_t i=1;i<TTT.size();++i)
   {
-    std::vector<int>& r1 = TTT[i-1];
-    std::vector<int>& r2 = TTT[i];
+    const std::vector<TTT_type>& r1 = TTT[i-1];
+    const std::vector<TTT_type>& r2 = TTT[i];
     if ((r1[0] == r2[0]) && (r1[1] == r2[1]))
     {
       TTi(r1[2],r1[3]) = r2[3];
@@ -120,18 +169,19 @@ IGL_INLINE void igl::triangle_triangle_adjacency(
 {
   triangle_triangle_adjacency(F,TT);
   TTi = DerivedTTi::Constant(TT.rows(),TT.cols(),-1);
+  typedef typename DerivedF::Scalar FIndex;
   //for(int f = 0; f<F.rows(); f++)
-  igl::parallel_for(F.rows(),[&](int f)
+  igl::parallel_for(F.rows(),[&](const Eigen::Index f)
   {
     for(int k = 0;k<3;k++)
     {
-      int vi = F(f,k), vj = F(f,(k+1)%3);
-      int fn = TT(f,k);
+      const FIndex vi = F(f,k), vj = F(f,(k+1)%3);
+      const typename DerivedTT::Scalar fn = TT(f,k);
       if(fn >= 0)
       {
         for(int kn = 0;kn<3;kn++)
         {
-          int vin = F(fn,kn), vjn = F(fn,(kn+1)%3);
+          const FIndex vin = F(fn,kn), vjn = F(fn,(kn+1)%3);
           if(vi == vjn && vin == vj)
           {
             TTi(f,k) = kn;
@@ -266,6 +316,10 @@ template void igl::triangle_triangle_adjacency<Eigen::Matrix<int, -1, 3, 0, -1,
 template void igl::triangle_triangle_adjacency<Eigen::Matrix<int, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, 3, 0, -1, 3> >(Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 0, -1, 3> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 3, 0, -1, 3> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 3, 0, -1, 3> >&);
 template void igl::triangle_triangle_adjacency<Eigen::Matrix<int, -1, -1, 0, -1, -1>, long, long>(Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, std::vector<std::vector<std::vector<long, std::allocator<long> >, std::allocator<std::vector<long, std::allocator<long> > > >, std::allocator<std::vector<std::vector<long, std::allocator<long> >, std::allocator<std::vector<long, std::allocator<long> > > > > >&, std::vector<std::vector<std::vector<long, std::allocator<long> >, std::allocator<std::vector<long, std::allocator<long> > > >, std::allocator<std::vector<std::vector<long, std::allocator<long> >, std::allocator<std::vector<long, std::allocator<long> > > > > >&);
 template void igl::triangle_triangle_adjacency<Eigen::Matrix<int, -1, -1, 0, -1, -1>, int>(Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, std::vector<std::vector<std::vector<int, std::allocator<int> >, std::allocator<std::vector<int, std::allocator<int> > > >, std::allocator<std::vector<std::vector<int, std::allocator<int> >, std::allocator<std::vector<int, std::allocator<int> > > > > >&);
+template void igl::triangle_triangle_adjacency<int, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(igl::HalfEdgeMesh<int> const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
+template void igl::triangle_triangle_adjacency<std::int64_t, Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1>, Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> >(igl::HalfEdgeMesh<std::int64_t> const&, Eigen::PlainObjectBase<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> >&);
+template void igl::triangle_triangle_adjacency<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1>, Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1>, Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> >&);
+template void igl::triangle_triangle_adjacency<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1>, std::int64_t, std::int64_t>(Eigen::MatrixBase<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> > const&, std::vector<std::vector<std::vector<std::int64_t, std::allocator<std::int64_t> >, std::allocator<std::vector<std::int64_t, std::allocator<std::int64_t> > > >, std::allocator<std::vector<std::vector<std::int64_t, std::allocator<std::int64_t> >, std::allocator<std::vector<std::int64_t, std::allocator<std::int64_t> > > > > >&, std::vector<std::vector<std::vector<std::int64_t, std::allocator<std::int64_t> >, std::allocator<std::vector<std::int64_t, std::allocator<std::int64_t> > > >, std::allocator<std::vector<std::vector<std::int64_t, std::allocator<std::int64_t> >, std::allocator<std::vector<std::int64_t, std::allocator<std::int64_t> > > > > >&);
 #ifdef WIN32
 template void igl::triangle_triangle_adjacency<class Eigen::Matrix<int, -1, -1, 0, -1, -1>, __int64, __int64>(class Eigen::MatrixBase<class Eigen::Matrix<int, -1, -1, 0, -1, -1>> const &, class std::vector<class std::vector<class std::vector<__int64, class std::allocator<__int64>>, class std::allocator<class std::vector<__int64, class std::allocator<__int64>>>>, class std::allocator<class std::vector<class std::vector<__int64, class std::allocator<__int64>>, class std::allocator<class std::vector<__int64, class std::allocator<__int64>>>>>> &, class std::vector<class std::vector<class std::vector<__int64, class std::allocator<__int64>>, class std::allocator<class std::vector<__int64, class std::allocator<__int64>>>>, class std::allocator<class std::vector<class std::vector<__int64, class std::allocator<__int64>>, class std::allocator<class std::vector<__int64, class std::allocator<__int64>>>>>> &);
 template void igl::triangle_triangle_adjacency<class Eigen::Matrix<int, -1, -1, 0, -1, -1>, class Eigen::Matrix<int, -1, 1, 0, -1, 1>, unsigned __int64, int, int>(class Eigen::MatrixBase<class Eigen::Matrix<int, -1, -1, 0, -1, -1>> const &, class Eigen::MatrixBase<class Eigen::Matrix<int, -1, 1, 0, -1, 1>> const &, class std::vector<class std::vector<unsigned __int64, class std::allocator<unsigned __int64>>, class std::allocator<class std::vector<unsigned __int64, class std::allocator<unsigned __int64>>>> const &, bool, class std::vector<class std::vector<class std::vector<int, class std::allocator<int>>, class std::allocator<class std::vector<int, class std::allocator<int>>>>, class std::allocator<class std::vector<class std::vector<int, class std::allocator<int>>, class std::allocator<class std::vector<int, class std::allocator<int>>>>>> &, class std::vector<class std::vector<class std::vector<int, class std::allocator<int>>, class std::allocator<class std::vector<int, class std::allocator<int>>>>, class std::allocator<class std::vector<class std::vector<int, class std::allocator<int>>, class std::allocator<class std::vector<int, class std::allocator<int>>>>>> &);
@@ -8,6 +8,7 @@
 #ifndef IGL_TRIANGLE_TRIANGLE_ADJACENCY_H
 #define IGL_TRIANGLE_TRIANGLE_ADJACENCY_H
 #include "igl_inline.h"
+#include "HalfEdgeMesh.h"
 #include <Eigen/Core>
 #include <vector>
 
@@ -46,7 +47,26 @@ namespace igl
   IGL_INLINE void triangle_triangle_adjacency(
     const Eigen::MatrixBase<DerivedF>& F,
     Eigen::PlainObjectBase<DerivedTT>& TT);
+  // Inputs:
+  //   H  half-edge connectivity of F
+  //
+  // Same TT and TTi for edge-manifold meshes, non-manifold edges are treated
+  // as boundary (-1).
+  template <typename Index, typename DerivedTT, typename DerivedTTi>
+  IGL_INLINE void triangle_triangle_adjacency(
+    const HalfEdgeMesh<Index> & H,
+    Eigen::PlainObjectBase<DerivedTT>& TT,
+    Eigen::PlainObjectBase<DerivedTTi>& TTi);
   // Preprocessing
+  //
+  // Inputs:
+  //   F  #F by simplex_size list of mesh faces
+  // Outputs:
+  //   TTT  #F*simplex_size list of [v1 v2 f ei] rows for each face edge ei
+  //     (v1 < v2) sorted lexicographically
+  //
+  // Note: TTT needs one small allocation per row, the Eigen TT/TTi
+  // overloads above do not.
   template <typename DerivedF, typename TTT_type>
   IGL_INLINE void triangle_triangle_adjacency_preprocess(
     const Eigen::MatrixBase<DerivedF>& F,
@@ -6,9 +6,9 @@
 // v. 2.0. If a copy of the MPL was not distributed with this file, You can
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "vertex_components.h"
-#include "adjacency_matrix.h"
-#include <queue>
-#include <vector>
+#include "UnionFind.h"
+#include "parallel_for.h"
+#include <cassert>
 
 template <typename DerivedA, typename DerivedC, typename Derivedcounts>
 IGL_INLINE void igl::vertex_components(
@@ -16,55 +16,20 @@ IGL_INLINE void igl::vertex_components(
   Eigen::PlainObjectBase<DerivedC> & C,
   Eigen::PlainObjectBase<Derivedcounts> & counts)
 {
-  using namespace Eigen;
-  using namespace std;
+  typedef typename DerivedA::StorageIndex Index;
   assert(A.rows() == A.cols() && "A should be square.");
-  const size_t n = A.rows();
-  Array<bool,Dynamic,1> seen = Array<bool,Dynamic,1>::Zero(n,1);
-  C.resize(n,1);
-  typename DerivedC::Scalar id = 0;
-  vector<typename Derivedcounts::Scalar> vcounts;
-  // breadth first search
-  for(int k=0; k<A.outerSize(); ++k)
+  UnionFind<Index> U(Index(A.rows()));
+  parallel_for(A.outerSize(),[&](const Eigen::Index k)
   {
-    if(seen(k))
+    for(typename DerivedA::InnerIterator it (A,k); it; ++it)
     {
-      continue;
-    }
-    queue<int> Q;
-    Q.push(k);
-    vcounts.push_back(0);
-    while(!Q.empty())
-    {
-      const int f = Q.front();
-      Q.pop();
-      if(seen(f))
-      {
-        continue;
-      }
-      seen(f) = true;
-      C(f,0) = id;
-      vcounts[id]++;
-      // Iterate over inside
-      for(typename DerivedA::InnerIterator it (A,f); it; ++it)
+      if(it.value())
       {
-        const int g = it.index();
-        if(!seen(g) && it.value())
-        {
-          Q.push(g);
-        }
+        U.unite(Index(k),Index(it.index()));
       }
     }
-    id++;
-  }
-  assert((size_t) id == vcounts.size());
-  const size_t ncc = vcounts.size();
-  assert((size_t)C.maxCoeff()+1 == ncc);
-  counts.resize(ncc,1);
-  for(size_t i = 0;i<ncc;i++)
-  {
-    counts(i) = vcounts[i];
-  }
+  },1000ul);
+  U.components(C,counts);
 }
 
 template <typename DerivedA, typename DerivedC>
@@ -81,9 +46,20 @@ IGL_INLINE void igl::vertex_components(
   const Eigen::MatrixBase<DerivedF> & F,
   Eigen::PlainObjectBase<DerivedC> & C)
 {
-  Eigen::SparseMatrix<typename DerivedC::Scalar> A;
-  adjacency_matrix(F,A);
-  return vertex_components(A,C);
+  // Merge the corners of each simplex directly rather than building
+  // adjacency_matrix(F)
+  typedef typename DerivedF::Scalar Index;
+  const Index n = F.size() == 0 ? 0 : F.maxCoeff()+1;
+  UnionFind<Index> U(n);
+  parallel_for(F.rows(),[&](const Eigen::Index f)
+  {
+    for(Eigen::Index c = 1;c<F.cols();c++)
+    {
+      U.unite(F(f,0),F(f,c));
+    }
+  },1000ul);
+  Eigen::Matrix<Index,Eigen::Dynamic,1> counts;
+  U.components(C,counts);
 }
 
 #ifdef IGL_STATIC_LIBRARY
@@ -95,4 +71,5 @@ template void igl::vertex_components<Eigen::SparseMatrix<int, 0, int>, Eigen::Ma
 template void igl::vertex_components<Eigen::SparseMatrix<int, 0, int>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::SparseCompressedBase<Eigen::SparseMatrix<int, 0, int>> const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
 template void igl::vertex_components<Eigen::SparseMatrix<double, 0, int>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::SparseCompressedBase<Eigen::SparseMatrix<double, 0, int>> const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
 template void igl::vertex_components<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
+template void igl::vertex_components<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1>, Eigen::Matrix<std::int64_t, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<std::int64_t, -1, 1, 0, -1, 1> >&);
 #endif
@@ -16,6 +16,7 @@ namespace igl
   // matrix.
   //
   // Returns a component ID per vertex of the graph where connectivity is established by edges.
+  // Components are numbered in order of their smallest vertex.
   //
   // Inputs:
   //   A  n by n adjacency matrix
@@ -36,6 +37,8 @@ namespace igl
 
   // Compute the connected components for a mesh given its faces.
   // Returns a component ID per vertex of the mesh where connectivity is established by edges.
+  // Corners of each simplex are merged in parallel with a lock-free union-find
+  // (see UnionFind.h), without building adjacency_matrix(F).
   //
   // For computing connected components per face see igl::facet_components
   //
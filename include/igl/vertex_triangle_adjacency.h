@@ -9,6 +9,7 @@
 #define IGL_VERTEX_TRIANGLE_ADJACENCY_H
 #include "igl_inline.h"
 
+#include "HalfEdgeMesh.h"
 #include <Eigen/Dense>
 #include <vector>
 
@@ -62,6 +63,15 @@ namespace igl
     const int n,
     Eigen::PlainObjectBase<DerivedVF> & VF,
     Eigen::PlainObjectBase<DerivedNI> & NI);
+  // Inputs:
+  //   H  half-edge connectivity of F (n = H.num_vertices())
+  //
+  // Same VF and NI, faces of each vertex listed in increasing order.
+  template <typename Index, typename DerivedVF, typename DerivedNI>
+  IGL_INLINE void vertex_triangle_adjacency(
+    const HalfEdgeMesh<Index> & H,
+    Eigen::PlainObjectBase<DerivedVF> & VF,
+    Eigen::PlainObjectBase<DerivedNI> & NI);
 }
 
 #ifndef IGL_STATIC_LIBRARY
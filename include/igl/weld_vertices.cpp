@@ -0,0 +1,364 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2023 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "weld_vertices.h"
+#include "radix_sort.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include "parallel_for.h"
+
+template <
+  typename DerivedV,
+  typename DerivedSV,
+  typename DerivedSVI,
+  typename DerivedSVJ>
+IGL_INLINE void igl::weld_vertices(
+  const Eigen::MatrixBase<DerivedV> & V,
+  const double epsilon,
+  Eigen::PlainObjectBase<DerivedSV> & SV,
+  Eigen::PlainObjectBase<DerivedSVI> & SVI,
+  Eigen::PlainObjectBase<DerivedSVJ> & SVJ)
+{
+  const int n = V.rows();
+  const int dim = V.cols();
+  assert(dim <= 32 && "near-face bits are stored in 64 bits");
+  // Cells are at least epsilon wide, so close vertices are in the same or
+  // adjacent cells, and only vertices within epsilon of a cell face need to
+  // look into adjacent cells. Cells are grown (up to 1024 epsilon) towards
+  // the mean vertex spacing to make that rare while keeping few unrelated
+  // vertices per cell.
+  double h = epsilon;
+  if(epsilon > 0 && n > 0)
+  {
+    const auto min_corner = V.colwise().minCoeff().eval();
+    const auto max_corner = V.colwise().maxCoeff().eval();
+    const double extent = double((max_corner-min_corner).maxCoeff());
+    const double spacing = extent/std::pow(double(n),1.0/dim);
+    h = std::max(epsilon,std::min(1024.0*epsilon,spacing));
+  }
+  // Row-major copy of V so each vertex is read from one place, and bits 2d
+  // and 2d+1 marking whether a vertex is within epsilon of the lower and
+  // upper face of its cell along d
+  std::vector<double> P(std::size_t(n)*dim);
+  std::vector<std::uint64_t> near(n,0);
+  parallel_for(n,[&](const int i)
+  {
+    std::uint64_t near_i = 0;
+    for(int d = 0;d<dim;d++)
+    {
+      const double x = double(V(i,d));
+      P[std::size_t(i)*dim+d] = x;
+      if(epsilon > 0)
+      {
+        const double c = std::floor(x/h);
+        // Err on the side of looking (slack for rounding)
+        const double e = epsilon/h + 1e-9;
+        near_i |= std::uint64_t(x/h-c <= e)<<(2*d);
+        near_i |= std::uint64_t(c+1-x/h <= e)<<(2*d+1);
+      }
+    }
+    near[i] = near_i;
+  },1000ul);
+  // Integer cell coordinate of vertex i along d. For exact matching a cell
+  // is a single point (-0 and 0 share a cell). Far out coordinates (and nan)
+  // are clamped to ±2^62 so that the conversion and the neighboring offsets
+  // never overflow: such vertices merely share cells and are still compared
+  // exactly by close.
+  const double max_cell = 4611686018427387904.0;
+  const auto cell = [&](const int i, const int d)->std::int64_t
+  {
+    const double x = P[std::size_t(i)*dim+d];
+    return epsilon > 0 ?
+      std::int64_t(std::max(-max_cell,std::min(max_cell,std::floor(x/h)))) :
+      std::int64_t(radix_sort_key(x));
+  };
+  // 3^dim neighboring cells (including own cell in the middle), offset o
+  // moves along dimension d by O[o*dim+d]
+  int num_offsets = 1;
+  if(epsilon > 0)
+  {
+    for(int d = 0;d<dim;d++)
+    {
+      num_offsets *= 3;
+    }
+  }
+  const int own = num_offsets/2;
+  std::vector<std::int64_t> O(std::size_t(num_offsets)*dim,0);
+  // Bits of near that must be set for offset o to be worth looking at
+  std::vector<std::uint64_t> O_near(num_offsets,0);
+  if(num_offsets > 1)
+  {
+    for(int o = 0;o<num_offsets;o++)
+    {
+      for(int d = 0, p = o;d<dim;d++, p /= 3)
+      {
+        O[std::size_t(o)*dim+d] = p%3-1;
+        if(p%3 != 1)
+        {
+          O_near[o] |= std::uint64_t(1)<<(2*d+p%3/2);
+        }
+      }
+    }
+  }
+  const auto hash = [&](const int i, const int o)->std::uint64_t
+  {
+    std::uint64_t k = 0;
+    for(int d = 0;d<dim;d++)
+    {
+      k = (k ^ std::uint64_t(cell(i,d)+O[std::size_t(o)*dim+d]))*
+        0x9E3779B97F4A7C15ull;
+      k ^= k>>29;
+    }
+    return k;
+  };
+  // Is cell of i offset by o the cell of j?
+  const auto same_cell = [&](const int i, const int o, const int j)
+  {
+    for(int d = 0;d<dim;d++)
+    {
+      if(cell(i,d)+O[std::size_t(o)*dim+d] != cell(j,d))
+      {
+        return false;
+      }
+    }
+    return true;
+  };
+  const auto close = [&](const int i, const int j)
+  {
+    for(int d = 0;d<dim;d++)
+    {
+      const double xi = P[std::size_t(i)*dim+d];
+      const double xj = P[std::size_t(j)*dim+d];
+      if(epsilon > 0 ? !(std::abs(xi-xj) <= epsilon) : xi != xj)
+      {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  // Open addressing hash table of cells: slot holds the first vertex inserted
+  // into a cell and heads a lock-free linked list of the cell's vertices
+  std::size_t num_slots = 1;
+  while(num_slots < 2*std::size_t(n))
+  {
+    num_slots *= 2;
+  }
+  const std::size_t slot_mask = num_slots-1;
+  std::vector<std::atomic<int>> slots(num_slots);
+  std::vector<std::atomic<int>> heads(num_slots);
+  parallel_for(num_slots,[&](const std::size_t s)
+  {
+    slots[s].store(-1,std::memory_order_relaxed);
+    heads[s].store(-1,std::memory_order_relaxed);
+  },1000ul);
+  // Slot of the cell of each vertex
+  std::vector<std::size_t> S(n);
+  std::vector<int> next(n);
+  parallel_for(n,[&](const int i)
+  {
+    std::size_t s = hash(i,own) & slot_mask;
+    while(true)
+    {
+      int j = slots[s].load(std::memory_order_acquire);
+      if(j < 0)
+      {
+        if(slots[s].compare_exchange_strong(j,i,std::memory_order_acq_rel))
+        {
+          break;
+        }
+      }
+      // j is now the vertex owning slot s
+      if(same_cell(i,own,j))
+      {
+        break;
+      }
+      s = (s+1) & slot_mask;
+    }
+    S[i] = s;
+    next[i] = heads[s].exchange(i,std::memory_order_acq_rel);
+  },1000ul);
+  // Slot of cell of vertex i offset by o, -1 if that cell is empty
+  const auto find = [&](const int i, const int o)->std::int64_t
+  {
+    std::size_t s = hash(i,o) & slot_mask;
+    while(true)
+    {
+      const int j = slots[s].load(std::memory_order_relaxed);
+      if(j < 0)
+      {
+        return -1;
+      }
+      if(same_cell(i,o,j))
+      {
+        return std::int64_t(s);
+      }
+      s = (s+1) & slot_mask;
+    }
+  };
+
+  // Label each vertex with the lowest index of its group. First pass: lowest
+  // index of close vertices in the same cell. A vertex is a hub if it and
+  // the rest of its cell are not near the cell's faces and it is close to
+  // all of the rest, then the group is exactly the cell and the label is
+  // final. This is the common case: all vertices in a cell are copies of
+  // one vertex.
+  std::vector<int> L(n);
+  std::vector<char> hub(n);
+  parallel_for(n,[&](const int i)
+  {
+    int l = i;
+    bool is_hub = !near[i];
+    for(int j = heads[S[i]].load(std::memory_order_relaxed);j>=0;j = next[j])
+    {
+      if(close(i,j))
+      {
+        l = std::min(l,j);
+      }else
+      {
+        is_hub = false;
+      }
+      is_hub = is_hub && !near[j];
+    }
+    L[i] = l;
+    hub[i] = is_hub;
+  },1000ul);
+  // Vertices in a cell with a hub take its label, the rest are active
+  std::vector<char> active(n);
+  parallel_for(n,[&](const int i)
+  {
+    active[i] = !hub[i];
+    if(hub[i])
+    {
+      return;
+    }
+    for(int j = heads[S[i]].load(std::memory_order_relaxed);j>=0;j = next[j])
+    {
+      if(hub[j])
+      {
+        L[i] = L[j];
+        active[i] = false;
+        break;
+      }
+    }
+  },1000ul);
+  std::vector<int> A;
+  for(int i = 0;i<n;i++)
+  {
+    if(active[i])
+    {
+      A.push_back(i);
+    }
+  }
+  // Active vertices: propagate minimum labels (with pointer jumping) between
+  // close vertices in the same and neighboring cells until nothing changes
+  std::vector<int> L_new;
+  if(!A.empty())
+  {
+    L_new = L;
+  }
+  std::atomic<bool> changed(!A.empty());
+  while(changed.load())
+  {
+    changed.store(false);
+    parallel_for(A.size(),[&](const std::size_t a)
+    {
+      const int i = A[a];
+      int l = L[i];
+      const auto visit = [&](const std::size_t s)
+      {
+        for(int j = heads[s].load(std::memory_order_relaxed);j>=0;j = next[j])
+        {
+          if(L[L[j]] < l && close(i,j))
+          {
+            l = L[L[j]];
+          }
+        }
+      };
+      visit(S[i]);
+      if(near[i])
+      {
+        for(int o = 0;o<num_offsets;o++)
+        {
+          if(o != own && (O_near[o] & near[i]) == O_near[o])
+          {
+            const std::int64_t s = find(i,o);
+            if(s >= 0)
+            {
+              visit(s);
+            }
+          }
+        }
+      }
+      L_new[i] = l;
+      if(l != L[i])
+      {
+        changed.store(true,std::memory_order_relaxed);
+      }
+    },1000ul);
+    L.swap(L_new);
+  }
+
+  // Groups are numbered in order of their lowest index
+  std::vector<int> J(n);
+  int num_groups = 0;
+  for(int i = 0;i<n;i++)
+  {
+    J[i] = L[i] == i ? num_groups++ : -1;
+  }
+  SVI.resize(num_groups,1);
+  SVJ.resize(n,1);
+  parallel_for(n,[&](const int i)
+  {
+    if(L[i] == i)
+    {
+      SVI(J[i]) = i;
+    }
+    SVJ(i) = J[L[i]];
+  },1000ul);
+  SV.resize(num_groups,dim);
+  parallel_for(num_groups,[&](const int k)
+  {
+    SV.row(k) = V.row(SVI(k));
+  },1000ul);
+}
+
+template <
+  typename DerivedV,
+  typename DerivedSV,
+  typename DerivedSVI,
+  typename DerivedSVJ,
+  typename DerivedF>
+IGL_INLINE void igl::weld_vertices(
+  const Eigen::MatrixBase<DerivedV> & V,
+  const double epsilon,
+  Eigen::PlainObjectBase<DerivedSV> & SV,
+  Eigen::PlainObjectBase<DerivedSVI> & SVI,
+  Eigen::PlainObjectBase<DerivedSVJ> & SVJ,
+  Eigen::PlainObjectBase<DerivedF> & F)
+{
+  weld_vertices(V,epsilon,SV,SVI,SVJ);
+  parallel_for(F.rows(),[&](const int f)
+  {
+    for(int c = 0;c<F.cols();c++)
+    {
+      F(f,c) = SVJ(F(f,c));
+    }
+  },1000ul);
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template void igl::weld_vertices<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, double, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
+template void igl::weld_vertices<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, double, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
+template void igl::weld_vertices<Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 3, 0, -1, 3> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> > const&, double, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 3, 0, -1, 3> >&);
+template void igl::weld_vertices<Eigen::Matrix<float, -1, 3, 1, -1, 3>, Eigen::Matrix<float, -1, 3, 1, -1, 3>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 3, 1, -1, 3> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, 3, 1, -1, 3> > const&, double, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, 3, 1, -1, 3> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 3, 1, -1, 3> >&);
+#endif
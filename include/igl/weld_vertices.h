@@ -0,0 +1,74 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2023 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_WELD_VERTICES_H
+#define IGL_WELD_VERTICES_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+namespace igl
+{
+  // Merge vertices that are within epsilon of each other, in parallel and
+  // without sorting V. Vertices are hashed into a grid of cells of size
+  // epsilon and only compared against vertices in the same and neighboring
+  // cells, so, unlike remove_duplicate_vertices (which rounds coordinates to
+  // multiples of epsilon), two nearby vertices on either side of a cell
+  // boundary are merged. Merging is transitive: each group of vertices
+  // connected by chains of close pairs becomes a single vertex.
+  //
+  // Inputs:
+  //   V  #V by dim list of vertex positions
+  //   epsilon  uniqueness tolerance used coordinate-wise: vertices i and j are
+  //     close if |V(i,d)-V(j,d)| <= epsilon for all d, 0 --> exact match.
+  // Outputs:
+  //   SV  #SV by dim new list of vertex positions
+  //   SVI  #SV by 1 list of indices so SV = V(SVI,:), the lowest index of each
+  //     group in increasing order (so vertices keep their relative order)
+  //   SVJ  #V by 1 list of indices so V ≈ SV(SVJ,:)
+  //
+  // Example:
+  //   // Triangle soup (V,F) read from an STL
+  //   igl::weld_vertices(V,1e-7,SV,SVI,SVJ,F);
+  //   // F now indexes SV
+  //
+  // See also: remove_duplicate_vertices
+  template <
+    typename DerivedV,
+    typename DerivedSV,
+    typename DerivedSVI,
+    typename DerivedSVJ>
+  IGL_INLINE void weld_vertices(
+    const Eigen::MatrixBase<DerivedV> & V,
+    const double epsilon,
+    Eigen::PlainObjectBase<DerivedSV> & SV,
+    Eigen::PlainObjectBase<DerivedSVI> & SVI,
+    Eigen::PlainObjectBase<DerivedSVJ> & SVJ);
+  // Wrapper that also remaps faces in place
+  //
+  // Inputs:
+  //   F  #F by ss list of simplex indices into V
+  // Outputs:
+  //   F  #F by ss list of simplex indices into SV, F = SVJ(F)
+  template <
+    typename DerivedV,
+    typename DerivedSV,
+    typename DerivedSVI,
+    typename DerivedSVJ,
+    typename DerivedF>
+  IGL_INLINE void weld_vertices(
+    const Eigen::MatrixBase<DerivedV> & V,
+    const double epsilon,
+    Eigen::PlainObjectBase<DerivedSV> & SV,
+    Eigen::PlainObjectBase<DerivedSVI> & SVI,
+    Eigen::PlainObjectBase<DerivedSVJ> & SVJ,
+    Eigen::PlainObjectBase<DerivedF> & F);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "weld_vertices.cpp"
+#endif
+
+#endif
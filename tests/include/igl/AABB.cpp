@@ -0,0 +1,126 @@
+#include <test_common.h>
+#include <igl/AABB.h>
+#include <igl/Hit.h>
+#include <igl/ray_mesh_intersect.h>
+#include <igl/random_dir.h>
+#include <limits>
+
+TEST_CASE("AABB: intersect_ray any hit with max_t", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::bumpy_grid(20,20,0.2,12,9,V,F);
+  igl::AABB<Eigen::MatrixXd,3> aabb;
+  aabb.init(V,F);
+
+  srand(0);
+  const Eigen::MatrixXd D = igl::random_dir_stratified(200);
+  const Eigen::RowVector3d origin(0.5,0.5,0.05);
+  for(const double max_t : {0.05,0.2,std::numeric_limits<double>::infinity()})
+  {
+    for(int r = 0;r<D.rows();r++)
+    {
+      const Eigen::RowVector3d dir = D.row(r);
+      // Brute force
+      std::vector<igl::Hit> all_hits;
+      igl::ray_mesh_intersect(origin,dir,V,F,all_hits);
+      const bool expected = all_hits.size() > 0 && all_hits[0].t < max_t;
+      igl::Hit any,first;
+      const bool any_ret = aabb.intersect_ray(V,F,origin,dir,max_t,true,any);
+      const bool first_ret = aabb.intersect_ray(V,F,origin,dir,max_t,false,first);
+      REQUIRE(any_ret == expected);
+      REQUIRE(first_ret == expected);
+      if(expected)
+      {
+        REQUIRE(any.t < max_t);
+        REQUIRE(any.t >= first.t);
+        REQUIRE(first.id == all_hits[0].id);
+        REQUIRE(first.t == Approx(all_hits[0].t).margin(1e-6));
+      }
+    }
+  }
+}
+
+TEST_CASE("AABB: intersect_rays packet matches intersect_ray", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::bumpy_grid(20,20,0.2,12,9,V,F);
+  igl::AABB<Eigen::MatrixXd,3> aabb;
+  aabb.init(V,F);
+
+  srand(0);
+  // Some rays parallel to slab planes (zero direction components)
+  Eigen::MatrixXd D = igl::random_dir_stratified(200);
+  D.row(0) << 1,0,0;
+  D.row(1) << 0,-1,0;
+  D.row(2) << 0,0,-1;
+  D.row(3) << 0.5,0,-0.5;
+  const Eigen::RowVector3d origin(0.5,0.5,0.05);
+  for(const double max_t : {0.05,0.2,std::numeric_limits<double>::infinity()})
+  {
+    for(const bool any_hit : {false,true})
+    {
+      std::vector<igl::Hit> hits;
+      const int num_hits =
+        aabb.intersect_rays(V,F,origin,D,0.0,max_t,any_hit,hits);
+      REQUIRE(hits.size() == D.rows());
+      int expected_num_hits = 0;
+      for(int r = 0;r<D.rows();r++)
+      {
+        const Eigen::RowVector3d dir = D.row(r);
+        igl::Hit hit;
+        const bool expected =
+          aabb.intersect_ray(V,F,origin,dir,max_t,any_hit,hit);
+        expected_num_hits += expected;
+        REQUIRE((hits[r].id >= 0) == expected);
+        if(expected)
+        {
+          REQUIRE(hits[r].t < max_t);
+          if(!any_hit)
+          {
+            REQUIRE(hits[r].id == hit.id);
+            REQUIRE(hits[r].t == Approx(hit.t).margin(1e-12));
+          }
+        }
+      }
+      REQUIRE(num_hits == expected_num_hits);
+    }
+  }
+}
+
+TEST_CASE("AABB: float matches double", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::bumpy_grid(20,20,0.2,12,9,V,F);
+  const Eigen::MatrixXf Vf = V.cast<float>();
+  igl::AABB<Eigen::MatrixXd,3> aabb;
+  aabb.init(V,F);
+  igl::AABB<Eigen::MatrixXf,3> aabbf;
+  aabbf.init(Vf,F);
+
+  srand(0);
+  const Eigen::MatrixXd P = Eigen::MatrixXd::Random(100,3);
+  const Eigen::MatrixXf Pf = P.cast<float>();
+  Eigen::VectorXd sqrD;
+  Eigen::VectorXi I;
+  Eigen::MatrixXd C;
+  aabb.squared_distance(V,F,P,sqrD,I,C);
+  Eigen::VectorXf sqrDf;
+  Eigen::VectorXi If;
+  Eigen::MatrixXf Cf;
+  aabbf.squared_distance(Vf,F,Pf,sqrDf,If,Cf);
+  test_common::assert_near(sqrDf.cast<double>().eval(),sqrD,1e-5);
+  test_common::assert_near(Cf.cast<double>().eval(),C,1e-5);
+
+  const Eigen::RowVector3d origin(0.5,0.5,1);
+  const Eigen::RowVector3d dir(0.1,-0.2,-1);
+  igl::Hit hit,hitf;
+  REQUIRE(aabb.intersect_ray(V,F,origin,dir,hit));
+  REQUIRE(aabbf.intersect_ray(
+    Vf,F,Eigen::RowVector3f(origin.cast<float>()),
+    Eigen::RowVector3f(dir.cast<float>()),hitf));
+  REQUIRE(hitf.id == hit.id);
+  REQUIRE(hitf.t == Approx(hit.t).margin(1e-5));
+}
@@ -0,0 +1,93 @@
+#include <test_common.h>
+#include <igl/HalfEdgeMesh.h>
+#include <igl/triangle_triangle_adjacency.h>
+#include <igl/edge_flaps.h>
+#include <igl/vertex_triangle_adjacency.h>
+#include <igl/adjacency_list.h>
+#include <igl/triangulated_grid.h>
+#include <algorithm>
+#include <cstdint>
+
+TEST_CASE("HalfEdgeMesh: adapters and circulation", "[igl]")
+{
+  Eigen::MatrixXd GV;
+  Eigen::MatrixXi grid;
+  igl::triangulated_grid(7,5,GV,grid);
+  // Octahedron (closed)
+  Eigen::MatrixXi oct(8,3);
+  oct<<
+    0,2,4, 2,1,4, 1,3,4, 3,0,4,
+    2,0,5, 1,2,5, 3,1,5, 0,3,5;
+  for(const Eigen::MatrixXi & F : {grid,oct})
+  {
+    const igl::HalfEdgeMesh<int> H(F);
+    REQUIRE(H.num_halfedges() == 3*F.rows());
+    Eigen::MatrixXi TT,TTi,HTT,HTTi;
+    igl::triangle_triangle_adjacency(F,TT,TTi);
+    igl::triangle_triangle_adjacency(H,HTT,HTTi);
+    test_common::assert_eq(TT,HTT);
+    test_common::assert_eq(TTi,HTTi);
+
+    Eigen::MatrixXi uE,EF,EI,HuE,HEF,HEI;
+    Eigen::VectorXi EMAP,HEMAP;
+    igl::edge_flaps(F,uE,EMAP,EF,EI);
+    igl::edge_flaps(H,HuE,HEMAP,HEF,HEI);
+    test_common::assert_eq(uE,HuE);
+    test_common::assert_eq(EMAP,HEMAP);
+    test_common::assert_eq(EF,HEF);
+    test_common::assert_eq(EI,HEI);
+
+    Eigen::VectorXi VF,NI,HVF,HNI;
+    igl::vertex_triangle_adjacency(F,F.maxCoeff()+1,VF,NI);
+    igl::vertex_triangle_adjacency(H,HVF,HNI);
+    test_common::assert_eq(VF,HVF);
+    test_common::assert_eq(NI,HNI);
+
+    // One-rings are the vertex neighbors, listed in order
+    std::vector<std::vector<int> > A;
+    igl::adjacency_list(F,A);
+    for(int v = 0;v<H.num_vertices();v++)
+    {
+      int prev_face = -1;
+      H.circulate(v,[&](const int h)
+      {
+        REQUIRE(H.origin(h) == v);
+        if(prev_face >= 0)
+        {
+          // Consecutive faces share an edge
+          REQUIRE(H.twin(H.prev(h)) >= 0);
+          REQUIRE(H.face(H.twin(H.prev(h))) == prev_face);
+        }
+        prev_face = H.face(h);
+      });
+      std::vector<int> N;
+      H.circulate_vertices(v,[&](const int u){ N.push_back(u); });
+      // Consecutive neighbors are connected
+      for(size_t i = 1;i<N.size();i++)
+      {
+        REQUIRE(std::count(A[N[i]].begin(),A[N[i]].end(),N[i-1]) == 1);
+      }
+      std::sort(N.begin(),N.end());
+      std::vector<int> Av = A[v];
+      std::sort(Av.begin(),Av.end());
+      REQUIRE(N == Av);
+    }
+  }
+}
+
+TEST_CASE("HalfEdgeMesh: 64-bit indices", "[igl]")
+{
+  Eigen::MatrixXd GV;
+  Eigen::MatrixXi F;
+  igl::triangulated_grid(6,4,GV,F);
+  const igl::HalfEdgeMesh<int> H(F);
+  const Eigen::Matrix<std::int64_t,Eigen::Dynamic,Eigen::Dynamic> F64 =
+    F.cast<std::int64_t>();
+  const igl::HalfEdgeMesh<std::int64_t> H64(F64);
+  test_common::assert_eq(H64.twins,H.twins.cast<std::int64_t>().eval());
+  test_common::assert_eq(H64.edges,H.edges.cast<std::int64_t>().eval());
+  test_common::assert_eq(
+    H64.edge_halfedges,H.edge_halfedges.cast<std::int64_t>().eval());
+  test_common::assert_eq(
+    H64.vertex_halfedges,H.vertex_halfedges.cast<std::int64_t>().eval());
+}
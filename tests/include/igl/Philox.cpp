@@ -0,0 +1,69 @@
+#include <test_common.h>
+#include <igl/Philox.h>
+#include <igl/random_points_on_mesh.h>
+#include <igl/random_dir.h>
+#include <igl/randperm.h>
+
+TEST_CASE("Philox: known answers", "[igl]")
+{
+  // Philox4x32-10 test vectors from Random123
+  const auto zero = igl::Philox::block(0,0,0);
+  REQUIRE(zero[0] == 0x6627e8d5u);
+  REQUIRE(zero[1] == 0xe169c58du);
+  REQUIRE(zero[2] == 0xbc57ac4cu);
+  REQUIRE(zero[3] == 0x9b00dbd8u);
+  const auto pi = igl::Philox::block(
+    0x299f31d0a4093822ull,0x0370734413198a2eull,0x85a308d3243f6a88ull);
+  REQUIRE(pi[0] == 0xd16cfe09u);
+  REQUIRE(pi[1] == 0x94fdccebu);
+  REQUIRE(pi[2] == 0x5001e420u);
+  REQUIRE(pi[3] == 0x24126ea1u);
+  // Streamed outputs are the blocks in order
+  igl::Philox rng(0,0);
+  for(int i = 0;i<4;i++) { REQUIRE(rng() == zero[i]); }
+  REQUIRE(rng() == igl::Philox::block(0,0,1)[0]);
+  // Uniform numbers
+  double mean = 0;
+  const int n = 10000;
+  for(int i = 0;i<n;i++)
+  {
+    const double u = rng.uniform();
+    REQUIRE(u >= 0);
+    REQUIRE(u < 1);
+    mean += u/n;
+  }
+  REQUIRE(mean == Approx(0.5).margin(0.02));
+}
+
+TEST_CASE("Philox: seeded sampling is reproducible", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::bumpy_grid(20,20,0.2,12,9,V,F);
+  Eigen::MatrixXd B1,B2,B3;
+  Eigen::VectorXi FI1,FI2,FI3;
+  igl::random_points_on_mesh(5000,V,F,B1,FI1,7);
+  igl::random_points_on_mesh(5000,V,F,B2,FI2,7);
+  igl::random_points_on_mesh(5000,V,F,B3,FI3,8);
+  test_common::assert_eq(B1,B2);
+  test_common::assert_eq(FI1,FI2);
+  REQUIRE((B1-B3).norm() > 0);
+  REQUIRE(FI1.minCoeff() >= 0);
+  REQUIRE(FI1.maxCoeff() < F.rows());
+  // Sample i only depends on (seed,i)
+  Eigen::MatrixXd B4;
+  Eigen::VectorXi FI4;
+  igl::random_points_on_mesh(10,V,F,B4,FI4,7);
+  test_common::assert_eq(B4,B1.topRows(10).eval());
+
+  test_common::assert_eq(
+    igl::random_dir_stratified(100,3),igl::random_dir_stratified(100,3));
+  const Eigen::MatrixXd D = igl::random_dir_stratified(100,3);
+  test_common::assert_near(
+    D.rowwise().norm().eval(),Eigen::VectorXd::Ones(100).eval(),1e-12);
+
+  Eigen::VectorXi I1,I2;
+  igl::randperm(100,I1,igl::Philox(11));
+  igl::randperm(100,I2,igl::Philox(11));
+  test_common::assert_eq(I1,I2);
+}
@@ -0,0 +1,56 @@
+#include <test_common.h>
+#include <igl/UnionFind.h>
+#include <igl/parallel_for.h>
+#include <igl/Philox.h>
+#include <vector>
+
+TEST_CASE("UnionFind: small", "[igl]")
+{
+  igl::UnionFind<int> U(6);
+  REQUIRE(U.size() == 6);
+  REQUIRE(U.unite(4,2));
+  REQUIRE(U.unite(5,4));
+  REQUIRE_FALSE(U.unite(2,5));
+  REQUIRE(U.unite(3,1));
+  // Roots are the smallest elements of their sets
+  REQUIRE(U.find(5) == 2);
+  REQUIRE(U.find(4) == 2);
+  REQUIRE(U.find(3) == 1);
+  REQUIRE(U.find(0) == 0);
+  Eigen::VectorXi C,K;
+  REQUIRE(U.components(C,K) == 3);
+  test_common::assert_eq(C,Eigen::VectorXi((Eigen::VectorXi(6)<<0,1,2,1,2,2).finished()));
+  test_common::assert_eq(K,Eigen::VectorXi((Eigen::VectorXi(3)<<1,2,3).finished()));
+}
+
+TEST_CASE("UnionFind: parallel unite matches breadth first search", "[igl]")
+{
+  const int n = 50000;
+  const int m = n*9/10;
+  igl::Philox rng(2);
+  Eigen::MatrixXi E(m,2);
+  std::vector<std::vector<int> > A(n);
+  for(int e = 0;e<m;e++)
+  {
+    const int i = rng()%n, j = rng()%n;
+    E.row(e) << i, j;
+    A[i].push_back(j);
+    A[j].push_back(i);
+  }
+  Eigen::VectorXi C_gt,K_gt;
+  test_common::bfs_components(A,C_gt,K_gt);
+  REQUIRE(K_gt.size() > 100);
+  igl::UnionFind<int> U(n);
+  igl::parallel_for(m,[&](const int e){ U.unite(E(e,0),E(e,1)); },1000);
+  Eigen::VectorXi C,K;
+  REQUIRE(U.components(C,K) == K_gt.size());
+  test_common::assert_same_partition(C,C_gt);
+  // Sets are numbered by their smallest elements, like the search above
+  test_common::assert_eq(C,C_gt);
+  test_common::assert_eq(K,K_gt);
+  for(int i = 0;i<n;i++)
+  {
+    REQUIRE(C_gt(U.find(i)) == C_gt(i));
+    REQUIRE(U.find(i) <= i);
+  }
+}
@@ -0,0 +1,131 @@
+#include <test_common.h>
+#include <igl/ambient_occlusion.h>
+#include <igl/shape_diameter_function.h>
+#include <igl/AABB.h>
+#include <igl/Hit.h>
+#include <igl/per_vertex_normals.h>
+#include <igl/random_dir.h>
+#include <limits>
+
+TEST_CASE("ambient_occlusion: packet matches per-ray", "[igl]")
+{
+  Eigen::MatrixXd V,N;
+  Eigen::MatrixXi F;
+  test_common::bumpy_grid(30,30,0.2,12,9,V,F);
+  igl::per_vertex_normals(V,F,N);
+  igl::AABB<Eigen::MatrixXd,3> aabb;
+  aabb.init(V,F);
+
+  // First hits of a packet match individual queries
+  const Eigen::MatrixXd D = igl::random_dir_stratified(64);
+  const Eigen::RowVector3d origin(0.5,0.5,1);
+  Eigen::MatrixXd dirs = D;
+  dirs.col(2) = -dirs.col(2).cwiseAbs();
+  std::vector<igl::Hit> hits;
+  const int num_hits = aabb.intersect_rays(
+    V,F,origin,dirs,0.,std::numeric_limits<double>::infinity(),false,hits);
+  REQUIRE(hits.size() == dirs.rows());
+  int expected_hits = 0;
+  for(int r = 0;r<dirs.rows();r++)
+  {
+    igl::Hit hit;
+    const Eigen::RowVector3d dir = dirs.row(r);
+    if(aabb.intersect_ray(V,F,origin,dir,hit))
+    {
+      expected_hits++;
+      REQUIRE(hits[r].id >= 0);
+      REQUIRE(hits[r].t == Approx(hit.t).margin(1e-6));
+    }else
+    {
+      REQUIRE(hits[r].id == -1);
+    }
+  }
+  REQUIRE(num_hits == expected_hits);
+
+  const int num_samples = 128;
+  Eigen::VectorXd S_packet,S_ray;
+  // Same sample directions for both
+  srand(0);
+  igl::ambient_occlusion(aabb,V,F,V,N,num_samples,S_packet);
+  const std::function<bool(const Eigen::Vector3f&,const Eigen::Vector3f&)> 
+    shoot_ray = [&](const Eigen::Vector3f& _s,const Eigen::Vector3f& dir)
+  {
+    const Eigen::Vector3f s = _s+1e-4*dir;
+    igl::Hit hit;
+    return aabb.intersect_ray(
+      V,F,s.cast<double>().eval(),dir.cast<double>().eval(),hit);
+  };
+  srand(0);
+  igl::ambient_occlusion(shoot_ray,V,N,num_samples,S_ray);
+  REQUIRE(S_packet.maxCoeff() > 0);
+  // Origin offset is handled slightly differently; allow a stray ray
+  test_common::assert_near(S_packet,S_ray,2.0/num_samples);
+}
+
+TEST_CASE("ambient_occlusion: max_distance", "[igl]")
+{
+  Eigen::MatrixXd V,N;
+  Eigen::MatrixXi F;
+  for(const int n : {5,30})
+  {
+    // Small grid takes the naive per-ray path
+    test_common::bumpy_grid(n,n,0.2,12,9,V,F);
+    igl::per_vertex_normals(V,F,N);
+    const int num_samples = 64;
+    Eigen::VectorXd S,S_inf,S_near,S_none;
+    srand(0);
+    igl::ambient_occlusion(V,F,V,N,num_samples,S);
+    srand(0);
+    igl::ambient_occlusion(
+      V,F,V,N,num_samples,std::numeric_limits<double>::infinity(),S_inf);
+    test_common::assert_eq(S,S_inf);
+    srand(0);
+    igl::ambient_occlusion(V,F,V,N,num_samples,0.05,S_near);
+    srand(0);
+    igl::ambient_occlusion(V,F,V,N,num_samples,1e-8,S_none);
+    // Closer cutoffs only ever drop occluders
+    REQUIRE((S_near.array() <= S.array()).all());
+    REQUIRE(S_none.maxCoeff() == 0);
+    if(n == 30)
+    {
+      REQUIRE(S_near.sum() < S.sum());
+    }
+  }
+}
+
+TEST_CASE("ambient_occlusion: benchmark", "[igl]" IGL_DEBUG_OFF)
+{
+  Eigen::MatrixXd V,N;
+  Eigen::MatrixXi F;
+  test_common::bumpy_grid(40,40,0.2,12,9,V,F);
+  igl::per_vertex_normals(V,F,N);
+  igl::AABB<Eigen::MatrixXd,3> aabb;
+  aabb.init(V,F);
+  const int num_samples = 64;
+
+  BENCHMARK("per-ray") {
+    const std::function<bool(const Eigen::Vector3f&,const Eigen::Vector3f&)> 
+      shoot_ray = [&](const Eigen::Vector3f& _s,const Eigen::Vector3f& dir)
+    {
+      const Eigen::Vector3f s = _s+1e-4*dir;
+      igl::Hit hit;
+      return aabb.intersect_ray(
+        V,F,s.cast<double>().eval(),dir.cast<double>().eval(),hit);
+    };
+    Eigen::VectorXd S;
+    igl::ambient_occlusion(shoot_ray,V,N,num_samples,S);
+    return S.sum();
+  };
+
+  BENCHMARK("packet") {
+    Eigen::VectorXd S;
+    igl::ambient_occlusion(aabb,V,F,V,N,num_samples,S);
+    return S.sum();
+  };
+
+  BENCHMARK("shape_diameter_function packet") {
+    Eigen::VectorXd S;
+    igl::shape_diameter_function(aabb,V,F,V,N,num_samples,S);
+    return S.sum();
+  };
+}
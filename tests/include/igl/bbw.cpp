@@ -4,6 +4,7 @@
 #include <igl/writeDMAT.h>
 #include <igl/readTGF.h>
 #include <igl/bbw.h>
+#include <igl/triangulated_grid.h>
 
 TEST_CASE("bbw: decimated_knight", "[igl]" "[slow]")
 {
@@ -24,3 +25,23 @@ TEST_CASE("bbw: decimated_knight", "[igl]" "[slow]")
   REQUIRE (1e-4 > (Was-W_groundtruth).array().abs().maxCoeff());
 }
 
+
+TEST_CASE("bbw: low_rank_matches_active_set", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::triangulated_grid(25,25,V,F);
+  // Three point handles
+  Eigen::VectorXi b(3);
+  b<<0,24*25+12,25*12+24;
+  Eigen::MatrixXd bc = Eigen::MatrixXd::Identity(3,3);
+  igl::BBWData data;
+  data.active_set_params.max_iter = 100;
+  Eigen::MatrixXd Wlr,Was;
+  REQUIRE(igl::bbw(V,F,b,bc,data,Wlr));
+  data.low_rank_max = 0;
+  REQUIRE(igl::bbw(V,F,b,bc,data,Was));
+  REQUIRE(Wlr.minCoeff() > -1e-8);
+  REQUIRE(Wlr.maxCoeff() < 1+1e-8);
+  test_common::assert_near(Wlr,Was,1e-6);
+}
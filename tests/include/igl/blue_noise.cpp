@@ -13,6 +13,23 @@
 #include <igl/octree.h>
 #include <igl/slice.h>
 
+namespace
+{
+  double min_distance(const Eigen::MatrixXd & P)
+  {
+    std::vector<std::vector<int> > point_indices;
+    Eigen::MatrixXi CH;
+    Eigen::MatrixXd CN;
+    Eigen::VectorXd W;
+    igl::octree(P,point_indices,CH,CN,W);
+    Eigen::MatrixXi I;
+    igl::knn(P,2,point_indices,CH,CN,W,I);
+    Eigen::MatrixXd P2;
+    igl::slice(P,I.col(1).eval(),1,P2);
+    return (P-P2).rowwise().norm().minCoeff();
+  }
+}
+
 TEST_CASE("blue_noise: decimated-knight", "[igl]")
 {
   Eigen::MatrixXd V;
@@ -26,15 +43,52 @@ TEST_CASE("blue_noise: decimated-knight", "[igl]")
   }
   // There should be ~4000 samples on this model
   REQUIRE(P.rows() > 3000);
-  std::vector<std::vector<int> > point_indices;
-  Eigen::MatrixXi CH;
-  Eigen::MatrixXd CN;
-  Eigen::VectorXd W;
-  igl::octree(P,point_indices,CH,CN,W);
-  Eigen::MatrixXi I;
-  igl::knn(P,2,point_indices,CH,CN,W,I);
-  Eigen::MatrixXd P2;
-  igl::slice(P,I.col(1).eval(),1,P2);
-  Eigen::VectorXd D = (P-P2).rowwise().norm();
-  REQUIRE(D.minCoeff() > r);
+  REQUIRE(min_distance(P) > r);
+}
+
+TEST_CASE("blue_noise: seeded", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::bumpy_grid(20,20,0.2,12,9,V,F);
+  const double r = 0.02;
+  Eigen::MatrixXd B1,P1,B2,P2,B3,P3;
+  Eigen::VectorXi I1,I2,I3;
+  igl::blue_noise(V,F,r,B1,I1,P1,std::uint64_t(3));
+  igl::blue_noise(V,F,r,B2,I2,P2,std::uint64_t(3));
+  igl::blue_noise(V,F,r,B3,I3,P3,std::uint64_t(4));
+  REQUIRE(P1.rows() > 1000);
+  test_common::assert_eq(P1,P2);
+  test_common::assert_eq(B1,B2);
+  test_common::assert_eq(I1,I2);
+  REQUIRE((P1.rows() != P3.rows() || P1 != P3));
+  REQUIRE(min_distance(P1) > r);
+  // Samples lie on their faces
+  for(int i = 0;i<P1.rows();i++)
+  {
+    const Eigen::RowVector3d Pi =
+      B1(i,0)*V.row(F(I1(i),0))+
+      B1(i,1)*V.row(F(I1(i),1))+
+      B1(i,2)*V.row(F(I1(i),2));
+    REQUIRE((Pi-P1.row(i)).norm() < 1e-12);
+  }
+}
+
+TEST_CASE("blue_noise: benchmark", "[igl]" IGL_DEBUG_OFF)
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::bumpy_grid(50,50,0.2,12,9,V,F);
+  BENCHMARK("r=0.01") {
+    Eigen::MatrixXd B,P;
+    Eigen::VectorXi I;
+    igl::blue_noise(V,F,0.01,B,I,P,std::uint64_t(0));
+    return P.rows();
+  };
+  BENCHMARK("r=0.02") {
+    Eigen::MatrixXd B,P;
+    Eigen::VectorXi I;
+    igl::blue_noise(V,F,0.02,B,I,P,std::uint64_t(0));
+    return P.rows();
+  };
 }
@@ -0,0 +1,57 @@
+#include <test_common.h>
+#include <igl/connected_components.h>
+#include <igl/vertex_components.h>
+#include <igl/Philox.h>
+#include <vector>
+
+TEST_CASE("connected_components: matches breadth first search", "[igl]")
+{
+  // Sparse random graph: many components of varied sizes
+  const int n = 20000;
+  igl::Philox rng(0);
+  std::vector<std::vector<int> > A(n);
+  std::vector<Eigen::Triplet<int> > IJV;
+  for(int e = 0;e<n*9/10;e++)
+  {
+    const int i = rng()%n, j = rng()%n;
+    A[i].push_back(j);
+    A[j].push_back(i);
+    IJV.emplace_back(i,j,1);
+    IJV.emplace_back(j,i,1);
+  }
+  Eigen::VectorXi C_gt,K_gt;
+  test_common::bfs_components(A,C_gt,K_gt);
+  REQUIRE(K_gt.size() > 100);
+  {
+    Eigen::SparseMatrix<int> S(n,n);
+    S.setFromTriplets(IJV.begin(),IJV.end());
+    Eigen::VectorXi C,K;
+    const int k = igl::connected_components(S,C,K);
+    REQUIRE(k == K_gt.size());
+    test_common::assert_eq(C,C_gt);
+    test_common::assert_eq(K,K_gt);
+    Eigen::VectorXi vC,vK;
+    igl::vertex_components(S,vC,vK);
+    test_common::assert_eq(vC,C_gt);
+    test_common::assert_eq(vK,K_gt);
+  }
+  {
+    // Compressed sparse rows, each edge listed only once
+    Eigen::VectorXi NI(n+1),N(IJV.size());
+    NI(0) = 0;
+    for(int i = 0;i<n;i++)
+    {
+      NI(i+1) = NI(i);
+      for(const auto j : A[i])
+      {
+        if(j >= i) N(NI(i+1)++) = j;
+      }
+    }
+    N.conservativeResize(NI(n));
+    Eigen::VectorXi C,K;
+    const int k = igl::connected_components(NI,N,C,K);
+    REQUIRE(k == K_gt.size());
+    test_common::assert_eq(C,C_gt);
+    test_common::assert_eq(K,K_gt);
+  }
+}
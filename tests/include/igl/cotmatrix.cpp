@@ -1,8 +1,11 @@
 #include <test_common.h>
 #include <igl/PI.h>
 #include <igl/cotmatrix.h>
+#include <igl/massmatrix.h>
+#include <igl/triangulated_grid.h>
 #include <igl/matrix_to_list.h>
 #include <igl/polygon_corners.h>
+#include <cstdint>
 
 TEST_CASE("cotmatrix: poly", "[igl]" )
 {
@@ -213,3 +216,32 @@ TEST_CASE("cotmatrix: tetrahedron", "[igl]")
     REQUIRE (L1.col(f).sum() == Approx (0.0).margin( epsilon));
   }
 }
+
+TEST_CASE("cotmatrix: float and int64 match double", "[igl]")
+{
+  Eigen::MatrixXd UV;
+  Eigen::MatrixXi F;
+  igl::triangulated_grid(15,12,UV,F);
+  Eigen::MatrixXd V(UV.rows(),3);
+  V << UV, 0.3*(5.0*UV.col(0)).array().cos()*UV.col(1).array();
+  Eigen::SparseMatrix<double> L,M;
+  igl::cotmatrix(V,F,L);
+  igl::massmatrix(V,F,igl::MASSMATRIX_TYPE_VORONOI,M);
+  // Single precision positions
+  const Eigen::MatrixXf Vf = V.cast<float>();
+  Eigen::SparseMatrix<float> Lf,Mf;
+  igl::cotmatrix(Vf,F,Lf);
+  igl::massmatrix(Vf,F,igl::MASSMATRIX_TYPE_VORONOI,Mf);
+  test_common::assert_near(
+    Eigen::MatrixXd(Lf.cast<double>()),Eigen::MatrixXd(L),1e-4);
+  test_common::assert_near(
+    Eigen::MatrixXd(Mf.cast<double>()),Eigen::MatrixXd(M),1e-6);
+  // 64-bit indices
+  const Eigen::Matrix<std::int64_t,Eigen::Dynamic,Eigen::Dynamic> Fl =
+    F.cast<std::int64_t>();
+  Eigen::SparseMatrix<double> Ll,Ml;
+  igl::cotmatrix(V,Fl,Ll);
+  igl::massmatrix(V,Fl,igl::MASSMATRIX_TYPE_VORONOI,Ml);
+  test_common::assert_eq(Eigen::MatrixXd(Ll),Eigen::MatrixXd(L));
+  test_common::assert_eq(Eigen::MatrixXd(Ml),Eigen::MatrixXd(M));
+}
@@ -1,6 +1,8 @@
 #include <test_common.h>
 #include <igl/dijkstra.h>
 #include <igl/adjacency_list.h>
+#include <igl/triangulated_grid.h>
+#include <igl/edges.h>
 #include <iostream>
 
 TEST_CASE("dijkstra: cube", "[igl]")
@@ -38,3 +40,114 @@ TEST_CASE("dijkstra: discrete distances", "[igl]")
   REQUIRE(min_distance[0] == 0);
 }
 
+
+TEST_CASE("dijkstra: csr matches adjacency list", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::triangulated_grid(7,5,V,F);
+  Eigen::MatrixXi E;
+  igl::edges(F,E);
+  std::vector<std::vector<int>> VV;
+  igl::adjacency_list(F, VV);
+  igl::DijkstraGraph<double> G;
+  igl::dijkstra_graph(V,E,G);
+  REQUIRE(G.C.size() == V.rows()+1);
+  REQUIRE(G.N.size() == 2*E.rows());
+
+  Eigen::VectorXd D,Dl;
+  Eigen::VectorXi P,Pl;
+  // run to completion: no targets, no bound
+  igl::dijkstra(V, VV, 0, std::set<int>(), Dl, Pl);
+  const double inf = std::numeric_limits<double>::infinity();
+  int out = igl::dijkstra(
+    G,(Eigen::VectorXi(1)<<0).finished(),Eigen::VectorXi(),inf,D,P);
+  REQUIRE(out == -1);
+  test_common::assert_near(D,Dl,1e-12);
+
+  // bounded by radius
+  const double r = 0.5;
+  igl::dijkstra(G,(Eigen::VectorXi(1)<<0).finished(),Eigen::VectorXi(),r,D,P);
+  for(int i = 0;i<V.rows();i++)
+  {
+    if(Dl(i) <= r)
+    {
+      REQUIRE(D(i) == Approx(Dl(i)).margin(1e-12));
+    }else
+    {
+      REQUIRE(D(i) == inf);
+    }
+  }
+
+  // multi-source with a target
+  const Eigen::VectorXi S = (Eigen::VectorXi(2)<<0,V.rows()-1).finished();
+  out = igl::dijkstra(
+    G,S,(Eigen::VectorXi(1)<<V.rows()-2).finished(),inf,D,P);
+  REQUIRE(out == V.rows()-2);
+  std::vector<int> path;
+  igl::dijkstra(out,P,path);
+  REQUIRE(path.back() == V.rows()-1);
+
+  // parallel batch matches individual queries
+  std::vector<Eigen::VectorXi> Q;
+  for(int q = 0;q<5;q++)
+  {
+    Q.push_back((Eigen::VectorXi(1)<<3*q).finished());
+  }
+  for(const double rq : {inf,r})
+  {
+    std::vector<Eigen::VectorXi> IQ;
+    std::vector<Eigen::VectorXd> DQ;
+    igl::dijkstra(G,Q,rq,IQ,DQ);
+    REQUIRE(IQ.size() == Q.size());
+    REQUIRE(DQ.size() == Q.size());
+    for(size_t q = 0;q<Q.size();q++)
+    {
+      igl::dijkstra(G,Q[q],Eigen::VectorXi(),rq,D,P);
+      REQUIRE(IQ[q].size() == (D.array() < inf).count());
+      for(int k = 0;k<IQ[q].size();k++)
+      {
+        REQUIRE(DQ[q](k) == D(IQ[q](k)));
+        if(k > 0)
+        {
+          REQUIRE(DQ[q](k-1) <= DQ[q](k));
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("dijkstra: reused data matches fresh queries", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::triangulated_grid(9,9,V,F);
+  Eigen::MatrixXi E;
+  igl::edges(F,E);
+  igl::DijkstraGraph<double> G;
+  igl::dijkstra_graph(V,E,G);
+  igl::DijkstraData<double> data;
+  // Alternate unbounded, bounded and early terminating queries so that each
+  // one starts from the leftovers of the previous
+  const double inf = std::numeric_limits<double>::infinity();
+  for(int q = 0;q<12;q++)
+  {
+    const Eigen::VectorXi S = (Eigen::VectorXi(1)<<(7*q)%V.rows()).finished();
+    const Eigen::VectorXi T = q%3==2 ?
+      (Eigen::VectorXi(1)<<(5*q+11)%V.rows()).finished() : Eigen::VectorXi();
+    const double r = q%3==1 ? 0.3 : inf;
+    Eigen::VectorXd D;
+    Eigen::VectorXi P;
+    const int out = igl::dijkstra(G,S,T,r,D,P);
+    REQUIRE(igl::dijkstra(G,S,T,r,data) == out);
+    test_common::assert_eq(data.previous,P);
+    for(int i = 0;i<V.rows();i++)
+    {
+      REQUIRE(data.min_distance(i) == D(i));
+    }
+    if(T.size() == 0)
+    {
+      REQUIRE(int(data.visited.size()) == (D.array() < inf).count());
+    }
+  }
+}
@@ -1,5 +1,7 @@
 #include <test_common.h>
 #include <igl/doublearea.h>
+#include <igl/triangulated_grid.h>
+#include <cstdint>
 
 TEST_CASE("doublearea: VF_vs_ABC", "[igl]" "[slow]")
 {
@@ -32,3 +34,25 @@ TEST_CASE("doublearea: VF_vs_ABC", "[igl]" "[slow]")
 
     test_common::run_test_cases(test_common::all_meshes(), test_case);
 }
+
+TEST_CASE("doublearea: float and int64 match double", "[igl]")
+{
+  Eigen::MatrixXd UV;
+  Eigen::MatrixXi F;
+  igl::triangulated_grid(20,20,UV,F);
+  Eigen::MatrixXd V(UV.rows(),3);
+  V << UV, (7.0*UV.col(0)).array().sin()*UV.col(1).array();
+  Eigen::VectorXd A;
+  igl::doublearea(V,F,A);
+  // Single precision positions
+  const Eigen::MatrixXf Vf = V.cast<float>();
+  Eigen::VectorXf Af;
+  igl::doublearea(Vf,F,Af);
+  test_common::assert_near(Af.cast<double>().eval(),A,1e-6);
+  // 64-bit indices
+  const Eigen::Matrix<std::int64_t,Eigen::Dynamic,Eigen::Dynamic> Fl =
+    F.cast<std::int64_t>();
+  Eigen::VectorXd Al;
+  igl::doublearea(V,Fl,Al);
+  test_common::assert_eq(Al,A);
+}
@@ -1,5 +1,7 @@
 #include <test_common.h>
 #include <igl/edge_flaps.h>
+#include <igl/triangulated_grid.h>
+#include <cstdint>
 
 TEST_CASE("edge_flaps: verify", "[igl]" "[slow]")
 {
@@ -39,3 +41,23 @@ TEST_CASE("edge_flaps: verify", "[igl]" "[slow]")
 
   test_common::run_test_cases(test_common::all_meshes(), test_case);
 }
+
+TEST_CASE("edge_flaps: int64", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::triangulated_grid(17,23,V,F);
+  Eigen::MatrixXi uE,EF,EI;
+  Eigen::VectorXi EMAP;
+  igl::edge_flaps(F,uE,EMAP,EF,EI);
+  typedef Eigen::Matrix<std::int64_t,Eigen::Dynamic,Eigen::Dynamic> MatrixXl;
+  typedef Eigen::Matrix<std::int64_t,Eigen::Dynamic,1> VectorXl;
+  const MatrixXl Fl = F.cast<std::int64_t>();
+  MatrixXl uEl,EFl,EIl;
+  VectorXl EMAPl;
+  igl::edge_flaps(Fl,uEl,EMAPl,EFl,EIl);
+  test_common::assert_eq(uEl,MatrixXl(uE.cast<std::int64_t>()));
+  test_common::assert_eq(EMAPl,VectorXl(EMAP.cast<std::int64_t>()));
+  test_common::assert_eq(EFl,MatrixXl(EF.cast<std::int64_t>()));
+  test_common::assert_eq(EIl,MatrixXl(EI.cast<std::int64_t>()));
+}
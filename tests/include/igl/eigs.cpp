@@ -0,0 +1,41 @@
+#include <test_common.h>
+#include <igl/eigs.h>
+#include <igl/cotmatrix.h>
+#include <igl/massmatrix.h>
+#include <igl/triangulated_grid.h>
+#include <Eigen/Eigenvalues>
+
+TEST_CASE("eigs: grid laplacian", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::triangulated_grid(20,20,V,F);
+  Eigen::SparseMatrix<double> L,M;
+  igl::cotmatrix(V,F,L);
+  igl::massmatrix(V,F,igl::MASSMATRIX_TYPE_DEFAULT,M);
+  const Eigen::SparseMatrix<double> A = -L;
+  const int k = 10;
+  Eigen::MatrixXd U;
+  Eigen::VectorXd S;
+  igl::EigsData data;
+  REQUIRE(igl::eigs(A,M,k,igl::EIGS_TYPE_SM,data,U,S));
+  REQUIRE(U.cols() == k);
+  REQUIRE(S.size() == k);
+  REQUIRE(data.residual.size() == k);
+  REQUIRE(data.converged.back() == k);
+  REQUIRE((data.residual.array() < data.tolerance).all());
+  // Dense reference
+  const Eigen::MatrixXd Ad = A, Md = M;
+  const Eigen::GeneralizedSelfAdjointEigenSolver<Eigen::MatrixXd> es(Ad,Md);
+  // descending order
+  for(int i = 0;i<k;i++)
+  {
+    REQUIRE(S(i) == Approx(es.eigenvalues()(k-1-i)).margin(1e-6));
+  }
+  // B-orthonormal
+  test_common::assert_near(
+    Eigen::MatrixXd(U.transpose()*M*U),Eigen::MatrixXd::Identity(k,k),1e-6);
+  // A u = s B u
+  const Eigen::MatrixXd R = A*U - M*U*S.asDiagonal();
+  REQUIRE(R.cwiseAbs().maxCoeff() < 1e-6);
+}
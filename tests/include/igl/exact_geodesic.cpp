@@ -0,0 +1,50 @@
+#include <test_common.h>
+#include <igl/exact_geodesic.h>
+#include <igl/triangulated_grid.h>
+#include <limits>
+
+TEST_CASE("exact_geodesic: planar grid is euclidean", "[igl]")
+{
+  // Geodesics on a convex planar domain are straight lines
+  Eigen::MatrixXd GV;
+  Eigen::MatrixXi F;
+  igl::triangulated_grid(9,9,GV,F);
+  Eigen::MatrixXd V = Eigen::MatrixXd::Zero(GV.rows(),3);
+  V.leftCols(2) = GV;
+  Eigen::VectorXi VS(1),FS,VT,FT;
+  VS<<40;
+  VT = Eigen::VectorXi::LinSpaced(V.rows(),0,V.rows()-1);
+  Eigen::VectorXd D;
+  igl::exact_geodesic(V,F,VS,FS,VT,FT,D);
+  const Eigen::VectorXd E = (V.rowwise()-V.row(VS(0))).rowwise().norm();
+  test_common::assert_near(D,E,1e-10);
+
+  igl::ExactGeodesicData data;
+  igl::exact_geodesic_precompute(V,F,data);
+  // Batch of independent single source queries
+  const Eigen::VectorXi S = Eigen::VectorXi::LinSpaced(V.rows(),0,V.rows()-1);
+  Eigen::MatrixXd DS;
+  igl::exact_geodesic_solve(
+    data,S,VT,FT,std::numeric_limits<double>::infinity(),DS);
+  REQUIRE(DS.rows() == V.rows());
+  REQUIRE(DS.cols() == S.size());
+  for(int s = 0;s<S.size();s++)
+  {
+    const Eigen::VectorXd Es = (V.rowwise()-V.row(S(s))).rowwise().norm();
+    test_common::assert_near(DS.col(s),Es,1e-10);
+  }
+  // Cutoff
+  const double max_distance = 0.3;
+  Eigen::VectorXd Dc;
+  igl::exact_geodesic_solve(data,VS,FS,VT,FT,max_distance,Dc);
+  for(int i = 0;i<V.rows();i++)
+  {
+    if(E(i) <= max_distance)
+    {
+      REQUIRE(Dc(i) == Approx(E(i)).margin(1e-10));
+    }else
+    {
+      REQUIRE(Dc(i) > max_distance);
+    }
+  }
+}
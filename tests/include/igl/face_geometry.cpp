@@ -0,0 +1,183 @@
+#include <test_common.h>
+#include <igl/face_geometry.h>
+#include <igl/doublearea.h>
+#include <igl/edge_lengths.h>
+#include <igl/internal_angles.h>
+#include <igl/per_face_normals.h>
+#include <igl/squared_edge_lengths.h>
+#include <igl/triangulated_grid.h>
+#include <cmath>
+
+namespace
+{
+  // Straightforward per-face reference, independent of face_geometry (which
+  // the library functions above are now routed through)
+  void reference_face_geometry(
+    const Eigen::MatrixXd & V,
+    const Eigen::MatrixXi & F,
+    Eigen::VectorXd & dblA,
+    Eigen::MatrixXd & L_sq,
+    Eigen::MatrixXd & K,
+    Eigen::MatrixXd & N)
+  {
+    const int m = F.rows();
+    dblA.resize(m);
+    L_sq.resize(m,3);
+    K.resize(m,3);
+    N.resize(m,3);
+    for(int f = 0;f<m;f++)
+    {
+      Eigen::Vector3d p[3];
+      for(int c = 0;c<3;c++)
+      {
+        p[c].setZero();
+        p[c].head(V.cols()) = V.row(F(f,c)).transpose();
+      }
+      const Eigen::Vector3d n = (p[1]-p[0]).cross(p[2]-p[0]);
+      dblA(f) = V.cols() == 2 ? n(2) : n.norm();
+      N.row(f) = n.norm() == 0 ? Eigen::RowVector3d::Zero() :
+        Eigen::RowVector3d(n.transpose()/n.norm());
+      for(int c = 0;c<3;c++)
+      {
+        const Eigen::Vector3d a = p[(c+1)%3]-p[c];
+        const Eigen::Vector3d b = p[(c+2)%3]-p[c];
+        L_sq(f,c) = (p[(c+1)%3]-p[(c+2)%3]).squaredNorm();
+        K(f,c) = std::atan2(a.cross(b).norm(),a.dot(b));
+      }
+    }
+  }
+}
+
+TEST_CASE("face_geometry: matches reference", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  // Not a multiple of the block size
+  test_common::bumpy_grid(23,17,0.3,7,5,V,F);
+  // Degenerate face gets a zero normal
+  F.conservativeResize(F.rows()+1,3);
+  F.row(F.rows()-1) << 0,0,1;
+  const int m = F.rows()-1;
+  Eigen::VectorXd dblA_gt;
+  Eigen::MatrixXd L_sq_gt,K_gt,N_gt;
+  reference_face_geometry(V,F,dblA_gt,L_sq_gt,K_gt,N_gt);
+  Eigen::VectorXd dblA;
+  Eigen::MatrixXd L_sq,L,K,N;
+  igl::face_geometry(V,F,igl::FACE_GEOMETRY_ALL,dblA,L_sq,L,K,N);
+  test_common::assert_near(dblA,dblA_gt,1e-15);
+  test_common::assert_near(L_sq,L_sq_gt,1e-15);
+  test_common::assert_near(L,L_sq_gt.array().sqrt().matrix().eval(),1e-15);
+  test_common::assert_near(N,N_gt,1e-15);
+  REQUIRE(N.row(m).norm() == 0);
+  test_common::assert_near(K.topRows(m),K_gt.topRows(m),1e-12);
+  // Angles of the degenerate face are nan
+  REQUIRE(K.row(m).hasNaN());
+  {
+    // Routed library functions agree with the reference too
+    Eigen::VectorXd dblA_r;
+    Eigen::MatrixXd L_sq_r,L_r,K_r,N_r;
+    igl::doublearea(V,F,dblA_r);
+    test_common::assert_near(dblA_r,dblA_gt,1e-15);
+    igl::squared_edge_lengths(V,F,L_sq_r);
+    test_common::assert_near(L_sq_r,L_sq_gt,1e-15);
+    igl::edge_lengths(V,F,L_r);
+    test_common::assert_near(L_r,L,1e-15);
+    igl::internal_angles(V,F,K_r);
+    test_common::assert_near(K_r.topRows(m),K_gt.topRows(m),1e-12);
+    igl::per_face_normals(V,F,N_r);
+    test_common::assert_near(N_r,N_gt,1e-15);
+    // Degenerate faces take the given default normal
+    const Eigen::RowVector3d Z(0,0,1);
+    igl::per_face_normals(V,F,Z,N_r);
+    test_common::assert_near(N_r.topRows(m),N_gt.topRows(m),1e-15);
+    test_common::assert_eq(N_r.row(m),Z);
+  }
+  // Only the requested outputs are touched
+  Eigen::VectorXd dblA_only;
+  Eigen::MatrixXd L_sq_none,L_none,K_none,N_none;
+  igl::face_geometry(
+    V,F,igl::FACE_GEOMETRY_DOUBLEAREA,
+    dblA_only,L_sq_none,L_none,K_none,N_none);
+  test_common::assert_eq(dblA_only,dblA);
+  REQUIRE(L_sq_none.size() == 0);
+  REQUIRE(L_none.size() == 0);
+  REQUIRE(K_none.size() == 0);
+  REQUIRE(N_none.size() == 0);
+}
+
+TEST_CASE("face_geometry: 2D signed area", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::triangulated_grid(9,11,V,F);
+  // Flip a face
+  F.row(0) = F.row(0).reverse().eval();
+  Eigen::VectorXd dblA,dblA_gt,dblA_r;
+  Eigen::MatrixXd L_sq,L,K,N,L_sq_gt,K_gt,N_gt,K_r;
+  reference_face_geometry(V,F,dblA_gt,L_sq_gt,K_gt,N_gt);
+  igl::face_geometry(
+    V,F,
+    igl::FACE_GEOMETRY_DOUBLEAREA |
+    igl::FACE_GEOMETRY_INTERNAL_ANGLES |
+    igl::FACE_GEOMETRY_NORMALS,
+    dblA,L_sq,L,K,N);
+  test_common::assert_near(dblA,dblA_gt,1e-15);
+  REQUIRE(dblA(0) < 0);
+  test_common::assert_near(K,K_gt,1e-12);
+  test_common::assert_eq(N,N_gt);
+  igl::doublearea(V,F,dblA_r);
+  test_common::assert_near(dblA_r,dblA_gt,1e-15);
+  igl::internal_angles(V,F,K_r);
+  test_common::assert_near(K_r,K_gt,1e-12);
+}
+
+TEST_CASE("face_geometry: float", "[igl]")
+{
+  Eigen::MatrixXd Vd;
+  Eigen::MatrixXi F;
+  test_common::bumpy_grid(10,10,0.3,7,5,Vd,F);
+  const Eigen::MatrixXf V = Vd.cast<float>();
+  Eigen::VectorXf dblA;
+  Eigen::MatrixXf L_sq,L,K,N;
+  igl::face_geometry(V,F,igl::FACE_GEOMETRY_ALL,dblA,L_sq,L,K,N);
+  Eigen::VectorXd dblA_gt;
+  Eigen::MatrixXd L_sq_gt,K_gt,N_gt;
+  reference_face_geometry(V.cast<double>(),F,dblA_gt,L_sq_gt,K_gt,N_gt);
+  test_common::assert_near(dblA.cast<double>().eval(),dblA_gt,1e-6);
+  test_common::assert_near(L_sq.cast<double>().eval(),L_sq_gt,1e-6);
+  test_common::assert_near(K.cast<double>().eval(),K_gt,1e-5);
+  test_common::assert_near(N.cast<double>().eval(),N_gt,1e-6);
+}
+
+TEST_CASE("face_geometry: higher dimension", "[igl]")
+{
+  // Bumpy grid rotated into 5D: same lengths, angles and areas as in 3D
+  Eigen::MatrixXd V3;
+  Eigen::MatrixXi F;
+  test_common::bumpy_grid(9,11,0.3,7,5,V3,F);
+  Eigen::MatrixXd Q = Eigen::MatrixXd::Identity(5,5);
+  Q.block(2,2,2,2) <<
+    std::cos(0.3), -std::sin(0.3),
+    std::sin(0.3), std::cos(0.3);
+  Eigen::MatrixXd V5 = Eigen::MatrixXd::Zero(V3.rows(),5);
+  V5.leftCols(3) = V3;
+  V5 = (V5*Q.transpose()).eval();
+  Eigen::VectorXd dblA3,dblA5;
+  Eigen::MatrixXd L_sq3,L3,K3,N3,L_sq5,L5,K5,N5;
+  const int types =
+    igl::FACE_GEOMETRY_DOUBLEAREA |
+    igl::FACE_GEOMETRY_SQUARED_EDGE_LENGTHS |
+    igl::FACE_GEOMETRY_EDGE_LENGTHS |
+    igl::FACE_GEOMETRY_INTERNAL_ANGLES;
+  igl::face_geometry(V3,F,types,dblA3,L_sq3,L3,K3,N3);
+  igl::face_geometry(V5,F,types,dblA5,L_sq5,L5,K5,N5);
+  test_common::assert_near(dblA5,dblA3,1e-12);
+  test_common::assert_near(L_sq5,L_sq3,1e-12);
+  test_common::assert_near(L5,L3,1e-12);
+  test_common::assert_near(K5,K3,1e-6);
+  REQUIRE(N5.size() == 0);
+  // Routed library function agrees
+  Eigen::VectorXd dblA_r;
+  igl::doublearea(V5,F,dblA_r);
+  test_common::assert_near(dblA_r,dblA5,1e-15);
+}
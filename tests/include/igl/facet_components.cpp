@@ -1,5 +1,10 @@
 #include <test_common.h>
 #include <igl/facet_components.h>
+#include <igl/triangle_triangle_adjacency.h>
+#include <igl/Philox.h>
+#include <algorithm>
+#include <map>
+#include <vector>
 
 TEST_CASE("facet_components: two_triangles", "[igl]")
 {
@@ -34,3 +39,52 @@ TEST_CASE("facet_components: truck", "[igl]")
   igl::facet_components(F,C);
   REQUIRE(C.maxCoeff()+1 == 59);
 }
+
+TEST_CASE("facet_components: soup matches breadth first search", "[igl]")
+{
+  // Random triangles on few vertices: many shared and non-manifold edges
+  const int n = 300;
+  Eigen::MatrixXi F(6000,3);
+  igl::Philox rng(1);
+  for(int f = 0;f<F.rows();f++)
+  {
+    for(int c = 0;c<3;c++)
+    {
+      F(f,c) = rng()%n;
+    }
+  }
+  // Faces sharing an undirected edge are adjacent
+  std::map<std::pair<int,int>,std::vector<int> > edge_faces;
+  for(int f = 0;f<F.rows();f++)
+  {
+    for(int c = 0;c<3;c++)
+    {
+      const int i = F(f,(c+1)%3), j = F(f,(c+2)%3);
+      edge_faces[std::make_pair(std::min(i,j),std::max(i,j))].push_back(f);
+    }
+  }
+  std::vector<std::vector<int> > A(F.rows());
+  for(const auto & e : edge_faces)
+  {
+    for(const int f : e.second)
+    {
+      A[f].insert(A[f].end(),e.second.begin(),e.second.end());
+    }
+  }
+  Eigen::VectorXi C_gt,K_gt;
+  test_common::bfs_components(A,C_gt,K_gt);
+  // Many components, some of them large
+  REQUIRE(K_gt.size() > 100);
+  REQUIRE(K_gt.maxCoeff() > 10);
+  Eigen::VectorXi C;
+  REQUIRE(igl::facet_components(F,C) == K_gt.size());
+  test_common::assert_same_partition(C,C_gt);
+  {
+    std::vector<std::vector<std::vector<int> > > TT;
+    igl::triangle_triangle_adjacency(F,TT);
+    Eigen::VectorXi C_TT,K_TT;
+    igl::facet_components(TT,C_TT,K_TT);
+    test_common::assert_same_partition(C_TT,C_gt);
+    REQUIRE(K_TT.size() == K_gt.size());
+  }
+}
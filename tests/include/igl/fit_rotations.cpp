@@ -0,0 +1,90 @@
+#include <test_common.h>
+#include <igl/fit_rotations.h>
+#include <igl/Philox.h>
+#include <Eigen/Geometry>
+#include <limits>
+#include <vector>
+
+namespace
+{
+  // Stack of nr covariance matrices S_r = Q_r P_r with random rotations Q_r
+  // and well conditioned symmetric positive definite P_r, so that the best
+  // fit rotation of S_r is exactly Q_r
+  void random_covariances(
+    const int nr,
+    Eigen::MatrixXd & S,
+    std::vector<Eigen::Matrix3d> & Q)
+  {
+    igl::Philox rng(0);
+    const auto rand = [&rng]()
+    {
+      return double(rng())/double(std::numeric_limits<std::uint32_t>::max())-0.5;
+    };
+    S.resize(3*nr,3);
+    Q.resize(nr);
+    for(int r = 0;r<nr;r++)
+    {
+      Q[r] = Eigen::Quaterniond(rand(),rand(),rand(),rand()).normalized()
+        .toRotationMatrix();
+      Eigen::Matrix3d A;
+      for(int i = 0;i<3;i++)
+      {
+        for(int j = 0;j<3;j++)
+        {
+          A(i,j) = rand();
+        }
+      }
+      const Eigen::Matrix3d si =
+        Q[r]*(Eigen::Matrix3d::Identity() + A*A.transpose());
+      for(int i = 0;i<3;i++)
+      {
+        for(int j = 0;j<3;j++)
+        {
+          S(i*nr+r,j) = si(i,j);
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("fit_rotations: single precision matches polar_svd", "[igl]")
+{
+  // Not a multiple of the SSE/AVX batch width
+  const int nr = 13;
+  Eigen::MatrixXd S;
+  std::vector<Eigen::Matrix3d> Q;
+  random_covariances(nr,S,Q);
+  Eigen::MatrixXd R,Rs;
+  igl::fit_rotations(S,false,R);
+  REQUIRE(R.rows() == 3);
+  REQUIRE(R.cols() == 3*nr);
+  for(int r = 0;r<nr;r++)
+  {
+    // Rotations are stored transposed
+    test_common::assert_near(
+      R.block(0,3*r,3,3).eval(),Eigen::Matrix3d(Q[r].transpose()),1e-12);
+  }
+  igl::fit_rotations(S,true,Rs);
+  test_common::assert_near(Rs,R,1e-4);
+  for(int r = 0;r<nr;r++)
+  {
+    REQUIRE(Rs.block(0,3*r,3,3).determinant() > 0);
+  }
+#ifdef __SSE__
+  {
+    Eigen::MatrixXf R_sse;
+    igl::fit_rotations_SSE(Eigen::MatrixXf(S.cast<float>()),R_sse);
+    test_common::assert_near(Eigen::MatrixXd(R_sse.cast<double>()),R,1e-4);
+    Eigen::MatrixXd Rd_sse;
+    igl::fit_rotations_SSE(S,Rd_sse);
+    test_common::assert_near(Rd_sse,R,1e-4);
+  }
+#endif
+#ifdef __AVX__
+  {
+    Eigen::MatrixXf R_avx;
+    igl::fit_rotations_AVX(Eigen::MatrixXf(S.cast<float>()),R_avx);
+    test_common::assert_near(Eigen::MatrixXd(R_avx.cast<double>()),R,1e-4);
+  }
+#endif
+}
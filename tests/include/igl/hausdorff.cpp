@@ -0,0 +1,96 @@
+#include <test_common.h>
+#include <igl/hausdorff.h>
+#include <igl/decimate.h>
+#include <igl/point_mesh_squared_distance.h>
+#include <igl/random_points_on_mesh.h>
+
+namespace
+{
+  // Max distance from dense samples of A to B
+  double sampled_distance(
+    const Eigen::MatrixXd & VA,
+    const Eigen::MatrixXi & FA,
+    const Eigen::MatrixXd & VB,
+    const Eigen::MatrixXi & FB)
+  {
+    Eigen::MatrixXd B,X;
+    Eigen::VectorXi FI;
+    igl::random_points_on_mesh(20000,VA,FA,B,FI,X,std::uint64_t(0));
+    Eigen::VectorXd sqrD;
+    Eigen::VectorXi I;
+    Eigen::MatrixXd C;
+    igl::point_mesh_squared_distance(X,VB,FB,sqrD,I,C);
+    return std::sqrt(sqrD.maxCoeff());
+  }
+}
+
+TEST_CASE("hausdorff: non-planar quad", "[igl]")
+{
+  // Two triangulations of the same non-planar quad share all vertices, so
+  // the vertex-based bound is zero
+  const Eigen::MatrixXd V = (Eigen::MatrixXd(4,3)<<
+    0,0,0,
+    1,0,0,
+    1,1,0.5,
+    0,1,0).finished();
+  const Eigen::MatrixXi FA = (Eigen::MatrixXi(2,3)<<0,1,2,0,2,3).finished();
+  const Eigen::MatrixXi FB = (Eigen::MatrixXi(2,3)<<0,1,3,1,2,3).finished();
+  double d;
+  igl::hausdorff(V,FA,V,FB,d);
+  REQUIRE(d == 0);
+  const double tol = 1e-4;
+  double l,u;
+  REQUIRE(igl::hausdorff(V,FA,V,FB,tol,l,u));
+  REQUIRE(l > 0.1);
+  REQUIRE(u-l <= tol);
+  const double s = std::max(
+    sampled_distance(V,FA,V,FB),sampled_distance(V,FB,V,FA));
+  REQUIRE(s <= u);
+  REQUIRE(s >= l-1e-2);
+}
+
+TEST_CASE("hausdorff: decimated", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::bumpy_grid(30,30,0.1,6,4,V,F);
+  Eigen::MatrixXd U;
+  Eigen::MatrixXi G;
+  Eigen::VectorXi J;
+  igl::decimate(V,F,F.rows()/8,U,G,J);
+  double d;
+  igl::hausdorff(V,F,U,G,d);
+  for(const double tol : {1e-2,1e-4})
+  {
+    double l,u;
+    REQUIRE(igl::hausdorff(V,F,U,G,tol,l,u));
+    REQUIRE(u-l <= tol);
+    // Vertex-based distance is a lower bound
+    REQUIRE(d <= u);
+    REQUIRE(l >= d);
+    const double s = std::max(
+      sampled_distance(V,F,U,G),sampled_distance(U,G,V,F));
+    REQUIRE(s <= u);
+  }
+}
+
+TEST_CASE("hausdorff: uncertified when refinement is capped", "[igl]")
+{
+  // Parallel unit squares: every point is at distance exactly 1, so no
+  // subdivision can separate the bounds by less than a tiny tol
+  const Eigen::MatrixXd VA = (Eigen::MatrixXd(4,3)<<
+    0,0,0,
+    1,0,0,
+    1,1,0,
+    0,1,0).finished();
+  Eigen::MatrixXd VB = VA;
+  VB.col(2).setConstant(1);
+  const Eigen::MatrixXi F = (Eigen::MatrixXi(2,3)<<0,1,2,0,2,3).finished();
+  double l,u;
+  REQUIRE_FALSE(igl::hausdorff(VA,F,VB,F,1e-12,l,u));
+  REQUIRE(l <= 1);
+  REQUIRE(u >= 1);
+  REQUIRE(u-l > 1e-12);
+  REQUIRE(igl::hausdorff(VA,F,VB,F,1e-2,l,u));
+  REQUIRE(u-l <= 1e-2);
+}
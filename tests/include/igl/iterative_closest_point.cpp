@@ -7,6 +7,8 @@
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include <test_common.h>
 #include <igl/iterative_closest_point.h>
+#include <igl/per_face_normals.h>
+#include <igl/random_points_on_mesh.h>
 
 
 TEST_CASE("iterative_closest_point: identity","[igl]" "[slow]")
@@ -30,3 +32,45 @@ TEST_CASE("iterative_closest_point: identity","[igl]" "[slow]")
 
   test_common::run_test_cases(test_common::all_meshes(), test_case);
 }
+
+TEST_CASE("iterative_closest_point: points with outliers","[igl]")
+{
+  Eigen::MatrixXd VY;
+  Eigen::MatrixXi FY;
+  test_common::bumpy_grid(40,40,0.2,6,5,VY,FY);
+  igl::AABB<Eigen::MatrixXd,3> Ytree;
+  Ytree.init(VY,FY);
+  Eigen::MatrixXd NY;
+  igl::per_face_normals(VY,FY,NY);
+  // Points on Y moved by a small rigid motion, plus far away outliers
+  Eigen::MatrixXd B,X;
+  Eigen::VectorXi FI;
+  igl::random_points_on_mesh(5000,VY,FY,B,FI,X,std::uint64_t(0));
+  const Eigen::Matrix3d R_gt =
+    Eigen::AngleAxisd(0.05,Eigen::Vector3d(1,2,3).normalized()).matrix();
+  const Eigen::RowVector3d t_gt(0.02,-0.01,0.03);
+  X = ((X*R_gt).rowwise()+t_gt).eval();
+  X.topRows(250).col(2).array() += 1.0;
+  for(const double trim : {1.0,0.9})
+  {
+    Eigen::Matrix3d R;
+    Eigen::RowVector3d t;
+    std::vector<igl::ICPIteration> stats;
+    igl::iterative_closest_point(X,VY,FY,Ytree,NY,trim,0.0,30,R,t,stats);
+    REQUIRE(stats.size() == 30);
+    // Exact inverse of the motion
+    const Eigen::Matrix3d R_inv = R_gt.transpose();
+    const Eigen::RowVector3d t_inv = -t_gt*R_gt.transpose();
+    if(trim < 1)
+    {
+      test_common::assert_near(R,R_inv,1e-6);
+      test_common::assert_near(t,t_inv,1e-6);
+      REQUIRE(stats.back().num_inliers == 4500);
+      REQUIRE(stats.back().rms < 1e-6);
+    }else
+    {
+      // Outliers bias the untrimmed fit
+      REQUIRE((R-R_inv).norm() > 1e-4);
+    }
+  }
+}
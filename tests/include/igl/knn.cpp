@@ -76,3 +76,55 @@ TEST_CASE("knn", "[igl]")
 
 
 }
+
+TEST_CASE("knn: csr, all-pairs and approximate", "[igl]")
+{
+    Eigen::MatrixXd P = Eigen::MatrixXd::Random(2000,3);
+    // Clustered points exercise deep octrees
+    P.topRows(500) *= 0.01;
+    const Eigen::MatrixXd Q = Eigen::MatrixXd::Random(300,3);
+    std::vector<std::vector<int> > point_indices;
+    Eigen::Matrix<int,Eigen::Dynamic,8> CH;
+    Eigen::Matrix<double,Eigen::Dynamic,3> CN;
+    Eigen::Matrix<double,Eigen::Dynamic,1> W;
+    igl::octree(P,point_indices,CH,CN,W);
+    const int k = 8;
+    // Brute force sorted distances of k nearest neighbors
+    const auto brute = [&](const Eigen::RowVector3d & q)
+    {
+        Eigen::VectorXd D = (P.rowwise()-q).rowwise().norm();
+        std::sort(D.data(),D.data()+D.size());
+        return Eigen::VectorXd(D.head(k));
+    };
+    const auto check = [&](
+      const Eigen::MatrixXd & X,
+      const Eigen::VectorXi & I,
+      const Eigen::VectorXi & NI,
+      const double eps)
+    {
+        REQUIRE(NI.size() == X.rows()+1);
+        REQUIRE(I.size() == X.rows()*k);
+        for(int i = 0;i<X.rows();i++)
+        {
+            REQUIRE(NI(i+1)-NI(i) == k);
+            const Eigen::VectorXd B = brute(X.row(i));
+            for(int j = 0;j<k;j++)
+            {
+                const double d = (P.row(I(NI(i)+j))-X.row(i)).norm();
+                REQUIRE(d <= (1.0+eps)*B(j)+1e-12);
+                REQUIRE(d >= B(j)-1e-12);
+            }
+        }
+    };
+    Eigen::VectorXi I,NI;
+    igl::knn(Q,P,k,0.0,point_indices,CH,CN,W,I,NI);
+    check(Q,I,NI,0);
+    igl::knn(P,k,0.0,point_indices,CH,CN,W,I,NI);
+    check(P,I,NI,0);
+    // Each point is its own nearest neighbor
+    for(int i = 0;i<P.rows();i++) { REQUIRE(I(NI(i)) == i); }
+    igl::knn(Q,P,k,0.5,point_indices,CH,CN,W,I,NI);
+    check(Q,I,NI,0.5);
+    igl::knn(P,k,0.5,point_indices,CH,CN,W,I,NI);
+    check(P,I,NI,0.5);
+}
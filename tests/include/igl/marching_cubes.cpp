@@ -0,0 +1,81 @@
+#include <test_common.h>
+#include <igl/marching_cubes.h>
+#include <igl/sparse_voxel_grid.h>
+#include <igl/grid.h>
+#include <igl/boundary_facets.h>
+#include <igl/is_edge_manifold.h>
+#include <igl/remove_duplicate_vertices.h>
+
+namespace
+{
+  // Closed, edge-manifold and each crossed grid edge has exactly one vertex
+  void require_closed_surface(
+    const Eigen::MatrixXd & V,
+    const Eigen::MatrixXi & F)
+  {
+    REQUIRE(F.rows() > 0);
+    Eigen::MatrixXi B;
+    igl::boundary_facets(F,B);
+    REQUIRE(B.rows() == 0);
+    REQUIRE(igl::is_edge_manifold(F));
+    Eigen::MatrixXd SV;
+    Eigen::VectorXi SVI,SVJ;
+    igl::remove_duplicate_vertices(V,0,SV,SVI,SVJ);
+    REQUIRE(SV.rows() == V.rows());
+  }
+}
+
+TEST_CASE("marching_cubes: sphere", "[igl]")
+{
+  const int nx = 21, ny = 17, nz = 13;
+  Eigen::MatrixXd GV;
+  igl::grid(Eigen::RowVector3i(nx,ny,nz),GV);
+  const Eigen::VectorXd S =
+    (GV.rowwise()-Eigen::RowVector3d(0.5,0.5,0.5)).rowwise().norm().array()-0.41;
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::marching_cubes(S,GV,nx,ny,nz,0,V,F);
+  require_closed_surface(V,F);
+  // Same cubes listed explicitly
+  Eigen::MatrixXi GI((nx-1)*(ny-1)*(nz-1),8);
+  const int offset[8] =
+    {0,1,1+nx,nx,nx*ny,1+nx*ny,1+nx+nx*ny,nx+nx*ny};
+  int c = 0;
+  for(int z = 0;z+1<nz;z++)
+  {
+    for(int y = 0;y+1<ny;y++)
+    {
+      for(int x = 0;x+1<nx;x++)
+      {
+        for(int k = 0;k<8;k++)
+        {
+          GI(c,k) = x+nx*y+nx*ny*z+offset[k];
+        }
+        c++;
+      }
+    }
+  }
+  Eigen::MatrixXd V_GI;
+  Eigen::MatrixXi F_GI;
+  igl::marching_cubes(S,GV,GI,0,V_GI,F_GI);
+  test_common::assert_eq(V_GI,V);
+  test_common::assert_eq(F_GI,F);
+}
+
+TEST_CASE("marching_cubes: sparse voxel grid", "[igl]")
+{
+  const std::function<double(const Eigen::RowVector3d & x)> f =
+    [&](const Eigen::RowVector3d & x)->double
+  {
+    return x.norm() - 1.0;
+  };
+  Eigen::RowVector3d p0(0,1.0,0);
+  Eigen::MatrixXd GV;
+  Eigen::VectorXd S;
+  Eigen::MatrixXi GI;
+  igl::sparse_voxel_grid(p0,f,0.1,1024,S,GV,GI);
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::marching_cubes(S,GV,GI,0,V,F);
+  require_closed_surface(V,F);
+}
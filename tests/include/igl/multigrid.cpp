@@ -0,0 +1,146 @@
+#include <test_common.h>
+#include <igl/multigrid.h>
+#include <igl/min_quad_with_fixed.h>
+#include <igl/triangulated_grid.h>
+#include <igl/cotmatrix.h>
+#include <igl/boundary_loop.h>
+#include <igl/slice.h>
+
+TEST_CASE("multigrid: harmonic on grid", "[igl]")
+{
+  // Slightly bumpy grid so that qslim/decimate have something to do
+  const int n = 41;
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::bumpy_grid(n,n,0.05,6,4,V,F);
+
+  std::vector<Eigen::SparseMatrix<double> > P;
+  REQUIRE(igl::multigrid_hierarchy(
+    V,F,igl::MULTIGRID_COARSENING_TYPE_DECIMATE,100,P));
+  REQUIRE(P.size() >= 2);
+  REQUIRE(P[0].rows() == V.rows());
+  for(size_t l = 1;l<P.size();l++)
+  {
+    REQUIRE(P[l].rows() == P[l-1].cols());
+  }
+  // Prolongation reproduces constants
+  for(const auto & Pl : P)
+  {
+    const Eigen::VectorXd one = Pl*Eigen::VectorXd::Ones(Pl.cols());
+    test_common::assert_near(one,Eigen::VectorXd::Ones(Pl.rows()),1e-12);
+  }
+
+  Eigen::SparseMatrix<double> L;
+  igl::cotmatrix(V,F,L);
+  Eigen::VectorXi b;
+  igl::boundary_loop(F,b);
+  Eigen::MatrixXd Vb;
+  igl::slice(V,b,1,Vb);
+  const Eigen::VectorXd bc = Vb.rowwise().norm();
+  const Eigen::VectorXd B = Eigen::VectorXd::Zero(V.rows());
+  const Eigen::SparseMatrix<double> Aeq;
+  const Eigen::VectorXd Beq;
+
+  Eigen::VectorXd Zd,Zm;
+  {
+    igl::min_quad_with_fixed_data<double> data;
+    REQUIRE(igl::min_quad_with_fixed_precompute(
+      Eigen::SparseMatrix<double>(-L),b,Aeq,true,data));
+    REQUIRE(igl::min_quad_with_fixed_solve(data,B,bc,Beq,Zd));
+  }
+  {
+    igl::min_quad_with_fixed_data<double> data;
+    data.multigrid.tolerance = 1e-12;
+    REQUIRE(igl::min_quad_with_fixed_precompute(
+      Eigen::SparseMatrix<double>(-L),b,Aeq,true,P,data));
+    REQUIRE(data.solver_type == igl::min_quad_with_fixed_data<double>::MULTIGRID);
+    REQUIRE(igl::min_quad_with_fixed_solve(data,B,bc,Beq,Zm));
+  }
+  test_common::assert_near(Zd,Zm,1e-8);
+}
+
+TEST_CASE("multigrid: solve converges", "[igl]")
+{
+  const int n = 33;
+  Eigen::MatrixXd GV;
+  Eigen::MatrixXi F;
+  igl::triangulated_grid(n,n,GV,F);
+  Eigen::MatrixXd V = Eigen::MatrixXd::Zero(GV.rows(),3);
+  V.leftCols(2) = GV;
+  std::vector<Eigen::SparseMatrix<double> > P;
+  REQUIRE(igl::multigrid_hierarchy(
+    V,F,igl::MULTIGRID_COARSENING_TYPE_QSLIM,50,P));
+  Eigen::SparseMatrix<double> L;
+  igl::cotmatrix(V,F,L);
+  // Screened Poisson: SPD without boundary conditions
+  Eigen::SparseMatrix<double> I(V.rows(),V.rows());
+  I.setIdentity();
+  const Eigen::SparseMatrix<double> A = I*1e-2 - L;
+  igl::MultigridData<double> data;
+  REQUIRE(igl::multigrid_precompute(A,P,data));
+  REQUIRE(data.A.size() == P.size()+1);
+  const Eigen::MatrixXd B = Eigen::MatrixXd::Random(V.rows(),2);
+  Eigen::MatrixXd Z;
+  int iterations;
+  double residual;
+  REQUIRE(igl::multigrid_solve(data,B,Z,iterations,residual));
+  REQUIRE(residual <= data.tolerance);
+  REQUIRE(iterations < data.max_iter);
+  Eigen::SimplicialLDLT<Eigen::SparseMatrix<double> > ldlt(A);
+  const Eigen::MatrixXd Zd = ldlt.solve(B);
+  test_common::assert_near(Z,Zd,1e-6);
+}
+
+TEST_CASE("multigrid: failures propagate", "[igl]")
+{
+  const int n = 33;
+  Eigen::MatrixXd GV;
+  Eigen::MatrixXi F;
+  igl::triangulated_grid(n,n,GV,F);
+  Eigen::MatrixXd V = Eigen::MatrixXd::Zero(GV.rows(),3);
+  V.leftCols(2) = GV;
+  {
+    // Duplicate a face: non-edge-manifold mesh cannot be decimated, so not
+    // even the first coarse level is built
+    Eigen::MatrixXi FF(F.rows()+1,3);
+    FF << F, F.row(0);
+    std::vector<Eigen::SparseMatrix<double> > P;
+    REQUIRE_FALSE(igl::multigrid_hierarchy(
+      V,FF,igl::MULTIGRID_COARSENING_TYPE_DECIMATE,50,P));
+    REQUIRE(P.empty());
+  }
+  {
+    std::vector<Eigen::SparseMatrix<double> > P;
+    REQUIRE(igl::multigrid_hierarchy(
+      V,F,igl::MULTIGRID_COARSENING_TYPE_QSLIM,50,P));
+    {
+      // Coarsening all the way down stops at the level that can no longer
+      // be decimated and keeps everything above it
+      std::vector<Eigen::SparseMatrix<double> > P1;
+      REQUIRE(igl::multigrid_hierarchy(
+        V,F,igl::MULTIGRID_COARSENING_TYPE_QSLIM,1,P1));
+      REQUIRE(P1.size() > P.size());
+      for(size_t l = 0;l<P.size();l++)
+      {
+        REQUIRE(P1[l].rows() == P[l].rows());
+        REQUIRE(P1[l].cols() == P[l].cols());
+      }
+    }
+    Eigen::SparseMatrix<double> L;
+    igl::cotmatrix(V,F,L);
+    Eigen::VectorXi b;
+    igl::boundary_loop(F,b);
+    const Eigen::SparseMatrix<double> Aeq;
+    igl::min_quad_with_fixed_data<double> data;
+    REQUIRE(igl::min_quad_with_fixed_precompute(
+      Eigen::SparseMatrix<double>(-L),b,Aeq,true,P,data));
+    // Not enough cycles to reach the tolerance: solve reports failure
+    data.multigrid.max_iter = 1;
+    data.multigrid.tolerance = 1e-14;
+    const Eigen::VectorXd B = Eigen::VectorXd::Random(V.rows());
+    const Eigen::VectorXd bc = Eigen::VectorXd::Ones(b.size());
+    Eigen::VectorXd Z;
+    REQUIRE_FALSE(igl::min_quad_with_fixed_solve(
+      data,B,bc,Eigen::VectorXd(),Z));
+  }
+}
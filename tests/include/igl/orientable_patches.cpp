@@ -0,0 +1,26 @@
+#include <test_common.h>
+#include <igl/orientable_patches.h>
+
+TEST_CASE("orientable_patches: without A", "[igl]")
+{
+  // Strip of triangles plus a fan of three triangles on one edge and a
+  // flipped pair
+  const Eigen::MatrixXi F = (Eigen::MatrixXi(8,3)<<
+    0,1,2,
+    2,1,3,
+    2,3,4,
+    4,3,5,
+    5,3,6,
+    5,3,7,
+    8,9,10,
+    8,10,9).finished();
+  Eigen::VectorXi C_gt,C;
+  Eigen::SparseMatrix<int> A;
+  igl::orientable_patches(F,C_gt,A);
+  igl::orientable_patches(F,C);
+  test_common::assert_eq(C,C_gt);
+  REQUIRE(C(0) == C(3));
+  REQUIRE(C(3) != C(4));
+  REQUIRE(C(4) != C(5));
+  REQUIRE(C(6) == C(7));
+}
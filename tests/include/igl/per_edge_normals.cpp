@@ -0,0 +1,44 @@
+#include <test_common.h>
+#include <igl/per_edge_normals.h>
+#include <igl/per_face_normals.h>
+#include <igl/doublearea.h>
+#include <igl/unique_edge_map.h>
+
+TEST_CASE("per_edge_normals: scatter", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::bumpy_grid(30,20,0.2,9,4,V,F);
+  Eigen::MatrixXd FN;
+  igl::per_face_normals(V,F,FN);
+  Eigen::VectorXd A;
+  igl::doublearea(V,F,A);
+  Eigen::MatrixXi allE,E,uE;
+  Eigen::VectorXi EMAP,uEC,uEE;
+  igl::unique_edge_map(F,allE,uE,EMAP,uEC,uEE);
+  const int m = F.rows();
+  for(const auto weighting :
+    {
+      igl::PER_EDGE_NORMALS_WEIGHTING_TYPE_UNIFORM,
+      igl::PER_EDGE_NORMALS_WEIGHTING_TYPE_AREA
+    })
+  {
+    Eigen::MatrixXd N;
+    igl::per_edge_normals(V,F,weighting,FN,N,E,EMAP);
+    test_common::assert_eq(E,uE);
+    // Serial scatter over directed edges
+    Eigen::MatrixXd N_gt = Eigen::MatrixXd::Zero(E.rows(),3);
+    for(int e = 0;e<EMAP.size();e++)
+    {
+      const double w =
+        weighting == igl::PER_EDGE_NORMALS_WEIGHTING_TYPE_UNIFORM ? 1 : A(e%m);
+      N_gt.row(EMAP(e)) += w*FN.row(e%m);
+    }
+    N_gt.rowwise().normalize();
+    test_common::assert_near(N,N_gt,1e-14);
+    // Reusing the edge map gives the same result
+    Eigen::MatrixXd N_uE;
+    igl::per_edge_normals(V,F,uEC,uEE,weighting,FN,N_uE);
+    test_common::assert_eq(N_uE,N);
+  }
+}
@@ -0,0 +1,112 @@
+#include <test_common.h>
+#include <igl/per_vertex_normals.h>
+#include <igl/per_face_normals.h>
+#include <igl/per_corner_normals.h>
+#include <igl/doublearea.h>
+#include <igl/internal_angles.h>
+#include <igl/vertex_triangle_adjacency.h>
+#include <cmath>
+
+TEST_CASE("per_vertex_normals: scatter", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::bumpy_grid(40,30,0.3,7,5,V,F);
+  // Append a combinatorially degenerate face and an unreferenced vertex
+  F.conservativeResize(F.rows()+1,3);
+  F.row(F.rows()-1) << 0,0,1;
+  V.conservativeResize(V.rows()+1,3);
+  V.row(V.rows()-1) << 10,10,10;
+  Eigen::MatrixXd FN;
+  igl::per_face_normals(V,F,FN);
+  Eigen::VectorXd A;
+  igl::doublearea(V,F,A);
+  Eigen::MatrixXd K;
+  igl::internal_angles(V,F,K);
+  Eigen::VectorXi VF,NI;
+  igl::vertex_triangle_adjacency(F,V.rows(),VF,NI);
+  for(const auto weighting :
+    {
+      igl::PER_VERTEX_NORMALS_WEIGHTING_TYPE_UNIFORM,
+      igl::PER_VERTEX_NORMALS_WEIGHTING_TYPE_AREA,
+      igl::PER_VERTEX_NORMALS_WEIGHTING_TYPE_ANGLE
+    })
+  {
+    // Serial scatter over corners
+    Eigen::MatrixXd N_gt = Eigen::MatrixXd::Zero(V.rows(),3);
+    for(int f = 0;f<F.rows();f++)
+    {
+      for(int c = 0;c<3;c++)
+      {
+        const double w =
+          weighting == igl::PER_VERTEX_NORMALS_WEIGHTING_TYPE_UNIFORM ? 1 :
+          weighting == igl::PER_VERTEX_NORMALS_WEIGHTING_TYPE_AREA ? A(f) :
+          K(f,c);
+        N_gt.row(F(f,c)) += w*FN.row(f);
+      }
+    }
+    for(int i = 0;i<N_gt.rows();i++)
+    {
+      N_gt.row(i).normalize();
+    }
+    Eigen::MatrixXd N;
+    igl::per_vertex_normals(V,F,weighting,FN,N);
+    REQUIRE(N.rows() == V.rows());
+    // Unreferenced vertex gets a zero normal
+    REQUIRE(N.row(V.rows()-1).norm() == 0);
+    for(int i = 0;i<N.rows();i++)
+    {
+      for(int j = 0;j<3;j++)
+      {
+        // Angles of the degenerate face are nan
+        if(std::isnan(N_gt(i,j)))
+        {
+          REQUIRE(std::isnan(N(i,j)));
+        }else
+        {
+          REQUIRE(std::abs(N(i,j)-N_gt(i,j)) < 1e-14);
+        }
+      }
+    }
+    // Reusing the adjacency gives the same result (nan != nan)
+    Eigen::MatrixXd N_VF;
+    igl::per_vertex_normals(V,F,weighting,FN,VF,NI,N_VF);
+    REQUIRE(N_VF.cwiseEqual(N).count() == N.cwiseEqual(N).count());
+  }
+}
+
+TEST_CASE("per_corner_normals: weighting", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::bumpy_grid(40,30,0.3,7,5,V,F);
+  Eigen::VectorXi VF,NI;
+  igl::vertex_triangle_adjacency(F,V.rows(),VF,NI);
+  // Large threshold: corner normals are vertex normals
+  for(const auto weighting :
+    {
+      igl::PER_VERTEX_NORMALS_WEIGHTING_TYPE_UNIFORM,
+      igl::PER_VERTEX_NORMALS_WEIGHTING_TYPE_AREA,
+      igl::PER_VERTEX_NORMALS_WEIGHTING_TYPE_ANGLE
+    })
+  {
+    Eigen::MatrixXd N;
+    igl::per_vertex_normals(V,F,weighting,N);
+    Eigen::MatrixXd CN;
+    igl::per_corner_normals(V,F,180.,weighting,VF,NI,CN);
+    REQUIRE(CN.rows() == 3*F.rows());
+    for(int f = 0;f<F.rows();f++)
+    {
+      for(int c = 0;c<3;c++)
+      {
+        test_common::assert_near(CN.row(3*f+c),N.row(F(f,c)),1e-14);
+      }
+    }
+  }
+  // Default is area weighting
+  Eigen::MatrixXd CN,CN_area;
+  igl::per_corner_normals(V,F,20.,VF,NI,CN);
+  igl::per_corner_normals(
+    V,F,20.,igl::PER_VERTEX_NORMALS_WEIGHTING_TYPE_AREA,VF,NI,CN_area);
+  test_common::assert_eq(CN,CN_area);
+}
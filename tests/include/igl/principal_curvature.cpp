@@ -1,6 +1,7 @@
 #include <test_common.h>
 #include <igl/principal_curvature.h>
 #include <igl/cylinder.h>
+#include <igl/triangulated_grid.h>
 
 TEST_CASE("principal_curvature: cylinder", "[igl]")
 {
@@ -26,4 +27,56 @@ TEST_CASE("principal_curvature: cylinder", "[igl]")
     //max curvature is greater than or equal to min curvature
     REQUIRE (PV1[i]>=PV2[i]);
   }
-}
\ No newline at end of file
+}
+TEST_CASE("principal_curvature: quadric", "[igl]")
+{
+  // z = (a*x² + b*y²)/2 has principal curvatures a and b at the origin
+  // (negated for an upward normal)
+  const double a = 0.8, b = -0.3;
+  Eigen::MatrixXd UV;
+  Eigen::MatrixXi F;
+  igl::triangulated_grid(41,41,UV,F);
+  Eigen::MatrixXd V(UV.rows(),3);
+  for(int i = 0;i<UV.rows();i++)
+  {
+    const double x = UV(i,0)-0.5, y = UV(i,1)-0.5;
+    V.row(i) << x, y, 0.5*(a*x*x + b*y*y);
+  }
+  // Two unreferenced vertices and a lone triangle: too few neighbors
+  V.conservativeResize(V.rows()+5,3);
+  V.bottomRows(5) << 2,0,0, 3,0,0, 2,1,0, 5,5,5, 6,6,6;
+  F.conservativeResize(F.rows()+1,3);
+  F.row(F.rows()-1) << V.rows()-5, V.rows()-4, V.rows()-3;
+  Eigen::MatrixXd PD1,PD2;
+  Eigen::VectorXd PV1,PV2;
+  std::vector<int> bad;
+  for(const bool useKring : {true,false})
+  {
+    bad.clear();
+    igl::principal_curvature(V,F,PD1,PD2,PV1,PV2,bad,3,useKring);
+    const int c = 20*41+20;
+    REQUIRE(V.row(c).head<2>().norm() == 0);
+    REQUIRE(PV1(c) == Approx(-b).epsilon(1e-2));
+    REQUIRE(PV2(c) == Approx(-a).epsilon(1e-2));
+    REQUIRE(std::abs(PD1(c,1)) == Approx(1).epsilon(1e-3));
+    REQUIRE(std::abs(PD2(c,0)) == Approx(1).epsilon(1e-3));
+    REQUIRE(bad.size() == 5);
+    for(int k = 0;k<5;k++)
+    {
+      const int i = V.rows()-5+k;
+      REQUIRE(bad[k] == i);
+      REQUIRE(PV1(i) == 0);
+      REQUIRE(PV2(i) == 0);
+      REQUIRE(PD1.row(i).norm() == 0);
+      REQUIRE(PD2.row(i).norm() == 0);
+    }
+  }
+  // Same result without the list of bad vertices
+  Eigen::MatrixXd QD1,QD2;
+  Eigen::VectorXd QV1,QV2;
+  igl::principal_curvature(V,F,QD1,QD2,QV1,QV2,3,false);
+  test_common::assert_eq(QD1,PD1);
+  test_common::assert_eq(QD2,PD2);
+  test_common::assert_eq(QV1,PV1);
+  test_common::assert_eq(QV2,PV2);
+}
@@ -0,0 +1,32 @@
+#include <test_common.h>
+#include <igl/radius_search.h>
+#include <igl/octree.h>
+
+TEST_CASE("radius_search: brute force", "[igl]")
+{
+  Eigen::MatrixXd V = Eigen::MatrixXd::Random(3000,3);
+  V.topRows(1000) *= 0.05;
+  const Eigen::MatrixXd P = Eigen::MatrixXd::Random(200,3);
+  std::vector<std::vector<int> > point_indices;
+  Eigen::Matrix<int,Eigen::Dynamic,8> CH;
+  Eigen::Matrix<double,Eigen::Dynamic,3> CN;
+  Eigen::Matrix<double,Eigen::Dynamic,1> W;
+  igl::octree(V,point_indices,CH,CN,W);
+  for(const double r : {0.0,0.1,0.5,4.0})
+  {
+    Eigen::VectorXi I,NI;
+    igl::radius_search(P,V,r,point_indices,CH,CN,W,I,NI);
+    REQUIRE(NI.size() == P.rows()+1);
+    REQUIRE(I.size() == NI(P.rows()));
+    for(int i = 0;i<P.rows();i++)
+    {
+      std::vector<int> B;
+      for(int j = 0;j<V.rows();j++)
+      {
+        if((V.row(j)-P.row(i)).norm() <= r) { B.push_back(j); }
+      }
+      REQUIRE(NI(i+1)-NI(i) == int(B.size()));
+      for(int j = 0;j<int(B.size());j++) { REQUIRE(I(NI(i)+j) == B[j]); }
+    }
+  }
+}
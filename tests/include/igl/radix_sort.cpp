@@ -0,0 +1,32 @@
+#include <test_common.h>
+#include <igl/radix_sort.h>
+#include <igl/Philox.h>
+#include <algorithm>
+
+TEST_CASE("radix_sort: stable", "[igl]")
+{
+  // Large enough to be split into blocks
+  for(const int n : {0,1,1000,300000})
+  {
+    igl::Philox rng(n);
+    std::vector<std::uint64_t> keys(n);
+    std::vector<int> I(n);
+    std::vector<std::pair<std::uint64_t,int> > expected(n);
+    for(int i = 0;i<n;i++)
+    {
+      // Few distinct keys with bits spread across non-contiguous bytes
+      keys[i] = (std::uint64_t(rng()%50)<<40) | ((rng()%7)<<8);
+      I[i] = i;
+      expected[i] = {keys[i],i};
+    }
+    std::stable_sort(expected.begin(),expected.end(),
+      [](const std::pair<std::uint64_t,int> & a,
+         const std::pair<std::uint64_t,int> & b){ return a.first < b.first; });
+    igl::radix_sort(keys,I);
+    for(int i = 0;i<n;i++)
+    {
+      REQUIRE(keys[i] == expected[i].first);
+      REQUIRE(I[i] == expected[i].second);
+    }
+  }
+}
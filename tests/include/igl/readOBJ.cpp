@@ -1,4 +1,7 @@
 #include <igl/readOBJ.h>
+#include <igl/writeOBJ.h>
+#include <igl/triangulated_grid.h>
+#include <cstdint>
 #include <test_common.h>
 #include <iostream>
 #include <string>
@@ -39,3 +42,30 @@ TEST_CASE("readOBJ: Obj with material", "[igl]")
     }
     REQUIRE (FM.size() == 2);
 }
+
+TEST_CASE("readOBJ: float and int64", "[igl]")
+{
+  Eigen::MatrixXd UV;
+  Eigen::MatrixXi F;
+  igl::triangulated_grid(7,5,UV,F);
+  Eigen::MatrixXd V(UV.rows(),3);
+  V << UV, UV.col(0).array()*UV.col(1).array();
+  REQUIRE(igl::writeOBJ("readOBJ_float_int64.obj",V,F));
+  Eigen::MatrixXf Vf;
+  Eigen::MatrixXi Ff;
+  REQUIRE(igl::readOBJ("readOBJ_float_int64.obj",Vf,Ff));
+  test_common::assert_near(Vf.cast<double>().eval(),V,1e-6);
+  test_common::assert_eq(Ff,F);
+  typedef Eigen::Matrix<std::int64_t,Eigen::Dynamic,Eigen::Dynamic> MatrixXl;
+  Eigen::MatrixXd Vl;
+  MatrixXl Fl;
+  REQUIRE(igl::readOBJ("readOBJ_float_int64.obj",Vl,Fl));
+  test_common::assert_near(Vl,V,1e-6);
+  test_common::assert_eq(Fl,MatrixXl(F.cast<std::int64_t>()));
+  // Writing 64-bit indices
+  REQUIRE(igl::writeOBJ("readOBJ_float_int64_l.obj",Vl,Fl));
+  Eigen::MatrixXd V2;
+  Eigen::MatrixXi F2;
+  REQUIRE(igl::readOBJ("readOBJ_float_int64_l.obj",V2,F2));
+  test_common::assert_eq(F2,F);
+}
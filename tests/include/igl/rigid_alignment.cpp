@@ -32,3 +32,13 @@ TEST_CASE("rigid_alignment: identity", "[igl]")
   test_common::assert_near(R,Eigen::Matrix3d::Identity(),1e-12);
   test_common::assert_near(t,Eigen::RowVector3d::Zero(),1e-12);
 }
+
+TEST_CASE("rigid_alignment: empty", "[igl]")
+{
+  const Eigen::MatrixXd X(0,3),Y(0,3),N(0,3);
+  Eigen::Matrix3d R;
+  Eigen::RowVector3d t;
+  igl::rigid_alignment(X,Y,N,R,t);
+  test_common::assert_eq(R,Eigen::Matrix3d::Identity());
+  test_common::assert_eq(t,Eigen::RowVector3d::Zero());
+}
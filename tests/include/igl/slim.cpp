@@ -0,0 +1,77 @@
+#include <test_common.h>
+#include <igl/slim.h>
+#include <igl/doublearea.h>
+#include <igl/Philox.h>
+
+namespace
+{
+  // Bumpy grid and its flat (orientation preserving) parametrization
+  void bumpy_grid(Eigen::MatrixXd & V, Eigen::MatrixXi & F, Eigen::MatrixXd & UV)
+  {
+    test_common::bumpy_grid(12,12,0.2,5,3,V,F);
+    UV = V.leftCols(2);
+    Eigen::VectorXd A;
+    igl::doublearea(UV,F,A);
+    if(A.minCoeff() < 0)
+    {
+      F.col(0).swap(F.col(1));
+    }
+  }
+}
+
+TEST_CASE("slim: cached matches uncached", "[igl]")
+{
+  Eigen::MatrixXd V,UV;
+  Eigen::MatrixXi F;
+  bumpy_grid(V,F,UV);
+  const Eigen::VectorXi b = (Eigen::VectorXi(1)<<0).finished();
+  const Eigen::MatrixXd bc = UV.row(0);
+  const auto run = [&](const bool first, const bool rest)->Eigen::MatrixXd
+  {
+    igl::SLIMData data;
+    igl::slim_precompute(
+      V,F,UV,data,igl::MappingEnergyType::SYMMETRIC_DIRICHLET,b,bc,1e5);
+    data.cached = first;
+    igl::slim_solve(data,2);
+    // Toggling the cache must rebuild its patterns
+    data.cached = rest;
+    igl::slim_solve(data,3);
+    return data.V_o;
+  };
+  const Eigen::MatrixXd U_uncached = run(false,false);
+  test_common::assert_near(run(true,true),U_uncached,1e-8);
+  test_common::assert_near(run(false,true),U_uncached,1e-8);
+  test_common::assert_near(run(true,false),U_uncached,1e-8);
+}
+
+TEST_CASE("slim: svd3x3 matches polar_svd", "[igl]")
+{
+  // Well conditioned jacobians with positive determinant; the count is not
+  // a multiple of the SSE/AVX batch width
+  const int m = 13;
+  igl::Philox rng(0);
+  const auto rand = [&rng]()
+  {
+    return double(rng())/double(std::numeric_limits<std::uint32_t>::max())-0.5;
+  };
+  Eigen::MatrixXd Ji(m,9);
+  for(int i = 0;i<m;i++)
+  {
+    for(int j = 0;j<9;j++)
+    {
+      Ji(i,j) = (j%4==0 ? 1.0 : 0.0) + 0.5*rand();
+    }
+  }
+  for(const auto energy :
+    {igl::MappingEnergyType::ARAP,igl::MappingEnergyType::SYMMETRIC_DIRICHLET})
+  {
+    // Outputs are expected to be sized by the caller
+    Eigen::MatrixXd W(m,9),R(m,9),Wf(m,9),Rf(m,9);
+    igl::slim_update_weights_and_closest_rotations_with_jacobians(
+      Ji,energy,1,false,W,R);
+    igl::slim_update_weights_and_closest_rotations_with_jacobians(
+      Ji,energy,1,true,Wf,Rf);
+    test_common::assert_near(Rf,R,1e-4);
+    test_common::assert_near(Wf,W,1e-3);
+  }
+}
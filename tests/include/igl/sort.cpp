@@ -1,6 +1,11 @@
 #include <test_common.h>
 #include <igl/sort.h>
+#include <igl/sortrows.h>
+#include <igl/unique_rows.h>
+#include <igl/parallel_sort.h>
 #include <igl/STR.h>
+#include <algorithm>
+#include <numeric>
 #include <tuple>
 
 namespace sort
@@ -81,7 +86,141 @@ TEST_CASE("SortTest: random", "[igl]")
 		sort::NMDimAscending{4,100,2,true},
 		sort::NMDimAscending{4,100,1,false},
 		sort::NMDimAscending{4,100,2,false},
+		// long enough to be radix sorted
+		sort::NMDimAscending{20000,1,1,true},
+		sort::NMDimAscending{20000,1,1,false},
+		sort::NMDimAscending{5,3000,2,true},
 	};
 
 	test_common::run_test_cases(params, test_case);
 }
+
+namespace sort
+{
+	// Reference: stable comparison sort of rows
+	template <typename DerivedX>
+	Eigen::VectorXi stable_sortrows(const DerivedX & X, const bool ascending)
+	{
+		std::vector<int> I(X.rows());
+		std::iota(I.begin(),I.end(),0);
+		std::stable_sort(I.begin(),I.end(),[&](const int a, const int b)
+		{
+			for(int c = 0;c<X.cols();c++)
+			{
+				if(X(a,c) != X(b,c))
+				{
+					return ascending ? X(a,c) < X(b,c) : X(a,c) > X(b,c);
+				}
+			}
+			return false;
+		});
+		return Eigen::Map<Eigen::VectorXi>(I.data(),I.size());
+	}
+}
+
+TEST_CASE("sortrows: radix sort matches comparison sort", "[igl]")
+{
+	// Many duplicates, negative numbers and a constant column
+	Eigen::MatrixXi A = (Eigen::MatrixXi::Random(5000,4).array()/100000000).matrix();
+	A.col(2).setConstant(-7);
+	// Column of doubles spanning all 64 bits of their keys, -0 and 0
+	Eigen::MatrixXd B = Eigen::MatrixXd::Random(5000,3);
+	B.col(1) = (B.col(1)*3).array().round().matrix();
+	B(0,1) = -0.0;
+	B(1,1) = 0.0;
+	B.col(0) = B.col(0).array().sign().matrix();
+	for(const bool ascending : {true,false})
+	{
+		Eigen::MatrixXi YA;
+		Eigen::VectorXi IA;
+		igl::sortrows(A,ascending,YA,IA);
+		test_common::assert_eq(IA,sort::stable_sortrows(A,ascending));
+		Eigen::MatrixXd YB;
+		Eigen::VectorXi IB;
+		igl::sortrows(B,ascending,YB,IB);
+		test_common::assert_eq(IB,sort::stable_sortrows(B,ascending));
+		for(int i = 0;i<B.rows();i++)
+		{
+			REQUIRE(YB.row(i) == B.row(IB(i)));
+		}
+	}
+	Eigen::MatrixXi C;
+	Eigen::VectorXi IA,IC;
+	igl::unique_rows(A,C,IA,IC);
+	for(int i = 0;i<A.rows();i++)
+	{
+		REQUIRE(A.row(i) == C.row(IC(i)));
+	}
+	for(int i = 1;i<C.rows();i++)
+	{
+		REQUIRE(C.row(i) != C.row(i-1));
+	}
+}
+
+TEST_CASE("parallel_sort: matches std::sort", "[igl]")
+{
+	for(const int n : {0,10,100000})
+	{
+		std::vector<double> X(n);
+		for(auto & x : X) { x = double(std::rand()%1000); }
+		std::vector<double> Y = X;
+		igl::parallel_sort(X.begin(),X.end());
+		std::sort(Y.begin(),Y.end());
+		REQUIRE(X == Y);
+		// Small blocks
+		std::reverse(X.begin(),X.end());
+		igl::parallel_sort(X.begin(),X.end(),std::less<double>(),1000);
+		REQUIRE(X == Y);
+	}
+}
+
+TEST_CASE("sort: benchmark", "[igl]" IGL_DEBUG_OFF)
+{
+	const int n = 1000000;
+	const Eigen::VectorXd x = Eigen::VectorXd::Random(n);
+	const Eigen::MatrixXi F = (Eigen::MatrixXi::Random(n,3).array().abs()/2000).matrix();
+	const Eigen::MatrixXd V = Eigen::MatrixXd::Random(n,3);
+	std::vector<double> vx(x.data(),x.data()+n);
+
+	BENCHMARK("std::sort indices") {
+		std::vector<size_t> I(n);
+		std::iota(I.begin(),I.end(),0);
+		std::sort(I.begin(),I.end(),[&](size_t a, size_t b){ return vx[a] < vx[b]; });
+		return I[0];
+	};
+	BENCHMARK("igl::sort std::vector<double>") {
+		std::vector<double> y;
+		std::vector<size_t> I;
+		igl::sort(vx,true,y,I);
+		return I[0];
+	};
+	BENCHMARK("igl::parallel_sort std::vector<double>") {
+		std::vector<double> y = vx;
+		igl::parallel_sort(y.begin(),y.end());
+		return y[0];
+	};
+	BENCHMARK("igl::sort VectorXd") {
+		Eigen::VectorXd y;
+		Eigen::VectorXi I;
+		igl::sort(x,1,true,y,I);
+		return I(0);
+	};
+	BENCHMARK("igl::sortrows #F by 3 int") {
+		Eigen::MatrixXi Y;
+		Eigen::VectorXi I;
+		igl::sortrows(F,true,Y,I);
+		return I(0);
+	};
+	BENCHMARK("igl::sortrows #V by 3 double") {
+		Eigen::MatrixXd Y;
+		Eigen::VectorXi I;
+		igl::sortrows(V,true,Y,I);
+		return I(0);
+	};
+	BENCHMARK("igl::unique_rows #F by 3 int") {
+		Eigen::MatrixXi C;
+		Eigen::VectorXi IA,IC;
+		igl::unique_rows(F,C,IA,IC);
+		return C.rows();
+	};
+}
@@ -1,7 +1,10 @@
 
 #include <test_common.h>
 #include <igl/triangle_triangle_adjacency.h>
+#include <igl/Philox.h>
+#include <igl/triangulated_grid.h>
 #include <Eigen/Geometry>
+#include <cstdint>
 
 TEST_CASE("triangle_triangle_adjacency: dot", "[igl]" "[slow]")
 {
@@ -37,3 +40,86 @@ TEST_CASE("triangle_triangle_adjacency: dot", "[igl]" "[slow]")
 
   test_common::run_test_cases(test_common::manifold_meshes(), test_case);
 }
+
+TEST_CASE("triangle_triangle_adjacency: preprocess", "[igl]")
+{
+  // Random triangles on few vertices: many non-manifold edges
+  const int n = 30;
+  Eigen::MatrixXi F(2000,3);
+  igl::Philox rng(0);
+  for(int f = 0;f<F.rows();f++)
+  {
+    F.row(f) << rng()%n, rng()%n, rng()%n;
+  }
+  std::vector<std::vector<int> > TTT,sorted;
+  igl::triangle_triangle_adjacency_preprocess(F,TTT);
+  for(int f = 0;f<F.rows();f++)
+  {
+    for(int i = 0;i<3;i++)
+    {
+      const int v1 = F(f,i), v2 = F(f,(i+1)%3);
+      sorted.push_back({std::min(v1,v2),std::max(v1,v2),f,i});
+    }
+  }
+  std::sort(sorted.begin(),sorted.end());
+  REQUIRE(TTT == sorted);
+
+  // Manifold: same adjacency as the Eigen overload
+  Eigen::MatrixXd V;
+  igl::triangulated_grid(20,30,V,F);
+  Eigen::MatrixXi TT,TTi,pTT,pTTi;
+  igl::triangle_triangle_adjacency(F,TT,TTi);
+  TTT.clear();
+  igl::triangle_triangle_adjacency_preprocess(F,TTT);
+  pTT.resize(F.rows(),3);
+  pTTi.resize(F.rows(),3);
+  igl::triangle_triangle_adjacency_extractTT(F,TTT,pTT);
+  igl::triangle_triangle_adjacency_extractTTi(F,TTT,pTTi);
+  test_common::assert_eq(TT,pTT);
+  test_common::assert_eq(TTi,pTTi);
+}
+
+TEST_CASE("triangle_triangle_adjacency: int64", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::triangulated_grid(20,30,V,F);
+  Eigen::MatrixXi TT,TTi;
+  igl::triangle_triangle_adjacency(F,TT,TTi);
+  typedef Eigen::Matrix<std::int64_t,Eigen::Dynamic,Eigen::Dynamic> MatrixXl;
+  const MatrixXl Fl = F.cast<std::int64_t>();
+  MatrixXl TTl,TTil;
+  igl::triangle_triangle_adjacency(Fl,TTl,TTil);
+  test_common::assert_eq(TTl,MatrixXl(TT.cast<std::int64_t>()));
+  test_common::assert_eq(TTil,MatrixXl(TTi.cast<std::int64_t>()));
+}
+
+TEST_CASE("triangle_triangle_adjacency: preprocess beyond 32-bit indices", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::triangulated_grid(20,30,V,F);
+  typedef Eigen::Matrix<std::int64_t,Eigen::Dynamic,Eigen::Dynamic> MatrixXl;
+  // Vertex indices do not fit in 32 bits
+  const std::int64_t offset = std::int64_t(1)<<33;
+  const MatrixXl Fl = (F.cast<std::int64_t>().array() + offset).matrix();
+  std::vector<std::vector<int> > TTT;
+  std::vector<std::vector<std::int64_t> > TTTl;
+  igl::triangle_triangle_adjacency_preprocess(F,TTT);
+  igl::triangle_triangle_adjacency_preprocess(Fl,TTTl);
+  REQUIRE(TTT.size() == TTTl.size());
+  for(size_t i = 0;i<TTT.size();i++)
+  {
+    REQUIRE(TTTl[i][0] == TTT[i][0]+offset);
+    REQUIRE(TTTl[i][1] == TTT[i][1]+offset);
+    REQUIRE(TTTl[i][2] == TTT[i][2]);
+    REQUIRE(TTTl[i][3] == TTT[i][3]);
+  }
+  MatrixXl TT(F.rows(),3),TTi(F.rows(),3);
+  igl::triangle_triangle_adjacency_extractTT(Fl,TTTl,TT);
+  igl::triangle_triangle_adjacency_extractTTi(Fl,TTTl,TTi);
+  Eigen::MatrixXi TT_gt,TTi_gt;
+  igl::triangle_triangle_adjacency(F,TT_gt,TTi_gt);
+  test_common::assert_eq(TT,MatrixXl(TT_gt.cast<std::int64_t>()));
+  test_common::assert_eq(TTi,MatrixXl(TTi_gt.cast<std::int64_t>()));
+}
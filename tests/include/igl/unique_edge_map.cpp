@@ -0,0 +1,84 @@
+#include <test_common.h>
+#include <igl/unique_edge_map.h>
+#include <igl/unique_simplices.h>
+#include <igl/oriented_facets.h>
+#include <igl/sort.h>
+#include <igl/triangulated_grid.h>
+#include <cstdint>
+
+TEST_CASE("unique_edge_map: matches unique_simplices", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::triangulated_grid(30,20,V,F);
+  // Non-manifold: duplicate some faces with flipped orientation
+  F.conservativeResize(F.rows()+100,3);
+  F.bottomRows(100) = F.topRows(100).rowwise().reverse().eval();
+  Eigen::MatrixXi E,uE,oE,ouE;
+  Eigen::VectorXi EMAP,oEMAP,IA;
+  std::vector<std::vector<int> > uE2E;
+  igl::unique_edge_map(F,E,uE,EMAP,uE2E);
+  igl::oriented_facets(F,oE);
+  test_common::assert_eq(E,oE);
+  igl::unique_simplices(oE,ouE,IA,oEMAP);
+  test_common::assert_eq(EMAP,oEMAP);
+  // Same unique edges (orientation of each is that of one of its occurrences)
+  Eigen::MatrixXi suE,souE,I;
+  igl::sort(uE,2,true,suE,I);
+  igl::sort(ouE,2,true,souE,I);
+  test_common::assert_eq(suE,souE);
+  for(int u = 0;u<uE.rows();u++)
+  {
+    // First occurrence
+    REQUIRE(uE2E[u].size() > 0);
+    REQUIRE(uE.row(u) == E.row(uE2E[u][0]));
+    for(const int e : uE2E[u])
+    {
+      REQUIRE(EMAP(e) == u);
+    }
+  }
+}
+
+TEST_CASE("unique_edge_map: int64", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::triangulated_grid(30,20,V,F);
+  Eigen::MatrixXi E,uE;
+  Eigen::VectorXi EMAP,uEC,uEE;
+  igl::unique_edge_map(F,E,uE,EMAP,uEC,uEE);
+  typedef Eigen::Matrix<std::int64_t,Eigen::Dynamic,Eigen::Dynamic> MatrixXl;
+  typedef Eigen::Matrix<std::int64_t,Eigen::Dynamic,1> VectorXl;
+  const MatrixXl Fl = F.cast<std::int64_t>();
+  MatrixXl El,uEl;
+  VectorXl EMAPl,uECl,uEEl;
+  igl::unique_edge_map(Fl,El,uEl,EMAPl,uECl,uEEl);
+  test_common::assert_eq(El,MatrixXl(E.cast<std::int64_t>()));
+  test_common::assert_eq(uEl,MatrixXl(uE.cast<std::int64_t>()));
+  test_common::assert_eq(EMAPl,VectorXl(EMAP.cast<std::int64_t>()));
+  test_common::assert_eq(uECl,VectorXl(uEC.cast<std::int64_t>()));
+  test_common::assert_eq(uEEl,VectorXl(uEE.cast<std::int64_t>()));
+}
+
+TEST_CASE("unique_edge_map: beyond 32-bit indices", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::triangulated_grid(30,20,V,F);
+  Eigen::MatrixXi E,uE;
+  Eigen::VectorXi EMAP;
+  igl::unique_edge_map(F,E,uE,EMAP);
+  typedef Eigen::Matrix<std::int64_t,Eigen::Dynamic,Eigen::Dynamic> MatrixXl;
+  typedef Eigen::Matrix<std::int64_t,Eigen::Dynamic,1> VectorXl;
+  // Vertex indices do not fit in 32 bits
+  const std::int64_t offset = std::int64_t(1)<<33;
+  const MatrixXl Fl = (F.cast<std::int64_t>().array() + offset).matrix();
+  MatrixXl El,uEl;
+  VectorXl EMAPl;
+  igl::unique_edge_map(Fl,El,uEl,EMAPl);
+  test_common::assert_eq(
+    El,MatrixXl((E.cast<std::int64_t>().array()+offset).matrix()));
+  test_common::assert_eq(
+    uEl,MatrixXl((uE.cast<std::int64_t>().array()+offset).matrix()));
+  test_common::assert_eq(EMAPl,VectorXl(EMAP.cast<std::int64_t>()));
+}
@@ -0,0 +1,36 @@
+#include <test_common.h>
+#include <igl/vertex_components.h>
+#include <igl/Philox.h>
+#include <vector>
+
+TEST_CASE("vertex_components: soup matches breadth first search", "[igl]")
+{
+  // Random triangles on many vertices: isolated vertices, non-manifold edges
+  const int n = 15000;
+  Eigen::MatrixXi F(6000,3);
+  igl::Philox rng(1);
+  for(int f = 0;f<F.rows();f++)
+  {
+    for(int c = 0;c<3;c++)
+    {
+      F(f,c) = rng()%n;
+    }
+  }
+  F(0,0) = n-1;
+  std::vector<std::vector<int> > A(n);
+  for(int f = 0;f<F.rows();f++)
+  {
+    for(int c = 0;c<3;c++)
+    {
+      A[F(f,c)].push_back(F(f,(c+1)%3));
+      A[F(f,(c+1)%3)].push_back(F(f,c));
+    }
+  }
+  Eigen::VectorXi C_gt,K_gt;
+  test_common::bfs_components(A,C_gt,K_gt);
+  REQUIRE(K_gt.size() > 100);
+  Eigen::VectorXi C;
+  igl::vertex_components(F,C);
+  test_common::assert_same_partition(C,C_gt);
+  REQUIRE(C.maxCoeff()+1 == K_gt.size());
+}
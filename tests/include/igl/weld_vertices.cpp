@@ -0,0 +1,179 @@
+#include <test_common.h>
+#include <igl/weld_vertices.h>
+#include <igl/remove_duplicate_vertices.h>
+#include <igl/triangulated_grid.h>
+#include <igl/oriented_facets.h>
+#include <igl/Philox.h>
+
+TEST_CASE("weld_vertices: triangle soup", "[igl]")
+{
+  Eigen::MatrixXd GV;
+  Eigen::MatrixXi GF;
+  igl::triangulated_grid(30,20,GV,GF);
+  // Explode into a soup and jitter copies well below epsilon
+  const double eps = 1e-6;
+  igl::Philox rng(0);
+  Eigen::MatrixXd V(GF.size(),2);
+  Eigen::MatrixXi F(GF.rows(),3);
+  for(int f = 0;f<GF.rows();f++)
+  {
+    for(int c = 0;c<3;c++)
+    {
+      F(f,c) = 3*f+c;
+      const double jx = (rng.uniform()-0.5)*0.5*eps;
+      const double jy = (rng.uniform()-0.5)*0.5*eps;
+      V.row(F(f,c)) = GV.row(GF(f,c)) + Eigen::RowVector2d(jx,jy);
+    }
+  }
+  Eigen::MatrixXd SV;
+  Eigen::VectorXi SVI,SVJ;
+  Eigen::MatrixXi SF = F;
+  igl::weld_vertices(V,eps,SV,SVI,SVJ,SF);
+  REQUIRE(SV.rows() == GV.rows());
+  REQUIRE(SVJ.size() == V.rows());
+  for(int k = 0;k<SVI.size();k++)
+  {
+    test_common::assert_eq(SV.row(k),V.row(SVI(k)));
+    // Representatives are the first occurrences, in order
+    REQUIRE(SVJ(SVI(k)) == k);
+    if(k > 0)
+    {
+      REQUIRE(SVI(k-1) < SVI(k));
+    }
+  }
+  for(int f = 0;f<F.rows();f++)
+  {
+    for(int c = 0;c<3;c++)
+    {
+      REQUIRE(SF(f,c) == SVJ(F(f,c)));
+      REQUIRE((SV.row(SF(f,c))-V.row(F(f,c))).cwiseAbs().maxCoeff() <= eps);
+    }
+  }
+  // Copies of the same grid vertex map to the same vertex, i.e., same
+  // connectivity as the grid up to renaming vertices
+  Eigen::VectorXi G2S(GV.rows());
+  for(int f = 0;f<GF.rows();f++)
+  {
+    for(int c = 0;c<3;c++)
+    {
+      G2S(GF(f,c)) = SF(f,c);
+    }
+  }
+  for(int f = 0;f<GF.rows();f++)
+  {
+    for(int c = 0;c<3;c++)
+    {
+      REQUIRE(SF(f,c) == G2S(GF(f,c)));
+    }
+  }
+}
+
+TEST_CASE("weld_vertices: epsilon semantics", "[igl]")
+{
+  const double eps = 0.1;
+  Eigen::MatrixXd V(7,3);
+  V<<
+    // straddle a cell boundary: merged (rounding would split them)
+    0.149,0,0,
+    0.151,0,0,
+    // chain: 2~3 and 3~4 so all three merge
+    1.0,1,1,
+    1.09,1,1,
+    1.18,1,1,
+    // too far in one coordinate
+    1.0,1,1.2,
+    // -0 and 0
+    -0.0,5,5;
+  Eigen::MatrixXd SV;
+  Eigen::VectorXi SVI,SVJ;
+  igl::weld_vertices(V,eps,SV,SVI,SVJ);
+  Eigen::VectorXi SVJ_gt(7);
+  SVJ_gt<<0,0,1,1,1,2,3;
+  test_common::assert_eq(SVJ,SVJ_gt);
+  Eigen::VectorXi SVI_gt(4);
+  SVI_gt<<0,2,5,6;
+  test_common::assert_eq(SVI,SVI_gt);
+
+  // Exact matching agrees with remove_duplicate_vertices
+  Eigen::MatrixXd W(6,2);
+  W<<0,0, 1,0, 0,0, 1,1e-12, -0.0,0, 1,0;
+  igl::weld_vertices(W,0,SV,SVI,SVJ);
+  Eigen::MatrixXd RV;
+  Eigen::VectorXi RVI,RVJ;
+  igl::remove_duplicate_vertices(W,0,RV,RVI,RVJ);
+  REQUIRE(SV.rows() == RV.rows());
+  SVJ_gt.resize(6);
+  SVJ_gt<<0,1,0,2,0,1;
+  test_common::assert_eq(SVJ,SVJ_gt);
+
+  // Empty input
+  Eigen::MatrixXd E(0,3);
+  igl::weld_vertices(E,eps,SV,SVI,SVJ);
+  REQUIRE(SV.rows() == 0);
+  REQUIRE(SVJ.size() == 0);
+}
+
+TEST_CASE("weld_vertices: huge coordinates", "[igl]")
+{
+  // Cell coordinates far beyond the range of 64-bit integers
+  const double eps = 0.1;
+  Eigen::MatrixXd V(8,2);
+  V<<
+    1e300,0,
+    -1e300,0,
+    1e300,0,
+    0,0,
+    0.05,0,
+    1e22,0,
+    1e22,0.05,
+    1e22,1;
+  Eigen::MatrixXd SV;
+  Eigen::VectorXi SVI,SVJ;
+  igl::weld_vertices(V,eps,SV,SVI,SVJ);
+  Eigen::VectorXi SVJ_gt(8);
+  SVJ_gt<<0,1,0,2,2,3,3,4;
+  test_common::assert_eq(SVJ,SVJ_gt);
+}
+
+TEST_CASE("weld_vertices: random", "[igl]")
+{
+  // Compare against brute force connected components of close pairs
+  igl::Philox rng(1);
+  const int n = 2000;
+  const double eps = 0.01;
+  Eigen::MatrixXd V(n,3);
+  for(int i = 0;i<n;i++)
+  {
+    // Coarse lattice so that there are many close pairs
+    for(int d = 0;d<3;d++)
+    {
+      const double lattice = std::round(rng.uniform()*8)/8;
+      V(i,d) = lattice + 0.02*rng.uniform();
+    }
+  }
+  Eigen::MatrixXd SV;
+  Eigen::VectorXi SVI,SVJ;
+  igl::weld_vertices(V,eps,SV,SVI,SVJ);
+  std::vector<int> L(n);
+  for(int i = 0;i<n;i++) { L[i] = i; }
+  bool changed = true;
+  while(changed)
+  {
+    changed = false;
+    for(int i = 0;i<n;i++)
+    {
+      for(int j = 0;j<n;j++)
+      {
+        if((V.row(i)-V.row(j)).cwiseAbs().maxCoeff() <= eps && L[j] < L[i])
+        {
+          L[i] = L[j];
+          changed = true;
+        }
+      }
+    }
+  }
+  for(int i = 0;i<n;i++)
+  {
+    REQUIRE(SVI(SVJ(i)) == L[i]);
+  }
+}
@@ -6,6 +6,7 @@
 #include <igl/readDMAT.h>
 
 #include <igl/find.h>
+#include <igl/triangulated_grid.h>
 
 #include <Eigen/Core>
 #include <catch2/catch.hpp>
@@ -15,6 +16,9 @@
 #include <functional>
 #include <algorithm>
 #include <tuple>
+#include <map>
+#include <queue>
+#include <vector>
 
 
 // Disable lengthy tests in debug mode
@@ -119,6 +123,26 @@ namespace test_common
     return std::string(LIBIGL_DATA_DIR) + "/" + s;
   };
 
+  // Open, non-planar mesh for tests that need a surface with a boundary but
+  // no particular shape: an nx by ny triangulated grid of the unit square
+  // lifted to the height field z = amplitude * sin(fx*x) * cos(fy*y)
+  inline void bumpy_grid(
+    const int nx,
+    const int ny,
+    const double amplitude,
+    const double fx,
+    const double fy,
+    Eigen::MatrixXd & V,
+    Eigen::MatrixXi & F)
+  {
+    Eigen::MatrixXd UV;
+    igl::triangulated_grid(nx,ny,UV,F);
+    V.resize(UV.rows(),3);
+    V.leftCols(2) = UV;
+    V.col(2) = amplitude*
+      (fx*UV.col(0)).array().sin()*(fy*UV.col(1)).array().cos();
+  }
+
   template <typename DerivedA, typename DerivedB>
   void assert_eq(
     const Eigen::MatrixBase<DerivedA> & A,
@@ -218,4 +242,65 @@ namespace test_common
     }
   }
 
+  // Reference connected components by breadth first search over adjacency
+  // lists (independent of igl::UnionFind), started from each unvisited node
+  // in increasing order
+  //
+  // Inputs:
+  //   A  #n list of lists of neighbors
+  // Outputs:
+  //   C  #n list of component ids into [0,#K-1]
+  //   K  #K list of sizes of each component
+  inline void bfs_components(
+    const std::vector<std::vector<int> > & A,
+    Eigen::VectorXi & C,
+    Eigen::VectorXi & K)
+  {
+    const int n = A.size();
+    C.setConstant(n,1,-1);
+    std::vector<int> vK;
+    for(int s = 0;s<n;s++)
+    {
+      if(C(s) >= 0) continue;
+      const int c = vK.size();
+      vK.push_back(0);
+      std::queue<int> Q;
+      Q.push(s);
+      C(s) = c;
+      while(!Q.empty())
+      {
+        const int i = Q.front();
+        Q.pop();
+        vK[c]++;
+        for(const int j : A[i])
+        {
+          if(C(j) < 0)
+          {
+            C(j) = c;
+            Q.push(j);
+          }
+        }
+      }
+    }
+    K = Eigen::Map<Eigen::VectorXi>(vK.data(),vK.size());
+  }
+
+  // Labels A and B describe the same partition, up to relabeling
+  template <typename DerivedA, typename DerivedB>
+  void assert_same_partition(
+    const Eigen::MatrixBase<DerivedA> & A,
+    const Eigen::MatrixBase<DerivedB> & B)
+  {
+    REQUIRE(A.size() == B.size());
+    std::map<typename DerivedA::Scalar,typename DerivedB::Scalar> AB;
+    std::map<typename DerivedB::Scalar,typename DerivedA::Scalar> BA;
+    for(int i = 0;i<A.size();i++)
+    {
+      CAPTURE( i );
+      // First occurrence fixes the correspondence, later ones must agree
+      REQUIRE(AB.emplace(A(i),B(i)).first->second == B(i));
+      REQUIRE(BA.emplace(B(i),A(i)).first->second == A(i));
+    }
+  }
+
 }